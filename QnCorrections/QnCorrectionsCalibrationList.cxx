@@ -0,0 +1,153 @@
+/**************************************************************************************************
+ *                                                                                                *
+ * Package:       FlowVectorCorrections                                                           *
+ * Authors:       Jaap Onderwaater, GSI, jacobus.onderwaater@cern.ch                              *
+ *                Ilya Selyuzhenkov, GSI, ilya.selyuzhenkov@gmail.com                             *
+ *                Víctor González, UCM, victor.gonzalez@cern.ch                                   *
+ *                Contributors are mentioned in the code where appropriate.                       *
+ * Development:   2012-2016                                                                       *
+ *                                                                                                *
+ * This file is part of FlowVectorCorrections, a software package that corrects Q-vector          *
+ * measurements for effects of nonuniform detector acceptance. The corrections in this package    *
+ * are based on publication:                                                                      *
+ *                                                                                                *
+ *  [1] "Effects of non-uniform acceptance in anisotropic flow measurements"                      *
+ *  Ilya Selyuzhenkov and Sergei Voloshin                                                         *
+ *  Phys. Rev. C 77, 034904 (2008)                                                                *
+ *                                                                                                *
+ * The procedure proposed in [1] is extended with the following steps:                            *
+ * (*) alignment correction between subevents                                                     *
+ * (*) possibility to extract the twist and rescaling corrections                                 *
+ *      for the case of three detector subevents                                                  *
+ *      (currently limited to the case of two “hit-only” and one “tracking” detectors)            *
+ * (*) (optional) channel equalization                                                            *
+ * (*) flow vector width equalization                                                             *
+ *                                                                                                *
+ * FlowVectorCorrections is distributed under the terms of the GNU General Public License (GPL)   *
+ * (https://en.wikipedia.org/wiki/GNU_General_Public_License)                                     *
+ * either version 3 of the License, or (at your option) any later version.                        *
+ *                                                                                                *
+ **************************************************************************************************/
+/// \file QnCorrectionsCalibrationList.cxx
+/// \brief Implementation of the lazy calibration histograms list
+
+#include <TDirectory.h>
+#include <TKey.h>
+#include <TH1.h>
+#include "QnCorrectionsCalibrationList.h"
+#include "QnCorrectionsLog.h"
+
+/// \cond CLASSIMP
+ClassImp(QnCorrectionsCalibrationList);
+/// \endcond
+
+/// Default constructor
+QnCorrectionsCalibrationList::QnCorrectionsCalibrationList() : THashList() {
+  fDirectory = NULL;
+}
+
+/// Normal constructor
+///
+/// The list takes the name of the directory and the ownership
+/// of the objects it will read from it.
+/// \param directory the directory supporting the list content
+QnCorrectionsCalibrationList::QnCorrectionsCalibrationList(TDirectory *directory) : THashList() {
+  fDirectory = directory;
+  if (fDirectory != NULL) SetName(fDirectory->GetName());
+  SetOwner(kTRUE);
+}
+
+/// Default destructor
+/// The read objects are owned by the list so, they are destroyed with it
+QnCorrectionsCalibrationList::~QnCorrectionsCalibrationList() {
+
+}
+
+/// Finds an object by name
+///
+/// The objects already read are searched first. If not found
+/// and a supporting directory is available, its key is looked
+/// for and, if present, the object is read. If the key corresponds
+/// to a directory a new lazy list supported by it is returned.
+/// The object is incorporated to the list so, it is only read once.
+/// \param name the name of the object
+/// \return the object if found, NULL otherwise
+TObject *QnCorrectionsCalibrationList::FindObject(const char *name) const {
+  TObject *obj = THashList::FindObject(name);
+
+  if ((obj != NULL) || (fDirectory == NULL)) return obj;
+
+  TKey *key = fDirectory->GetKey(name);
+  if (key == NULL) return NULL;
+
+  if (TString(key->GetClassName()).EqualTo("TDirectoryFile")) {
+    obj = new QnCorrectionsCalibrationList(fDirectory->GetDirectory(name));
+  }
+  else {
+    obj = key->ReadObj();
+    /* histograms must not be owned by the file directory */
+    if ((obj != NULL) && obj->InheritsFrom("TH1")) ((TH1 *) obj)->SetDirectory(NULL);
+  }
+  if (obj != NULL) {
+    QnCorrectionsInfo(Form("Read calibration object %s from directory %s", name, fDirectory->GetName()));
+    /* keep it for further requests */
+    const_cast<QnCorrectionsCalibrationList *>(this)->Add(obj);
+  }
+  return obj;
+}
+
+/// Stores a calibration histograms list with the indexed layout
+///
+/// A directory with the list name is created within the passed one.
+/// Each list component is then stored as an individual key within it,
+/// sublists are stored recursively in the same way.
+/// \param list the calibration histograms list
+/// \param directory the directory where to store the list
+/// \return kTRUE if everything went right
+Bool_t QnCorrectionsCalibrationList::WriteIndexed(TList *list, TDirectory *directory) {
+  if ((list == NULL) || (directory == NULL)) return kFALSE;
+
+  TDirectory *listDirectory = directory->mkdir(list->GetName());
+  if (listDirectory == NULL) return kFALSE;
+
+  TIter next(list);
+  TObject *obj;
+  while ((obj = next()) != NULL) {
+    if (obj->InheritsFrom("TList")) {
+      if (!WriteIndexed((TList *) obj, listDirectory))
+        return kFALSE;
+    }
+    else {
+      listDirectory->WriteTObject(obj, obj->GetName());
+    }
+  }
+  return kTRUE;
+}
+
+/// Turns a list and its sublists into hashed lists
+///
+/// Calibration histograms lists stored by former framework versions
+/// are plain lists so, looking for a histogram by name goes through
+/// the whole list. The content is moved to hashed lists which own it.
+/// The passed list is deleted but not its content.
+/// \param list the list to turn into a hashed list
+/// \return the hashed list
+TList *QnCorrectionsCalibrationList::BuildHashedList(TList *list) {
+  if ((list == NULL) || list->InheritsFrom("THashList")) return list;
+
+  THashList *hashedList = new THashList(TCollection::kInitHashTableCapacity, 2);
+  hashedList->SetName(list->GetName());
+  hashedList->SetOwner(kTRUE);
+
+  TIter next(list);
+  TObject *obj;
+  while ((obj = next()) != NULL) {
+    if (obj->InheritsFrom("TList"))
+      hashedList->Add(BuildHashedList((TList *) obj));
+    else
+      hashedList->Add(obj);
+  }
+  list->SetOwner(kFALSE);
+  delete list;
+  return hashedList;
+}
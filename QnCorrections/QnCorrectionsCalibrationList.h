@@ -0,0 +1,77 @@
+#ifndef QNCORRECTIONS_CALIBRATIONLIST_H
+#define QNCORRECTIONS_CALIBRATIONLIST_H
+
+/***************************************************************************
+ * Package:       FlowVectorCorrections                                    *
+ * Authors:       Jaap Onderwaater, GSI, jacobus.onderwaater@cern.ch       *
+ *                Ilya Selyuzhenkov, GSI, ilya.selyuzhenkov@gmail.com      *
+ *                Víctor González, UCM, victor.gonzalez@cern.ch            *
+ *                Contributors are mentioned in the code where appropriate.*
+ * Development:   2012-2016                                                *
+ * See cxx source for GPL licence et. al.                                  *
+ ***************************************************************************/
+
+/// \file QnCorrectionsCalibrationList.h
+/// \brief Lazy calibration histograms list for the Q vector correction framework
+
+#include <THashList.h>
+
+class TDirectory;
+
+/// \class QnCorrectionsCalibrationList
+/// \brief Calibration histograms list that reads its content on demand
+///
+/// The framework only reaches the calibration histograms by name:
+/// the manager looks for the current process list, each detector
+/// configuration looks for its own list within it and each correction
+/// step histogram looks for its histograms within the configuration list.
+///
+/// When the calibration file has been stored with the indexed layout,
+/// i.e. each list as a directory and each histogram as an individual
+/// key, this list is associated to the corresponding directory and
+/// FindObject only reads from the file the objects actually asked for.
+/// Sublists are served as new lazy lists associated to the corresponding
+/// subdirectory. Once read, objects are kept, and owned, by the list so
+/// that further requests for them do not go again to the file.
+///
+/// The file supporting the directory must stay open while the framework
+/// could still attach inputs, i.e. while process list names could
+/// still be changed.
+///
+/// WriteIndexed stores a calibration histograms list with the
+/// indexed layout while BuildHashedList turns a calibration histograms
+/// list read at once into hashed lists.
+///
+/// \author Jaap Onderwaater <jacobus.onderwaater@cern.ch>, GSI
+/// \author Ilya Selyuzhenkov <ilya.selyuzhenkov@gmail.com>, GSI
+/// \author Víctor González <victor.gonzalez@cern.ch>, UCM
+/// \date Oct 16, 2026
+
+class QnCorrectionsCalibrationList : public THashList {
+public:
+  QnCorrectionsCalibrationList();
+  QnCorrectionsCalibrationList(TDirectory *directory);
+  virtual ~QnCorrectionsCalibrationList();
+
+  using THashList::FindObject;
+  virtual TObject *FindObject(const char *name) const;
+
+  static Bool_t WriteIndexed(TList *list, TDirectory *directory);
+  static TList *BuildHashedList(TList *list);
+
+private:
+  TDirectory *fDirectory; //!<! the directory supporting the list content
+
+  /// Copy constructor
+  /// Not allowed. Forced private.
+  QnCorrectionsCalibrationList(const QnCorrectionsCalibrationList &);
+  /// Assignment operator
+  /// Not allowed. Forced private.
+  QnCorrectionsCalibrationList& operator= (const QnCorrectionsCalibrationList &);
+
+/// \cond CLASSIMP
+  ClassDef(QnCorrectionsCalibrationList, 1);
+/// \endcond
+};
+
+#endif // QNCORRECTIONS_CALIBRATIONLIST_H
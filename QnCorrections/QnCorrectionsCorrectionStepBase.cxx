@@ -32,7 +32,14 @@
 /// \file QnCorrectionsCorrectionStepBase.cxx
 /// \brief Correction steps base class implementation
 
+#include <TParameter.h>
 #include "QnCorrectionsCorrectionStepBase.h"
+#include "QnCorrectionsHistogramBase.h"
+
+const char *QnCorrectionsCorrectionStepBase::szSupportHistogramsMemoryName = "support histograms";
+const char *QnCorrectionsCorrectionStepBase::szQAHistogramsMemoryName = "QA histograms";
+const char *QnCorrectionsCorrectionStepBase::szNveQAHistogramsMemoryName = "NveQA histograms";
+const char *QnCorrectionsCorrectionStepBase::szCalibrationInputsMemoryName = "calibration inputs";
 
 /// \cond CLASSIMP
 ClassImp(QnCorrectionsCorrectionStepBase);
@@ -44,6 +51,10 @@ QnCorrectionsCorrectionStepBase::QnCorrectionsCorrectionStepBase() : TNamed() {
   fState = QCORRSTEP_calibration;
   fDetectorConfiguration = NULL;
   fKey = "";
+  fProcessCorrectionsTime = 0;
+  fProcessCorrectionsCalls = 0;
+  fProcessDataCollectionTime = 0;
+  fProcessDataCollectionCalls = 0;
 }
 
 /// Normal constructor
@@ -55,6 +66,10 @@ QnCorrectionsCorrectionStepBase::QnCorrectionsCorrectionStepBase(const char *nam
   fState = QCORRSTEP_calibration;
   fDetectorConfiguration = NULL;
   fKey = key;
+  fProcessCorrectionsTime = 0;
+  fProcessCorrectionsCalls = 0;
+  fProcessDataCollectionTime = 0;
+  fProcessDataCollectionCalls = 0;
 }
 
 /// Default destructor
@@ -71,4 +86,28 @@ Bool_t QnCorrectionsCorrectionStepBase::Before(const QnCorrectionsCorrectionStep
   return kFALSE;
 }
 
+/// Adds memory to a memory report list
+///
+/// The memory is accumulated in the list entry with the passed
+/// category name which is created if needed. No memory, no entry.
+/// \param list the memory report list
+/// \param category the name of the memory category
+/// \param size the memory in bytes
+void QnCorrectionsCorrectionStepBase::AddMemoryUsage(TList *list, const char *category, Long64_t size) {
+  if (size == 0) return;
+
+  TParameter<Long64_t> *usage = (TParameter<Long64_t> *) list->FindObject(category);
+  if (usage != NULL)
+    usage->SetVal(usage->GetVal() + size);
+  else
+    list->Add(new TParameter<Long64_t>(category, size));
+}
 
+/// Adds the memory taken by a set of histograms to a memory report list
+/// \param list the memory report list
+/// \param category the name of the memory category
+/// \param histograms the histograms, NULL if not created
+void QnCorrectionsCorrectionStepBase::AddMemoryUsage(TList *list, const char *category, const QnCorrectionsHistogramBase *histograms) {
+  if (histograms != NULL)
+    AddMemoryUsage(list, category, histograms->GetMemorySize());
+}
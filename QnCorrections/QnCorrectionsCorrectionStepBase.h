@@ -15,12 +15,14 @@
 /// \brief Base class for the support of the different correction steps within Q vector correction framework
 ///
 
+#include <chrono>
 #include <TNamed.h>
 #include <TList.h>
 
 class QnCorrectionsDetectorConfigurationBase;
 class QnCorrectionsDetectorConfigurationChannels;
 class QnCorrectionsQnVector;
+class QnCorrectionsHistogramBase;
 
 /// \class QnCorrectionsCorrectionStepBase
 /// \brief Base class for correction steps
@@ -29,6 +31,10 @@ class QnCorrectionsQnVector;
 /// in an open way while the key is used to codify its position
 /// in an ordered list of consecutive corrections.
 ///
+/// When the framework processing is timed the detector configuration
+/// uses the timed versions of the processing requests, which accumulate
+/// the time spent and the number of calls of the correction step.
+///
 /// \author Jaap Onderwaater <jacobus.onderwaater@cern.ch>, GSI
 /// \author Ilya Selyuzhenkov <ilya.selyuzhenkov@gmail.com>, GSI
 /// \author Víctor González <victor.gonzalez@cern.ch>, UCM
@@ -119,6 +125,27 @@ public:
   /// Clean the correction to accept a new event
   /// Pure virtual function
   virtual void ClearCorrectionStep() = 0;
+  /// Transfers the accumulated contents to the support histograms
+  ///
+  /// Histograms that accumulate in own buffers keep their contents
+  /// there until this request.
+  /// Default behavior: no accumulated contents to transfer
+  virtual void FlushHistograms() {}
+  /// Shares the support histograms of the same correction step of another framework instance
+  ///
+  /// The support histograms created for filling accumulate from then on
+  /// into the ones of the passed correction step.
+  /// Default behavior: no shareable support histograms
+  /// \param master the correction step whose support histograms will be shared
+  virtual void ShareSupportHistograms(QnCorrectionsCorrectionStepBase *master) {}
+  /// Include the detector configurations the correction step reads from
+  ///
+  /// The data collection of the correction step reads the current Qn
+  /// vector of those detector configurations so, their corrections
+  /// must be already processed.
+  /// Default behavior: no other detector configuration involved
+  /// \param list list where the detector configurations should be incorporated
+  virtual void FillReferenceConfigurationsList(TList *list) const {}
   /// Reports if the correction step is being applied
   /// Pure virutal function
   /// \return TRUE if the correction step is being applied
@@ -133,6 +160,41 @@ public:
   /// \param applyList list containing the correction steps applying corrections
   /// \return kTRUE if the correction step is being applied
   virtual Bool_t ReportUsage(TList *calibrationList, TList *applyList) = 0;
+  /// Report on the memory taken by the correction step
+  /// Pure virtual function
+  /// Correction step should incorporate, to the passed list, a list
+  /// with its name and the memory taken by its support, QA, non validated
+  /// entries QA histograms and calibration inputs.
+  /// \param list list where the correction step memory list should be incorporated
+  virtual void ReportOnMemory(TList *list) const = 0;
+
+  Bool_t TimedProcessCorrections(const Float_t *variableContainer);
+  Bool_t TimedProcessDataCollection(const Float_t *variableContainer);
+  /// Gets the time spent processing the correction step
+  /// \return the accumulated time in nanoseconds
+  Long64_t GetProcessCorrectionsTime() const { return fProcessCorrectionsTime; }
+  /// Gets the number of timed correction step processings
+  /// \return the number of calls
+  Long64_t GetProcessCorrectionsCalls() const { return fProcessCorrectionsCalls; }
+  /// Gets the time spent in the correction step data collection
+  /// \return the accumulated time in nanoseconds
+  Long64_t GetProcessDataCollectionTime() const { return fProcessDataCollectionTime; }
+  /// Gets the number of timed correction step data collections
+  /// \return the number of calls
+  Long64_t GetProcessDataCollectionCalls() const { return fProcessDataCollectionCalls; }
+  /// Gets a monotonic time stamp for timing the framework processing
+  /// \return the current steady clock time in nanoseconds
+  static Long64_t GetTimeStamp()
+  { return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+  static void AddMemoryUsage(TList *list, const char *category, Long64_t size);
+  static void AddMemoryUsage(TList *list, const char *category, const QnCorrectionsHistogramBase *histograms);
+
+  static const char *szSupportHistogramsMemoryName;  ///< the name of the support histograms memory entries
+  static const char *szQAHistogramsMemoryName;       ///< the name of the QA histograms memory entries
+  static const char *szNveQAHistogramsMemoryName;    ///< the name of the non validated entries QA histograms memory entries
+  static const char *szCalibrationInputsMemoryName;  ///< the name of the calibration inputs memory entries
 protected:
   /// Stores the detector configuration owner
   /// \param detectorConfiguration the detector configuration owner
@@ -142,6 +204,10 @@ protected:
   QnCorrectionStepStatus fState;                                  ///< the state in which the correction step is
   QnCorrectionsDetectorConfigurationBase *fDetectorConfiguration; ///< pointer to the detector configuration owner
   TString fKey;                                                   ///< the correction key that codifies order information
+  Long64_t fProcessCorrectionsTime;                               //!<! the time spent processing the correction step, ns
+  Long64_t fProcessCorrectionsCalls;                              //!<! the number of timed correction step processings
+  Long64_t fProcessDataCollectionTime;                            //!<! the time spent in the correction step data collection, ns
+  Long64_t fProcessDataCollectionCalls;                           //!<! the number of timed correction step data collections
 
 private:
   /// Copy constructor
@@ -156,4 +222,26 @@ private:
 /// \endcond
 };
 
+/// Processes the correction step accounting the time spent
+/// \param variableContainer pointer to the variable content bank
+/// \return the correction step processing result
+inline Bool_t QnCorrectionsCorrectionStepBase::TimedProcessCorrections(const Float_t *variableContainer) {
+  Long64_t start = GetTimeStamp();
+  Bool_t result = ProcessCorrections(variableContainer);
+  fProcessCorrectionsTime += GetTimeStamp() - start;
+  fProcessCorrectionsCalls++;
+  return result;
+}
+
+/// Processes the correction step data collection accounting the time spent
+/// \param variableContainer pointer to the variable content bank
+/// \return the correction step data collection result
+inline Bool_t QnCorrectionsCorrectionStepBase::TimedProcessDataCollection(const Float_t *variableContainer) {
+  Long64_t start = GetTimeStamp();
+  Bool_t result = ProcessDataCollection(variableContainer);
+  fProcessDataCollectionTime += GetTimeStamp() - start;
+  fProcessDataCollectionCalls++;
+  return result;
+}
+
 #endif // QNCORRECTIONS_CORRECTIONSTEPBASE_H
@@ -32,6 +32,9 @@
 /// \brief Implementation of the classes that model the cuts support
 /// \brief Implementation of the lower limit cut class for the Q vector correction framework
 
+#include <math.h>
+#include <TMath.h>
+
 #include "QnCorrectionsCutAbove.h"
 #include "QnCorrectionsLog.h"
 
@@ -63,4 +66,18 @@ QnCorrectionsCutAbove::QnCorrectionsCutAbove(Int_t varId, Float_t threshold) :
 QnCorrectionsCutAbove::~QnCorrectionsCutAbove() {
 }
 
-
+/// Produces the flat representation of the cut
+///
+/// The cut is represented as the closed interval just above the threshold
+/// \param cut the compiled cut to fill
+/// \return kTRUE, the cut is always compiled
+Bool_t QnCorrectionsCutAbove::Compile(QnCorrectionsCompiledCut &cut) const {
+  /* the closed interval starting just above the threshold */
+  cut.fVarId = fVarId;
+  cut.fOpCode = kINTERVAL;
+  cut.fMin = nextafterf(fThreshold, Float_t(TMath::Infinity()));
+  cut.fMax = Float_t(TMath::Infinity());
+  cut.fBitMask = 0;
+  cut.fExpectedResult = 0;
+  return kTRUE;
+}
@@ -37,6 +37,7 @@ class QnCorrectionsCutAbove: public QnCorrectionsCutsBase {
   virtual ~QnCorrectionsCutAbove();
 
   virtual Bool_t IsSelected(const Float_t *variableContainer);
+  virtual Bool_t Compile(QnCorrectionsCompiledCut &cut) const;
  private:
   Float_t         fThreshold;   ///< The value that must be surpassed
 
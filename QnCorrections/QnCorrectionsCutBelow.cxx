@@ -31,6 +31,9 @@
 /// \file QnCorrectionsCutBelow.cxx
 /// \brief Implementation of the upper limit cut class support for the Q vector correction framework
 
+#include <math.h>
+#include <TMath.h>
+
 #include "QnCorrectionsCutBelow.h"
 #include "QnCorrectionsLog.h"
 
@@ -62,4 +65,18 @@ QnCorrectionsCutBelow::QnCorrectionsCutBelow(Int_t varId, Float_t threshold) :
 QnCorrectionsCutBelow::~QnCorrectionsCutBelow() {
 }
 
-
+/// Produces the flat representation of the cut
+///
+/// The cut is represented as the closed interval just below the threshold
+/// \param cut the compiled cut to fill
+/// \return kTRUE, the cut is always compiled
+Bool_t QnCorrectionsCutBelow::Compile(QnCorrectionsCompiledCut &cut) const {
+  /* the closed interval ending just below the threshold */
+  cut.fVarId = fVarId;
+  cut.fOpCode = kINTERVAL;
+  cut.fMin = -Float_t(TMath::Infinity());
+  cut.fMax = nextafterf(fThreshold, -Float_t(TMath::Infinity()));
+  cut.fBitMask = 0;
+  cut.fExpectedResult = 0;
+  return kTRUE;
+}
@@ -37,6 +37,7 @@ class QnCorrectionsCutBelow: public QnCorrectionsCutsBase {
   virtual ~QnCorrectionsCutBelow();
 
   virtual Bool_t IsSelected(const Float_t *variableContainer);
+  virtual Bool_t Compile(QnCorrectionsCompiledCut &cut) const;
  private:
   Float_t         fThreshold;   ///< The upper, not reached, value
 
@@ -66,4 +66,17 @@ QnCorrectionsCutOutside::QnCorrectionsCutOutside(Int_t varId, Float_t min, Float
 QnCorrectionsCutOutside::~QnCorrectionsCutOutside() {
 }
 
-
+/// Produces the flat representation of the cut
+///
+/// The cut is represented as the complement of the open interval
+/// \param cut the compiled cut to fill
+/// \return kTRUE, the cut is always compiled
+Bool_t QnCorrectionsCutOutside::Compile(QnCorrectionsCompiledCut &cut) const {
+  cut.fVarId = fVarId;
+  cut.fOpCode = kOUTSIDE;
+  cut.fMin = fMinThreshold;
+  cut.fMax = fMaxThreshold;
+  cut.fBitMask = 0;
+  cut.fExpectedResult = 0;
+  return kTRUE;
+}
@@ -71,4 +71,17 @@ QnCorrectionsCutSetBit::QnCorrectionsCutSetBit(Int_t varId, Int_t bitNo, Bool_t
 QnCorrectionsCutSetBit::~QnCorrectionsCutSetBit() {
 }
 
-
+/// Produces the flat representation of the cut
+///
+/// The cut is represented as the bit mask test
+/// \param cut the compiled cut to fill
+/// \return kTRUE, the cut is always compiled
+Bool_t QnCorrectionsCutSetBit::Compile(QnCorrectionsCompiledCut &cut) const {
+  cut.fVarId = fVarId;
+  cut.fOpCode = kBITMASK;
+  cut.fMin = 0.0;
+  cut.fMax = 0.0;
+  cut.fBitMask = fBitMask;
+  cut.fExpectedResult = fExpectedResult;
+  return kTRUE;
+}
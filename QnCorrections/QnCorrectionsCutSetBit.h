@@ -39,6 +39,7 @@ class QnCorrectionsCutSetBit: public QnCorrectionsCutsBase {
   virtual ~QnCorrectionsCutSetBit();
 
   virtual Bool_t IsSelected(const Float_t *variableContainer);
+  virtual Bool_t Compile(QnCorrectionsCompiledCut &cut) const;
  private:
   UInt_t          fBitMask;   ///< The mask to apply to the variable value
   UInt_t          fExpectedResult; ///< The expected masked result to pass the cut
@@ -63,4 +63,17 @@ QnCorrectionsCutValue::QnCorrectionsCutValue(Int_t varId, Float_t value) :
 QnCorrectionsCutValue::~QnCorrectionsCutValue() {
 }
 
-
+/// Produces the flat representation of the cut
+///
+/// The cut is represented as the degenerated closed interval at the desired value
+/// \param cut the compiled cut to fill
+/// \return kTRUE, the cut is always compiled
+Bool_t QnCorrectionsCutValue::Compile(QnCorrectionsCompiledCut &cut) const {
+  cut.fVarId = fVarId;
+  cut.fOpCode = kINTERVAL;
+  cut.fMin = fValue;
+  cut.fMax = fValue;
+  cut.fBitMask = 0;
+  cut.fExpectedResult = 0;
+  return kTRUE;
+}
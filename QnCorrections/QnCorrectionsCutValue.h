@@ -38,6 +38,7 @@ class QnCorrectionsCutValue: public QnCorrectionsCutsBase {
   virtual ~QnCorrectionsCutValue();
 
   virtual Bool_t IsSelected(const Float_t *variableContainer);
+  virtual Bool_t Compile(QnCorrectionsCompiledCut &cut) const;
  private:
   Float_t         fValue;   ///< The desired value
 
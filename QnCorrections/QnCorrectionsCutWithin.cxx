@@ -31,6 +31,9 @@
 /// \file QnCorrectionsCutWithin.cxx
 /// \brief Implementation of the within range cut class support for the Q vector correction framework
 
+#include <math.h>
+#include <TMath.h>
+
 #include "QnCorrectionsCutWithin.h"
 #include "QnCorrectionsLog.h"
 
@@ -66,4 +69,18 @@ QnCorrectionsCutWithin::QnCorrectionsCutWithin(Int_t varId, Float_t min, Float_t
 QnCorrectionsCutWithin::~QnCorrectionsCutWithin() {
 }
 
-
+/// Produces the flat representation of the cut
+///
+/// The cut is represented as the closed interval just inside the thresholds
+/// \param cut the compiled cut to fill
+/// \return kTRUE, the cut is always compiled
+Bool_t QnCorrectionsCutWithin::Compile(QnCorrectionsCompiledCut &cut) const {
+  /* the closed interval just inside the open one */
+  cut.fVarId = fVarId;
+  cut.fOpCode = kINTERVAL;
+  cut.fMin = nextafterf(fMinThreshold, Float_t(TMath::Infinity()));
+  cut.fMax = nextafterf(fMaxThreshold, -Float_t(TMath::Infinity()));
+  cut.fBitMask = 0;
+  cut.fExpectedResult = 0;
+  return kTRUE;
+}
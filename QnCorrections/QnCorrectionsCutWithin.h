@@ -38,6 +38,7 @@ class QnCorrectionsCutWithin: public QnCorrectionsCutsBase {
   virtual ~QnCorrectionsCutWithin();
 
   virtual Bool_t IsSelected(const Float_t *variableContainer);
+  virtual Bool_t Compile(QnCorrectionsCompiledCut &cut) const;
  private:
   Float_t         fMinThreshold;   ///< The lower limit
   Float_t         fMaxThreshold;   ///< The upper limit
@@ -17,6 +17,22 @@
 #include <TObject.h>
 #include <TObjArray.h>
 
+/// \struct QnCorrectionsCompiledCut
+/// \brief Flat representation of a cut for its evaluation without virtual dispatch
+///
+/// Depending on the operation code the cut passes when the variable value
+/// is within the closed interval [fMin,fMax], when it is not within the
+/// open interval (fMin,fMax) or when its bits selected by fBitMask
+/// match fExpectedResult.
+struct QnCorrectionsCompiledCut {
+  Int_t fVarId;             ///< the external Id for the variable in the data bank
+  Int_t fOpCode;            ///< the operation to perform on the variable value
+  Float_t fMin;             ///< the interval lower limit
+  Float_t fMax;             ///< the interval upper limit
+  UInt_t fBitMask;          ///< the bits to consider
+  UInt_t fExpectedResult;   ///< the expected value for the considered bits
+};
+
 /// \class QnCorrectionsCutsBase
 /// \brief Base class for the Q vector correction cuts
 ///
@@ -32,6 +48,14 @@
 class QnCorrectionsCutsBase: public TObject {
 
  public:
+  /// \typedef QnCutOperation
+  /// \brief The operations a compiled cut can perform
+  typedef enum {
+    kINTERVAL=0,              ///< the value should be within the closed interval
+    kOUTSIDE,                 ///< the value should not be within the open interval
+    kBITMASK                  ///< the masked bits should match the expected result
+  } QnCutOperation;
+
   QnCorrectionsCutsBase();
   QnCorrectionsCutsBase(const QnCorrectionsCutsBase &cut);
   QnCorrectionsCutsBase(Int_t varId);
@@ -48,6 +72,12 @@ class QnCorrectionsCutsBase: public TObject {
   /// \param variableContainer the current variables content addressed by var Id
   /// \return kTRUE if the actual value passes the cut else kFALSE
   virtual Bool_t IsSelected(const Float_t *variableContainer) = 0;
+  /// Produces the flat representation of the cut
+  ///
+  /// Default behavior: the cut cannot be compiled
+  /// \param cut the compiled cut to fill
+  /// \return kTRUE if the cut has been compiled else kFALSE
+  virtual Bool_t Compile(QnCorrectionsCompiledCut &cut) const { return kFALSE; }
  protected:
   Int_t         fVarId;   ///< The external Id for the variable in the data bank
 
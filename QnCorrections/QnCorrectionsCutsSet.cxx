@@ -39,5 +39,91 @@
 ClassImp(QnCorrectionsCutsSet);
 /// \endcond
 
+/// Copy constructor
+///
+/// The compiled representation is not copied, the new set
+/// should be compiled on its own
+/// \param ccs the object instance to be copied
+QnCorrectionsCutsSet::QnCorrectionsCutsSet(const QnCorrectionsCutsSet &ccs) :
+    TObjArray(ccs), fNoOfCompiledCuts(-1), fNoOfEventLevelCompiledCuts(0), fCompiledCuts(NULL) {
+}
 
+/// Default destructor
+/// Releases the compiled representation if any
+QnCorrectionsCutsSet::~QnCorrectionsCutsSet() {
+  if (fCompiledCuts != NULL) delete [] fCompiledCuts;
+}
 
+/// Produces the flat representation of the set of cuts
+///
+/// Interval cuts on the same variable are merged into a single
+/// interval and bit mask cuts on the same variable are merged into
+/// a single mask whenever they don't contradict each other. Cuts
+/// outside an interval are kept as they are.
+///
+/// The cuts on event level variables are placed first. Without
+/// information on the event level variables all of them are
+/// considered data vector level ones.
+///
+/// If any of the cuts cannot be compiled the set stays with
+/// the evaluation of each cut on its own.
+/// \param eventLevelVariables flags, addressed by var Id, for the variables constant within the event. Could be NULL
+void QnCorrectionsCutsSet::Compile(const Bool_t *eventLevelVariables) {
+  if (fCompiledCuts != NULL) delete [] fCompiledCuts;
+  fCompiledCuts = NULL;
+  fNoOfCompiledCuts = -1;
+  fNoOfEventLevelCompiledCuts = 0;
+
+  Int_t nCuts = GetEntriesFast();
+  QnCorrectionsCompiledCut *compiled = new QnCorrectionsCompiledCut[(nCuts > 0) ? nCuts : 1];
+  Int_t nCompiled = 0;
+  Int_t nEventLevel = 0;
+
+  for (Int_t icut = 0; icut < nCuts; icut++) {
+    QnCorrectionsCompiledCut cut;
+    if ((At(icut) == NULL) || !At(icut)->Compile(cut)) {
+      QnCorrectionsInfo(Form("Cut %d in set could not be compiled. Evaluating the set cut by cut", icut));
+      delete [] compiled;
+      return;
+    }
+    Bool_t eventLevel = ((eventLevelVariables != NULL) && eventLevelVariables[cut.fVarId]);
+    /* look for a compatible cut on the same variable */
+    Bool_t merged = kFALSE;
+    for (Int_t jcut = 0; jcut < nCompiled; jcut++) {
+      QnCorrectionsCompiledCut &target = compiled[jcut];
+      if ((target.fVarId != cut.fVarId) || (target.fOpCode != cut.fOpCode)) continue;
+      if (cut.fOpCode == QnCorrectionsCutsBase::kINTERVAL) {
+        /* the intersection of both intervals */
+        if (target.fMin < cut.fMin) target.fMin = cut.fMin;
+        if (cut.fMax < target.fMax) target.fMax = cut.fMax;
+        merged = kTRUE;
+        break;
+      }
+      else if (cut.fOpCode == QnCorrectionsCutsBase::kBITMASK) {
+        /* only if the common bits expect the same result */
+        if ((target.fBitMask & cut.fBitMask & (target.fExpectedResult ^ cut.fExpectedResult)) == 0) {
+          target.fBitMask |= cut.fBitMask;
+          target.fExpectedResult |= cut.fExpectedResult;
+          merged = kTRUE;
+          break;
+        }
+      }
+    }
+    if (!merged) {
+      if (eventLevel) {
+        /* keep the event level cuts at the beginning */
+        for (Int_t jcut = nCompiled; jcut > nEventLevel; jcut--) {
+          compiled[jcut] = compiled[jcut - 1];
+        }
+        compiled[nEventLevel++] = cut;
+        nCompiled++;
+      }
+      else {
+        compiled[nCompiled++] = cut;
+      }
+    }
+  }
+  fCompiledCuts = compiled;
+  fNoOfCompiledCuts = nCompiled;
+  fNoOfEventLevelCompiledCuts = nEventLevel;
+}
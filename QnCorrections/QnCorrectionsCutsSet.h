@@ -30,6 +30,18 @@
 /// Provides IsSelected that goes through the whole set of cuts
 /// to check whether the current variables values pass the them.
 ///
+/// Once the set is complete, Compile produces a flat representation
+/// of it. Cuts on the same variable are merged into a single test
+/// and IsSelected goes then through the compiled cuts in a tight loop
+/// without virtual calls. If cuts are added to the set after it has
+/// been compiled, Compile should be called again.
+///
+/// When compiling, the cuts on variables which are constant within
+/// the event are kept apart from the ones on variables which change
+/// with each data vector. IsEventSelected and IsDataVectorSelected
+/// evaluate each of both groups so that the event level cuts
+/// need only to be evaluated once per event.
+///
 /// The cuts objects are not own by the array so,
 /// they are not destroyed when the the set is destroyed. This allows
 /// to create several sets with the same cuts.
@@ -47,31 +59,66 @@ class QnCorrectionsCutsSet : public TObjArray {
 public:
   /// Normal constructor
   /// \param n number of cuts in the set
-  QnCorrectionsCutsSet(Int_t n = TCollection::kInitCapacity) : TObjArray(n) {}
-  /// Copy constructor
-  /// \param ccs the object instance to be copied
-  QnCorrectionsCutsSet(const QnCorrectionsCutsSet &ccs) : TObjArray(ccs) {}
-  /// Default destructor
-  virtual ~QnCorrectionsCutsSet() {}
+  QnCorrectionsCutsSet(Int_t n = TCollection::kInitCapacity) :
+    TObjArray(n), fNoOfCompiledCuts(-1), fNoOfEventLevelCompiledCuts(0), fCompiledCuts(NULL) {}
+  QnCorrectionsCutsSet(const QnCorrectionsCutsSet &ccs);
+  virtual ~QnCorrectionsCutsSet();
 
   /// Access the event class variable at the passed position
   /// \param i position in the array (starting at zero)
   /// \return the event class variable object a position i
   virtual QnCorrectionsCutsBase *At(Int_t i) const { return (QnCorrectionsCutsBase *) TObjArray::At(i); }
 
+  void Compile(const Bool_t *eventLevelVariables = NULL);
+  /// Checks if the set of cuts has been compiled
+  /// \return kTRUE if the compiled representation is in use
+  Bool_t IsCompiled() const { return (fNoOfCompiledCuts >= 0); }
+  /// Checks if the set has cuts to evaluate for each data vector
+  /// \return kTRUE if there are data vector level cuts
+  Bool_t HasDataVectorLevelCuts() const
+  { return ((fNoOfCompiledCuts < 0) ? (GetEntriesFast() != 0) : (fNoOfEventLevelCompiledCuts < fNoOfCompiledCuts)); }
   Bool_t IsSelected(const Float_t *variableContainer);
+  /// Checks that the current content of the variableContainer passes
+  /// the event level cuts. Always passes if the set is not compiled.
+  /// \param variableContainer the current variables content addressed by var Id
+  /// \return kTRUE if the actual values pass the event level cuts else kFALSE
+  Bool_t IsEventSelected(const Float_t *variableContainer)
+  { return ((fNoOfCompiledCuts < 0) ? kTRUE : IsSelected(variableContainer, 0, fNoOfEventLevelCompiledCuts)); }
+  /// Checks that the current content of the variableContainer passes
+  /// the data vector level cuts. All the cuts if the set is not compiled.
+  /// \param variableContainer the current variables content addressed by var Id
+  /// \return kTRUE if the actual values pass the data vector level cuts else kFALSE
+  Bool_t IsDataVectorSelected(const Float_t *variableContainer)
+  { return ((fNoOfCompiledCuts < 0) ? IsSelected(variableContainer) : IsSelected(variableContainer, fNoOfEventLevelCompiledCuts, fNoOfCompiledCuts)); }
+
+private:
+  Bool_t IsSelected(const Float_t *variableContainer, Int_t first, Int_t last) const;
+
+  Int_t fNoOfCompiledCuts;                   //!<! the number of compiled cuts, -1 if not compiled
+  Int_t fNoOfEventLevelCompiledCuts;         //!<! the number of compiled cuts, at the beginning, on event level variables
+  QnCorrectionsCompiledCut *fCompiledCuts;   //!<! the compiled cuts
+
+  /// Assignment operator
+  /// Not allowed. Forced private.
+  QnCorrectionsCutsSet& operator= (const QnCorrectionsCutsSet &);
 
 /// \cond CLASSIMP
-  ClassDef(QnCorrectionsCutsSet, 1);
+  ClassDef(QnCorrectionsCutsSet, 2);
 /// \endcond
 };
 
 /// Checks that the current content of the variableContainer passes
-/// the whole set of cuts by going through all the array components
+/// the whole set of cuts
+///
+/// If the set has been compiled goes through the compiled cuts
+/// otherwise goes through all the array components
 ///
 /// \param variableContainer the current variables content addressed by var Id
 /// \return kTRUE if the actual values pass the set of cuts else kFALSE
 inline Bool_t QnCorrectionsCutsSet::IsSelected(const Float_t *variableContainer) {
+  if (fNoOfCompiledCuts >= 0) {
+    return IsSelected(variableContainer, 0, fNoOfCompiledCuts);
+  }
   for (Int_t icut = 0; icut < GetEntriesFast(); icut++) {
     if (!At(icut)->IsSelected(variableContainer)) {
       return kFALSE;
@@ -80,4 +127,30 @@ inline Bool_t QnCorrectionsCutsSet::IsSelected(const Float_t *variableContainer)
   return kTRUE;
 }
 
+/// Checks that the current content of the variableContainer passes
+/// a range of the compiled cuts
+///
+/// \param variableContainer the current variables content addressed by var Id
+/// \param first the first compiled cut to evaluate
+/// \param last the compiled cut after the last one to evaluate
+/// \return kTRUE if the actual values pass the compiled cuts range else kFALSE
+inline Bool_t QnCorrectionsCutsSet::IsSelected(const Float_t *variableContainer, Int_t first, Int_t last) const {
+  for (Int_t icut = first; icut < last; icut++) {
+    const QnCorrectionsCompiledCut &cut = fCompiledCuts[icut];
+    Float_t value = variableContainer[cut.fVarId];
+    switch (cut.fOpCode) {
+    case QnCorrectionsCutsBase::kINTERVAL:
+      if (!((cut.fMin <= value) && (value <= cut.fMax))) return kFALSE;
+      break;
+    case QnCorrectionsCutsBase::kOUTSIDE:
+      if ((cut.fMin < value) && (value < cut.fMax)) return kFALSE;
+      break;
+    default:
+      if ((UInt_t(value) & cut.fBitMask) != cut.fExpectedResult) return kFALSE;
+      break;
+    }
+  }
+  return kTRUE;
+}
+
 #endif // QNCORRECTIONS_CUTSSET_H
@@ -0,0 +1,83 @@
+/**************************************************************************************************
+ *                                                                                                *
+ * Package:       FlowVectorCorrections                                                           *
+ * Authors:       Jaap Onderwaater, GSI, jacobus.onderwaater@cern.ch                              *
+ *                Ilya Selyuzhenkov, GSI, ilya.selyuzhenkov@gmail.com                             *
+ *                Víctor González, UCM, victor.gonzalez@cern.ch                                   *
+ *                Contributors are mentioned in the code where appropriate.                       *
+ * Development:   2012-2016                                                                       *
+ *                                                                                                *
+ * This file is part of FlowVectorCorrections, a software package that corrects Q-vector          *
+ * measurements for effects of nonuniform detector acceptance. The corrections in this package    *
+ * are based on publication:                                                                      *
+ *                                                                                                *
+ *  [1] "Effects of non-uniform acceptance in anisotropic flow measurements"                      *
+ *  Ilya Selyuzhenkov and Sergei Voloshin                                                         *
+ *  Phys. Rev. C 77, 034904 (2008)                                                                *
+ *                                                                                                *
+ * The procedure proposed in [1] is extended with the following steps:                            *
+ * (*) alignment correction between subevents                                                     *
+ * (*) possibility to extract the twist and rescaling corrections                                 *
+ *      for the case of three detector subevents                                                  *
+ *      (currently limited to the case of two “hit-only” and one “tracking” detectors)            *
+ * (*) (optional) channel equalization                                                            *
+ * (*) flow vector width equalization                                                             *
+ *                                                                                                *
+ * FlowVectorCorrections is distributed under the terms of the GNU General Public License (GPL)   *
+ * (https://en.wikipedia.org/wiki/GNU_General_Public_License)                                     *
+ * either version 3 of the License, or (at your option) any later version.                        *
+ *                                                                                                *
+ **************************************************************************************************/
+
+/// \file QnCorrectionsDataVectorBank.cxx
+/// \brief Implementation of the data vector bank class
+
+#include <string.h>
+#include "QnCorrectionsDataVectorBank.h"
+
+/// Normal constructor
+/// \param initialSize the initial number of data vectors the bank can hold
+QnCorrectionsDataVectorBank::QnCorrectionsDataVectorBank(Int_t initialSize) {
+  fNoOfEntries = 0;
+  fSize = 0;
+  fId = NULL;
+  fPhi = NULL;
+  fWeight = NULL;
+  fEqualizedWeight = NULL;
+  Grow((initialSize < 1) ? 1 : initialSize);
+}
+
+/// Default destructor
+/// Releases the memory taken
+QnCorrectionsDataVectorBank::~QnCorrectionsDataVectorBank() {
+  delete [] fId;
+  delete [] fPhi;
+  delete [] fWeight;
+  delete [] fEqualizedWeight;
+}
+
+/// Enlarges the bank storage keeping its current content
+/// \param newSize the new number of data vectors the bank can hold
+void QnCorrectionsDataVectorBank::Grow(Int_t newSize) {
+  Int_t *id = new Int_t[newSize];
+  Float_t *phi = new Float_t[newSize];
+  Float_t *weight = new Float_t[newSize];
+  Float_t *equalizedWeight = new Float_t[newSize];
+
+  if (fNoOfEntries != 0) {
+    memcpy(id, fId, fNoOfEntries * sizeof(Int_t));
+    memcpy(phi, fPhi, fNoOfEntries * sizeof(Float_t));
+    memcpy(weight, fWeight, fNoOfEntries * sizeof(Float_t));
+    memcpy(equalizedWeight, fEqualizedWeight, fNoOfEntries * sizeof(Float_t));
+  }
+  delete [] fId;
+  delete [] fPhi;
+  delete [] fWeight;
+  delete [] fEqualizedWeight;
+
+  fId = id;
+  fPhi = phi;
+  fWeight = weight;
+  fEqualizedWeight = equalizedWeight;
+  fSize = newSize;
+}
@@ -0,0 +1,167 @@
+#ifndef QNCORRECTIONS_DATAVECTORBANK_H
+#define QNCORRECTIONS_DATAVECTORBANK_H
+
+/***************************************************************************
+ * Package:       FlowVectorCorrections                                    *
+ * Authors:       Jaap Onderwaater, GSI, jacobus.onderwaater@cern.ch       *
+ *                Ilya Selyuzhenkov, GSI, ilya.selyuzhenkov@gmail.com      *
+ *                Víctor González, UCM, victor.gonzalez@cern.ch            *
+ *                Contributors are mentioned in the code where appropriate.*
+ * Development:   2012-2016                                                *
+ * See cxx source for GPL licence et. al.                                  *
+ ***************************************************************************/
+
+/// \file QnCorrectionsDataVectorBank.h
+/// \brief Class that models the bank of data vectors of a detector configuration within the Q vector correction framework
+///
+/// The bank stores the data vectors in a column oriented way: one
+/// contiguous array per data vector member. In that way data vectors
+/// are incorporated without object construction and the different
+/// processing steps, input data corrections and Q vector building,
+/// sweep contiguous memory.
+///
+
+#include <string.h>
+#include <Rtypes.h>
+
+/// \class QnCorrectionsDataVectorBank
+/// \brief Column oriented storage for the data vectors of the current event
+///
+/// For each data vector the bank keeps its id, azimuthal angle,
+/// raw weight and equalized weight. At incorporation time the
+/// equalized weight is initialized with the raw weight so that
+/// input data corrections can be chained.
+///
+/// The bank grows on demand. Its content is only valid for the
+/// current event and it is never streamed.
+///
+/// For detectors that read out all their channels the whole content
+/// can be replaced at once from the channels amplitudes array.
+///
+/// \author Jaap Onderwaater <jacobus.onderwaater@cern.ch>, GSI
+/// \author Ilya Selyuzhenkov <ilya.selyuzhenkov@gmail.com>, GSI
+/// \author Víctor González <victor.gonzalez@cern.ch>, UCM
+/// \date Oct 16, 2026
+class QnCorrectionsDataVectorBank {
+public:
+  QnCorrectionsDataVectorBank(Int_t initialSize);
+  ~QnCorrectionsDataVectorBank();
+
+  void AddDataVector(Int_t id, Float_t phi, Float_t weight);
+  void AddDataVectors(const Int_t *id, const Float_t *phi, const Float_t *weight, Int_t n, Int_t stride = 0);
+  void SetChannelsDataVectors(const Int_t *id, const Float_t *phi, const Float_t *amplitude, Int_t n);
+  /// Empties the bank for accepting the next event
+  /// The allocated storage is kept
+  void Clear() { fNoOfEntries = 0; }
+
+  /// Gets the number of data vectors stored in the bank
+  /// \return the number of data vectors
+  Int_t GetEntries() const { return fNoOfEntries; }
+  /// Gets the data vectors ids
+  /// \return pointer to the ids column
+  const Int_t *GetId() const { return fId; }
+  /// Gets the data vectors azimuthal angles
+  /// \return pointer to the azimuthal angles column
+  const Float_t *GetPhi() const { return fPhi; }
+  /// Gets the data vectors raw weights
+  /// \return pointer to the raw weights column
+  const Float_t *GetWeight() const { return fWeight; }
+  /// Gets the data vectors equalized weights
+  /// Input data corrections update them in place
+  /// \return pointer to the equalized weights column
+  Float_t *GetEqualizedWeight() { return fEqualizedWeight; }
+  /// Gets the memory taken by the bank columns
+  /// \return the memory in bytes
+  Long64_t GetMemorySize() const { return Long64_t(fSize) * (sizeof(Int_t) + 3 * sizeof(Float_t)); }
+
+private:
+  void Grow(Int_t newSize);
+
+  Int_t fNoOfEntries;            ///< the number of data vectors in the bank
+  Int_t fSize;                   ///< the allocated size of each column
+  Int_t *fId;                    ///< the id associated with each data vector
+  Float_t *fPhi;                 ///< the azimuthal angle of each data vector
+  Float_t *fWeight;              ///< the raw weight of each data vector
+  Float_t *fEqualizedWeight;     ///< the equalized weight of each data vector
+
+  /// Copy constructor
+  /// Not allowed. Forced private.
+  QnCorrectionsDataVectorBank(const QnCorrectionsDataVectorBank &);
+  /// Assignment operator
+  /// Not allowed. Forced private.
+  QnCorrectionsDataVectorBank& operator= (const QnCorrectionsDataVectorBank &);
+};
+
+/// Incorporates a new data vector to the bank
+///
+/// The equalized weight is initialized with the raw weight.
+/// If needed the bank storage is doubled.
+/// \param id the id associated with the data vector
+/// \param phi the azimuthal angle
+/// \param weight the data vector raw weight
+inline void QnCorrectionsDataVectorBank::AddDataVector(Int_t id, Float_t phi, Float_t weight) {
+  if (fNoOfEntries == fSize) {
+    Grow(2 * fSize);
+  }
+  fId[fNoOfEntries] = id;
+  fPhi[fNoOfEntries] = phi;
+  fWeight[fNoOfEntries] = weight;
+  fEqualizedWeight[fNoOfEntries] = weight;
+  fNoOfEntries++;
+}
+
+/// Incorporates a set of data vectors to the bank
+///
+/// The storage is enlarged, if needed, once for the whole set.
+/// The data vectors members can be passed either as contiguous arrays,
+/// a zero stride, or as members of an array of user structures, the
+/// stride being in that case the size in bytes of the structure.
+/// \param id the ids associated with the data vectors. If NULL -1 is assigned
+/// \param phi the azimuthal angles
+/// \param weight the data vectors raw weights. If NULL 1.0 is assigned
+/// \param n the number of data vectors
+/// \param stride the distance in bytes between consecutive elements. Zero for contiguous arrays
+inline void QnCorrectionsDataVectorBank::AddDataVectors(const Int_t *id, const Float_t *phi, const Float_t *weight, Int_t n, Int_t stride) {
+  if (fSize < fNoOfEntries + n) {
+    Grow(((fNoOfEntries + n) < 2 * fSize) ? 2 * fSize : fNoOfEntries + n);
+  }
+  Int_t idStride = (stride != 0) ? stride : sizeof(Int_t);
+  Int_t valueStride = (stride != 0) ? stride : sizeof(Float_t);
+  const char *pId = reinterpret_cast<const char *>(id);
+  const char *pPhi = reinterpret_cast<const char *>(phi);
+  const char *pWeight = reinterpret_cast<const char *>(weight);
+
+  for (Int_t ixData = 0; ixData < n; ixData++) {
+    Float_t w = (pWeight != NULL) ? *reinterpret_cast<const Float_t *>(pWeight + ixData * valueStride) : 1.0;
+    fId[fNoOfEntries] = (pId != NULL) ? *reinterpret_cast<const Int_t *>(pId + ixData * idStride) : -1;
+    fPhi[fNoOfEntries] = *reinterpret_cast<const Float_t *>(pPhi + ixData * valueStride);
+    fWeight[fNoOfEntries] = w;
+    fEqualizedWeight[fNoOfEntries] = w;
+    fNoOfEntries++;
+  }
+}
+
+/// Replaces the bank content with a fixed set of channels
+///
+/// Used for detectors that read out all their channels on each event.
+/// The channels ids and azimuthal angles are fixed, only the amplitudes,
+/// addressed by channel id, change from event to event. The storage
+/// is only enlarged the first time.
+/// \param id the ids of the channels to store
+/// \param phi the azimuthal angles of the channels to store
+/// \param amplitude the amplitudes of all the detector channels
+/// \param n the number of channels to store
+inline void QnCorrectionsDataVectorBank::SetChannelsDataVectors(const Int_t *id, const Float_t *phi, const Float_t *amplitude, Int_t n) {
+  if (fSize < n) {
+    Grow(n);
+  }
+  memcpy(fId, id, n * sizeof(Int_t));
+  memcpy(fPhi, phi, n * sizeof(Float_t));
+  for (Int_t ixData = 0; ixData < n; ixData++) {
+    fWeight[ixData] = amplitude[id[ixData]];
+  }
+  memcpy(fEqualizedWeight, fWeight, n * sizeof(Float_t));
+  fNoOfEntries = n;
+}
+
+#endif /* QNCORRECTIONS_DATAVECTORBANK_H */
@@ -210,6 +210,16 @@ void QnCorrectionsDetector::FillDetectorConfigurationNameList(TList *list) const
   }
 }
 
+/// Include each detector configuration into the passed list
+///
+/// The list should not own the detector configurations
+/// \param list the list where to incorporate the detector configurations
+void QnCorrectionsDetector::FillDetectorConfigurationsList(TList *list) const {
+  for (Int_t ixConfiguration = 0; ixConfiguration < fConfigurations.GetEntriesFast(); ixConfiguration++) {
+    list->Add(fConfigurations.At(ixConfiguration));
+  }
+}
+
 /// Include the name of the input correction steps on each detector
 /// configuration into the passed list
 ///
@@ -245,4 +255,54 @@ void QnCorrectionsDetector::ReportOnCorrections(TList *steps, TList *calib, TLis
   }
 }
 
+/// Provide information about the memory taken by each of the detector configurations
+///
+/// A list with the detector name is incorporated to the passed list
+/// and the request is transmitted to the attached detector configurations
+/// \param list list for incorporating the detector memory list
+void QnCorrectionsDetector::ReportOnMemory(TList *list) const {
+  TList *detectorList = new TList();
+  detectorList->SetOwner(kTRUE);
+  detectorList->SetName(GetName());
+  for (Int_t ixConfiguration = 0; ixConfiguration < fConfigurations.GetEntriesFast(); ixConfiguration++) {
+    fConfigurations.At(ixConfiguration)->ReportOnMemory(detectorList);
+  }
+  list->Add(detectorList);
+}
+
+/// Provide information about the time spent by the detector
+///
+/// A list with the detector name is incorporated to the passed list
+/// and the request is transmitted to the attached detector configurations
+/// \param list list for incorporating the detector timing list
+void QnCorrectionsDetector::ReportOnTiming(TList *list) const {
+  TList *detectorList = new TList();
+  detectorList->SetOwner(kTRUE);
+  detectorList->SetName(GetName());
+  for (Int_t ixConfiguration = 0; ixConfiguration < fConfigurations.GetEntriesFast(); ixConfiguration++) {
+    fConfigurations.At(ixConfiguration)->ReportOnTiming(detectorList);
+  }
+  list->Add(detectorList);
+}
+
+/// Transfers the accumulated contents to the support and QA histograms
+///
+/// The request is transmitted to the attached detector configurations
+void QnCorrectionsDetector::FlushHistograms() {
+  for (Int_t ixConfiguration = 0; ixConfiguration < fConfigurations.GetEntriesFast(); ixConfiguration++) {
+    fConfigurations.At(ixConfiguration)->FlushHistograms();
+  }
+}
+
+/// Shares the support histograms of the same detector of another framework instance
+///
+/// The request is transmitted to the attached detector configurations
+/// pairing them with the ones of the passed detector
+/// \param master the detector whose support histograms will be shared
+void QnCorrectionsDetector::ShareSupportHistograms(QnCorrectionsDetector *master) {
+  for (Int_t ixConfiguration = 0; ixConfiguration < fConfigurations.GetEntriesFast(); ixConfiguration++) {
+    fConfigurations.At(ixConfiguration)->ShareSupportHistograms(master->fConfigurations.At(ixConfiguration));
+  }
+}
+
 
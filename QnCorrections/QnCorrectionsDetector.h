@@ -73,13 +73,21 @@ public:
   void AddDetectorConfiguration(QnCorrectionsDetectorConfigurationBase *detectorConfiguration);
   QnCorrectionsDetectorConfigurationBase *FindDetectorConfiguration(const char *name);
   void FillDetectorConfigurationNameList(TList *list) const;
+  void FillDetectorConfigurationsList(TList *list) const;
   void FillOverallInputCorrectionStepList(TList *list) const;
   void FillOverallQnVectorCorrectionStepList(TList *list) const;
   virtual void ReportOnCorrections(TList *steps, TList *calib, TList *apply) const;
+  void ReportOnMemory(TList *list) const;
+  void ReportOnTiming(TList *list) const;
 
   Int_t AddDataVector(const Float_t *variableContainer, Double_t phi, Double_t weight = 1.0, Int_t channelId = -1);
+  Int_t AddDataVectors(const Float_t *variableContainer, const Float_t *phi, const Float_t *weight,
+      const Int_t *channelId, Int_t n, Int_t stride = 0);
+  Int_t AddChannelsAmplitudes(const Float_t *variableContainer, const Float_t *amplitude);
 
   virtual void ClearDetector();
+  void FlushHistograms();
+  void ShareSupportHistograms(QnCorrectionsDetector *master);
 
 private:
   Int_t fDetectorId;            ///< detector Id
@@ -120,6 +128,53 @@ inline Int_t QnCorrectionsDetector::AddDataVector(const Float_t *variableContain
   return fDataVectorAcceptedConfigurations.GetEntries();
 }
 
+/// New set of data vectors for the detector
+/// The request is transmitted once to each of the attached detector
+/// configurations. The current content of the variable bank is passed in
+/// order to check for optional cuts that define the detector configurations.
+/// \param variableContainer pointer to the variable content bank
+/// \param phi array of azimuthal angles
+/// \param weight array of data vector weights. NULL for unit weights
+/// \param channelId array of channel Ids that originate the data vectors. Could be NULL for track detectors
+/// \param n the number of data vectors
+/// \param stride the distance in bytes between consecutive elements. Zero for contiguous arrays
+/// \return the overall number of data vectors stored by the detector configurations
+inline Int_t QnCorrectionsDetector::AddDataVectors(const Float_t *variableContainer,
+    const Float_t *phi, const Float_t *weight, const Int_t *channelId, Int_t n, Int_t stride) {
+  Int_t nStored = 0;
+
+  fDataVectorAcceptedConfigurations.Clear();
+  for (Int_t ixConfiguration = 0; ixConfiguration < fConfigurations.GetEntriesFast(); ixConfiguration++) {
+    Int_t nAccepted = fConfigurations.At(ixConfiguration)->AddDataVectors(variableContainer, phi, weight, channelId, n, stride);
+    if (0 < nAccepted) {
+      fDataVectorAcceptedConfigurations.Add(fConfigurations.At(ixConfiguration));
+      nStored += nAccepted;
+    }
+  }
+  return nStored;
+}
+
+/// New set of amplitudes for all the detector channels
+/// The request is transmitted once to each of the attached detector
+/// configurations. The current content of the variable bank is passed in
+/// order to check for optional cuts that define the detector configurations.
+/// \param variableContainer pointer to the variable content bank
+/// \param amplitude array with the amplitude of each detector channel
+/// \return the overall number of data vectors stored by the detector configurations
+inline Int_t QnCorrectionsDetector::AddChannelsAmplitudes(const Float_t *variableContainer, const Float_t *amplitude) {
+  Int_t nStored = 0;
+
+  fDataVectorAcceptedConfigurations.Clear();
+  for (Int_t ixConfiguration = 0; ixConfiguration < fConfigurations.GetEntriesFast(); ixConfiguration++) {
+    Int_t nAccepted = fConfigurations.At(ixConfiguration)->AddChannelsAmplitudes(variableContainer, amplitude);
+    if (0 < nAccepted) {
+      fDataVectorAcceptedConfigurations.Add(fConfigurations.At(ixConfiguration));
+      nStored += nAccepted;
+    }
+  }
+  return nStored;
+}
+
 /// Ask for processing corrections for the involved detector
 ///
 /// The request is transmitted to the attached detector configurations
@@ -32,6 +32,7 @@
 /// \file QnCorrectionsDetectorConfigurationBase.cxx
 /// \brief Implementation of the base detector configuration class within Q vector correction framework
 
+#include <TH1.h>
 #include "QnCorrectionsDetectorConfigurationBase.h"
 #include "QnCorrectionsLog.h"
 
@@ -40,6 +41,12 @@ ClassImp(QnCorrectionsDetectorConfigurationBase);
 /// \endcond
 
 const char *QnCorrectionsDetectorConfigurationBase::szPlainQnVectorName = "plain";
+const char *QnCorrectionsDetectorConfigurationBase::szDataVectorBankMemoryName = "data vector bank";
+const char *QnCorrectionsDetectorConfigurationBase::szTimingUnitNames[TIMING_NoOfUnits] = {
+    "raw Qn vector build",
+    "Qn vector build",
+    "QA histograms"
+};
 
 
 /// Default constructor
@@ -54,9 +61,16 @@ QnCorrectionsDetectorConfigurationBase::QnCorrectionsDetectorConfigurationBase()
   fDataVectorBank = NULL;
   fQnNormalizationMethod = QnCorrectionsQnVector::QVNORM_noCalibration;
   fEventClassVariables = NULL;
+  fEventSelection = kEventNotChecked;
+  fTimeProcessing = kFALSE;
+  for (Int_t unit = 0; unit < TIMING_NoOfUnits; unit++) {
+    fProcessingTime[unit] = 0;
+    fProcessingCalls[unit] = 0;
+  }
   fPlainQ2nVector.SetHarmonicMultiplier(2);
   fCorrectedQ2nVector.SetHarmonicMultiplier(2);
-  fTempQ2nVector.SetHarmonicMultiplier(2);
+  fTempQnVector.SetStructure(fPlainQnVector);
+  fTempQ2nVector.SetStructure(fPlainQ2nVector);
 }
 
 /// Normal constructor
@@ -73,8 +87,7 @@ QnCorrectionsDetectorConfigurationBase::QnCorrectionsDetectorConfigurationBase(c
           fPlainQ2nVector(Form("%s2n",szPlainQnVectorName),nNoOfHarmonics, harmonicMap),
           fCorrectedQnVector(szPlainQnVectorName,nNoOfHarmonics, harmonicMap),
           fCorrectedQ2nVector(Form("%s2n",szPlainQnVectorName),nNoOfHarmonics, harmonicMap),
-          fTempQnVector("temp",nNoOfHarmonics, harmonicMap),
-          fTempQ2nVector("temp2n",nNoOfHarmonics, harmonicMap),
+          fTempQnVector(), fTempQ2nVector(),
           fQnVectorCorrections() {
 
   fDetector = NULL;
@@ -83,9 +96,16 @@ QnCorrectionsDetectorConfigurationBase::QnCorrectionsDetectorConfigurationBase(c
   fDataVectorBank = NULL;
   fQnNormalizationMethod = QnCorrectionsQnVector::QVNORM_noCalibration;
   fEventClassVariables = eventClassesVariables;
+  fEventSelection = kEventNotChecked;
+  fTimeProcessing = kFALSE;
+  for (Int_t unit = 0; unit < TIMING_NoOfUnits; unit++) {
+    fProcessingTime[unit] = 0;
+    fProcessingCalls[unit] = 0;
+  }
   fPlainQ2nVector.SetHarmonicMultiplier(2);
   fCorrectedQ2nVector.SetHarmonicMultiplier(2);
-  fTempQ2nVector.SetHarmonicMultiplier(2);
+  fTempQnVector.SetStructure(fPlainQnVector);
+  fTempQ2nVector.SetStructure(fPlainQ2nVector);
 }
 
 /// Default destructor
@@ -142,6 +162,18 @@ Bool_t QnCorrectionsDetectorConfigurationBase::IsCorrectionStepBeingApplied(cons
   return fQnVectorCorrections.IsCorrectionStepBeingApplied(step);
 }
 
+/// Include the detector configurations the correction steps read from
+///
+/// Transfers the request to the set of Qn vector corrections.
+/// A detector configuration could be incorporated more than once.
+/// \param list list where the detector configurations should be incorporated
+void QnCorrectionsDetectorConfigurationBase::FillReferenceConfigurationsList(TList *list) const {
+
+  for (Int_t ixCorrection = 0; ixCorrection < fQnVectorCorrections.GetEntries(); ixCorrection++) {
+    fQnVectorCorrections.At(ixCorrection)->FillReferenceConfigurationsList(list);
+  }
+}
+
 
 /// Activate the processing for the passed harmonic
 /// \param harmonic the desired harmonic number to activate
@@ -150,8 +182,8 @@ void QnCorrectionsDetectorConfigurationBase::ActivateHarmonic(Int_t harmonic) {
   fCorrectedQnVector.ActivateHarmonic(harmonic);
   fPlainQ2nVector.ActivateHarmonic(harmonic);
   fCorrectedQ2nVector.ActivateHarmonic(harmonic);
-  fTempQnVector.ActivateHarmonic(harmonic);
-  fTempQ2nVector.ActivateHarmonic(harmonic);
+  fTempQnVector.SetStructure(fPlainQnVector);
+  fTempQ2nVector.SetStructure(fPlainQ2nVector);
 }
 
 /// Checks if the current content of the variable bank applies to
@@ -187,3 +219,59 @@ Bool_t QnCorrectionsDetectorConfigurationBase::IsSelected(const Float_t *variabl
   return kFALSE;
 }
 
+/// Sets a bin of the timing histograms
+/// \param time the time spent histogram
+/// \param calls the number of calls histogram
+/// \param bin the bin to set
+/// \param label the name of the timed unit
+/// \param elapsed the time spent, ns
+/// \param nCalls the number of calls
+static void SetTimingBin(TH1D *time, TH1D *calls, Int_t bin, const char *label, Long64_t elapsed, Long64_t nCalls) {
+  time->GetXaxis()->SetBinLabel(bin, label);
+  time->SetBinContent(bin, elapsed * 1e-9);
+  calls->GetXaxis()->SetBinLabel(bin, label);
+  calls->SetBinContent(bin, nCalls);
+}
+
+/// Provide information about the time spent by the detector configuration
+///
+/// A list with the detector configuration name is incorporated to the passed
+/// list with two histograms, one with the time spent, in seconds, and the other
+/// with the number of calls. They have a bin per timed unit: the detector
+/// configuration own ones first and then, in execution order, the processing
+/// and the data collection of each correction step.
+/// \param list list for incorporating the detector configuration timing list
+void QnCorrectionsDetectorConfigurationBase::ReportOnTiming(TList *list) const {
+  TList inputSteps;
+  TList qnVectorSteps;
+  FillOverallInputCorrectionStepList(&inputSteps);
+  FillOverallQnVectorCorrectionStepList(&qnVectorSteps);
+  TList steps;
+  steps.AddAll(&inputSteps);
+  steps.AddAll(&qnVectorSteps);
+
+  Int_t nBins = TIMING_NoOfUnits + 2 * steps.GetEntries();
+  TH1D *time = new TH1D(Form("%s_ProcessingTime", GetName()), Form("%s processing time;;time (s)", GetName()), nBins, 0.0, nBins);
+  TH1D *calls = new TH1D(Form("%s_ProcessingCalls", GetName()), Form("%s processing calls;;calls", GetName()), nBins, 0.0, nBins);
+  time->SetDirectory(NULL);
+  calls->SetDirectory(NULL);
+
+  Int_t bin = 1;
+  for (Int_t unit = 0; unit < TIMING_NoOfUnits; unit++) {
+    SetTimingBin(time, calls, bin++, szTimingUnitNames[unit], fProcessingTime[unit], fProcessingCalls[unit]);
+  }
+  for (Int_t ixStep = 0; ixStep < steps.GetEntries(); ixStep++) {
+    QnCorrectionsCorrectionStepBase *step = (QnCorrectionsCorrectionStepBase *) steps.At(ixStep);
+    SetTimingBin(time, calls, bin++, Form("%s corrections", step->GetName()),
+        step->GetProcessCorrectionsTime(), step->GetProcessCorrectionsCalls());
+    SetTimingBin(time, calls, bin++, Form("%s data collection", step->GetName()),
+        step->GetProcessDataCollectionTime(), step->GetProcessDataCollectionCalls());
+  }
+
+  TList *configurationList = new TList();
+  configurationList->SetOwner(kTRUE);
+  configurationList->SetName(GetName());
+  configurationList->Add(time);
+  configurationList->Add(calls);
+  list->Add(configurationList);
+}
@@ -18,7 +18,6 @@
 #include <TObject.h>
 #include <TList.h>
 #include <TObjArray.h>
-#include <TClonesArray.h>
 #include <TH3.h>
 #include "QnCorrectionsCutsSet.h"
 #include "QnCorrectionsCorrectionsSetOnInputData.h"
@@ -26,6 +25,8 @@
 #include "QnCorrectionsEventClassVariablesSet.h"
 #include "QnCorrectionsQnVector.h"
 #include "QnCorrectionsQnVectorBuild.h"
+#include "QnCorrectionsQnVectorValue.h"
+#include "QnCorrectionsDataVectorBank.h"
 
 class QnCorrectionsDetectorConfigurationsSet;
 class QnCorrectionsDetector;
@@ -55,6 +56,10 @@ class QnCorrectionsManager;
 ///
 /// The class is a base class for further refined detector configurations.
 ///
+/// When the framework processing is timed, the time spent and the number
+/// of calls of the Qn vectors building, of the own QA histograms filling
+/// and of the processing requests of each correction step are accumulated.
+///
 /// \author Jaap Onderwaater <jacobus.onderwaater@cern.ch>, GSI
 /// \author Ilya Selyuzhenkov <ilya.selyuzhenkov@gmail.com>, GSI
 /// \author Víctor González <victor.gonzalez@cern.ch>, UCM
@@ -62,6 +67,15 @@ class QnCorrectionsManager;
 
 class QnCorrectionsDetectorConfigurationBase : public TNamed {
 public:
+  /// \typedef QnConfigurationTimingUnit
+  /// \brief The detector configuration own processing units which are timed
+  typedef enum {
+    TIMING_rawQnVectorBuild,     ///< the raw Qn vector building
+    TIMING_qnVectorBuild,        ///< the plain Qn vector building
+    TIMING_QAHistograms,         ///< the detector configuration QA histograms filling
+    TIMING_NoOfUnits             ///< the number of timed units
+  } QnConfigurationTimingUnit;
+
   friend class QnCorrectionsCorrectionStepBase;
   friend class QnCorrectionsDetector;
   QnCorrectionsDetectorConfigurationBase();
@@ -97,7 +111,7 @@ public:
   /// Get the input data bank.
   /// Makes it available for input corrections steps.
   /// \return pointer to the input data bank
-  TClonesArray *GetInputDataBank()
+  QnCorrectionsDataVectorBank *GetInputDataBank()
   { return fDataVectorBank; }
   /// Get the event class variables set
   /// Makes it available for corrections steps
@@ -112,6 +126,7 @@ public:
   { return &fCorrectedQnVector; }
   const QnCorrectionsQnVector *GetPreviousCorrectedQnVector(QnCorrectionsCorrectionOnQvector *correctionOnQn) const;
   Bool_t IsCorrectionStepBeingApplied(const char *step) const;
+  void FillReferenceConfigurationsList(TList *list) const;
   /// Get the current Q2n vector
   /// Makes it available for subsequent correction steps.
   /// It could have already supported previous correction steps
@@ -214,6 +229,8 @@ public:
   /// The request is transmitted to the correction steps
   /// \return kTRUE if everything went OK
   virtual Bool_t ProcessDataCollection(const Float_t *variableContainer) = 0;
+  Bool_t ProcessQnVectorCorrections(const Float_t *variableContainer);
+  Bool_t ProcessQnVectorDataCollection(const Float_t *variableContainer);
   virtual void ActivateHarmonic(Int_t harmonic);
   virtual void AddCorrectionOnQnVector(QnCorrectionsCorrectionOnQvector *correctionOnQn);
   virtual void AddCorrectionOnInputData(QnCorrectionsCorrectionOnInputData *correctionOnInputData);
@@ -246,6 +263,15 @@ public:
   /// \param calib list for incorporating the list of steps in calibrating status
   /// \param apply list for incorporating the list of steps in applying status
   virtual void ReportOnCorrections(TList *steps, TList *calib, TList *apply) const = 0;
+  /// Provide information about the memory taken by the detector configuration
+  ///
+  /// Pure virtual function
+  /// \param list list for incorporating the detector configuration memory list
+  virtual void ReportOnMemory(TList *list) const = 0;
+  /// Enables disables the timing of the detector configuration processing
+  /// \param enable kTRUE for accumulating the processing time
+  void SetTimeProcessing(Bool_t enable) { fTimeProcessing = enable; }
+  void ReportOnTiming(TList *list) const;
 
   /// New data vector for the detector configuration
   /// Pure virtual function
@@ -255,34 +281,77 @@ public:
   /// \param channelId the channel Id that originates the data vector
   /// \return kTRUE if the data vector was accepted and stored
   virtual Bool_t AddDataVector(const Float_t *variableContainer, Double_t phi, Double_t weight = 1.0, Int_t channelId = -1) = 0;
+  /// New set of data vectors for the detector configuration
+  /// Pure virtual function
+  /// \param variableContainer pointer to the variable content bank
+  /// \param phi array of azimuthal angles
+  /// \param weight array of data vector weights. NULL for unit weights
+  /// \param channelId array of channel Ids that originate the data vectors. Could be NULL for track detector configurations
+  /// \param n the number of data vectors
+  /// \param stride the distance in bytes between consecutive elements. Zero for contiguous arrays
+  /// \return the number of data vectors accepted and stored
+  virtual Int_t AddDataVectors(const Float_t *variableContainer, const Float_t *phi, const Float_t *weight,
+      const Int_t *channelId, Int_t n, Int_t stride = 0) = 0;
+  /// New set of amplitudes for all the detector channels
+  /// Only supported by channelized detector configurations
+  /// \param variableContainer pointer to the variable content bank
+  /// \param amplitude array with the amplitude of each detector channel
+  /// \return the number of data vectors stored
+  virtual Int_t AddChannelsAmplitudes(const Float_t *variableContainer, const Float_t *amplitude)
+  { return 0; }
 
   virtual Bool_t IsSelected(const Float_t *variableContainer);
   virtual Bool_t IsSelected(const Float_t *variableContainer, Int_t nChannel);
+  Bool_t IsEventSelected(const Float_t *variableContainer);
 
   /// Clean the configuration to accept a new event
   /// Pure virtual function
   virtual void ClearConfiguration() = 0;
+  /// Transfers the accumulated contents to the support and QA histograms
+  /// Pure virtual function
+  virtual void FlushHistograms() = 0;
+  /// Shares the support histograms of the same detector configuration of another framework instance
+  /// Pure virtual function
+  /// \param master the detector configuration whose support histograms will be shared
+  virtual void ShareSupportHistograms(QnCorrectionsDetectorConfigurationBase *master) = 0;
 
 private:
   QnCorrectionsDetector *fDetector;    ///< pointer to the detector that owns the configuration
 protected:
   static const char *szPlainQnVectorName; ///< the name of the Qn plain, not corrected Qn vectors
+  static const char *szDataVectorBankMemoryName; ///< the name of the data vector bank memory entries
+  static const char *szTimingUnitNames[TIMING_NoOfUnits]; ///< the names of the timed units
+  Bool_t ProcessStepCorrections(QnCorrectionsCorrectionStepBase *step, const Float_t *variableContainer);
+  Bool_t ProcessStepDataCollection(QnCorrectionsCorrectionStepBase *step, const Float_t *variableContainer);
+  Long64_t StartTiming() const;
+  void StopTiming(QnConfigurationTimingUnit unit, Long64_t start);
   /// set of cuts that define the detector configuration
   QnCorrectionsManager *fCorrectionsManager; /// the framework manager pointer
   QnCorrectionsCutsSet *fCuts;         //->
 /// The default initial size of data vectors banks
 #define INITIALDATAVECTORBANKSIZE 100000
-  TClonesArray *fDataVectorBank;        //!<! input data for the current process / event
+  QnCorrectionsDataVectorBank *fDataVectorBank; //!<! input data for the current process / event
   QnCorrectionsQnVector fPlainQnVector;     ///< Qn vector from the post processed input data
   QnCorrectionsQnVector fPlainQ2nVector;     ///< Q2n vector from the post processed input data
   QnCorrectionsQnVector fCorrectedQnVector; ///< Qn vector after subsequent correction steps
   QnCorrectionsQnVector fCorrectedQ2nVector; ///< Q2n vector after subsequent correction steps
-  QnCorrectionsQnVectorBuild fTempQnVector; ///< temporary Qn vector for efficient Q vector building
-  QnCorrectionsQnVectorBuild fTempQ2nVector; ///< temporary Qn vector for efficient Q vector building
+  QnCorrectionsQnVectorValue fTempQnVector; //!<! temporary Qn vector values for efficient Q vector building
+  QnCorrectionsQnVectorValue fTempQ2nVector; //!<! temporary Q2n vector values for efficient Q vector building
   QnCorrectionsQnVector::QnVectorNormalizationMethod fQnNormalizationMethod; ///< the method for Q vector normalization
   QnCorrectionsCorrectionsSetOnQvector fQnVectorCorrections; ///< set of corrections to apply on Q vectors
   /// set of variables that define event classes
   QnCorrectionsEventClassVariablesSet    *fEventClassVariables; //->
+  /// \typedef EventSelectionStatus
+  /// \brief The status of the event level cuts for the current event
+  typedef enum {
+    kEventNotChecked=0,     ///< the event level cuts have not been evaluated yet
+    kEventSelected,         ///< the event level cuts have been passed
+    kEventRejected          ///< the event level cuts have not been passed
+  } EventSelectionStatus;
+  EventSelectionStatus fEventSelection; //!<! the event level cuts status for the current event
+  Bool_t fTimeProcessing;               //!<! kTRUE if the processing time must be accumulated
+  Long64_t fProcessingTime[TIMING_NoOfUnits];  //!<! the time spent in each timed unit, ns
+  Long64_t fProcessingCalls[TIMING_NoOfUnits]; //!<! the number of calls of each timed unit
 
 private:
   /// Copy constructor
@@ -293,8 +362,109 @@ private:
   QnCorrectionsDetectorConfigurationBase& operator= (const QnCorrectionsDetectorConfigurationBase &);
 
 /// \cond CLASSIMP
-  ClassDef(QnCorrectionsDetectorConfigurationBase, 3);
+  ClassDef(QnCorrectionsDetectorConfigurationBase, 5);
 /// \endcond
 };
 
+/// Checks if the current content of the variable bank passes the
+/// event level cuts of the detector configuration.
+///
+/// The cuts are only evaluated for the first data vector of the event
+/// and the result is kept until the configuration is cleaned for
+/// accepting a new event.
+/// \param variableContainer pointer to the variable content bank
+/// \return kTRUE if the current event passes the event level cuts
+inline Bool_t QnCorrectionsDetectorConfigurationBase::IsEventSelected(const Float_t *variableContainer) {
+  if (fEventSelection == kEventNotChecked) {
+    fEventSelection = ((fCuts == NULL) || fCuts->IsEventSelected(variableContainer)) ? kEventSelected : kEventRejected;
+  }
+  return (fEventSelection == kEventSelected);
+}
+
+/// Processes a correction step of the detector configuration
+///
+/// The time spent is accumulated by the correction step if the
+/// processing is being timed.
+/// \param step the correction step
+/// \param variableContainer pointer to the variable content bank
+/// \return the correction step processing result
+inline Bool_t QnCorrectionsDetectorConfigurationBase::ProcessStepCorrections(QnCorrectionsCorrectionStepBase *step,
+    const Float_t *variableContainer) {
+  if (fTimeProcessing)
+    return step->TimedProcessCorrections(variableContainer);
+  else
+    return step->ProcessCorrections(variableContainer);
+}
+
+/// Processes the data collection of a correction step of the detector configuration
+///
+/// The time spent is accumulated by the correction step if the
+/// processing is being timed.
+/// \param step the correction step
+/// \param variableContainer pointer to the variable content bank
+/// \return the correction step data collection result
+inline Bool_t QnCorrectionsDetectorConfigurationBase::ProcessStepDataCollection(QnCorrectionsCorrectionStepBase *step,
+    const Float_t *variableContainer) {
+  if (fTimeProcessing)
+    return step->TimedProcessDataCollection(variableContainer);
+  else
+    return step->ProcessDataCollection(variableContainer);
+}
+
+/// Gets the start time stamp of a timed unit
+/// \return the current time stamp if the processing is being timed, zero otherwise
+inline Long64_t QnCorrectionsDetectorConfigurationBase::StartTiming() const {
+  return fTimeProcessing ? QnCorrectionsCorrectionStepBase::GetTimeStamp() : 0;
+}
+
+/// Accumulates the time spent in a timed unit if the processing is being timed
+/// \param unit the timed unit
+/// \param start the time stamp got when the unit started
+inline void QnCorrectionsDetectorConfigurationBase::StopTiming(QnConfigurationTimingUnit unit, Long64_t start) {
+  if (fTimeProcessing) {
+    fProcessingTime[unit] += QnCorrectionsCorrectionStepBase::GetTimeStamp() - start;
+    fProcessingCalls[unit]++;
+  }
+}
+
+/// Ask for processing the Q vector corrections out of the current plain Qn vectors
+///
+/// Intended for replaying Q vector level passes: the plain Qn and Q2n
+/// vectors have already been restored so, neither the input data
+/// corrections nor the Qn vectors building are involved.
+/// The first not applied correction step breaks the loop and kFALSE is returned
+/// \param variableContainer pointer to the variable content bank
+/// \return kTRUE if all correction steps were applied
+inline Bool_t QnCorrectionsDetectorConfigurationBase::ProcessQnVectorCorrections(const Float_t *variableContainer) {
+  fCorrectedQnVector.Set(&fPlainQnVector, kFALSE);
+  fCorrectedQ2nVector.Set(&fPlainQ2nVector, kFALSE);
+
+  for (Int_t ixCorrection = 0; ixCorrection < fQnVectorCorrections.GetEntries(); ixCorrection++) {
+    if (ProcessStepCorrections(fQnVectorCorrections.At(ixCorrection), variableContainer))
+      continue;
+    else
+      return kFALSE;
+  }
+  /* all correction steps were applied */
+  return kTRUE;
+}
+
+/// Ask for processing the Q vector corrections data collection
+///
+/// The counterpart of ProcessQnVectorCorrections: only the Q vector
+/// correction steps are involved.
+/// The first not applied correction step breaks the loop and kFALSE is returned
+/// \param variableContainer pointer to the variable content bank
+/// \return kTRUE if all correction steps were applied
+inline Bool_t QnCorrectionsDetectorConfigurationBase::ProcessQnVectorDataCollection(const Float_t *variableContainer) {
+  for (Int_t ixCorrection = 0; ixCorrection < fQnVectorCorrections.GetEntries(); ixCorrection++) {
+    if (ProcessStepDataCollection(fQnVectorCorrections.At(ixCorrection), variableContainer))
+      continue;
+    else
+      return kFALSE;
+  }
+  /* all correction steps were applied */
+  return kTRUE;
+}
+
 #endif // QNCORRECTIONS_DETECTORCONFIGBASE_H
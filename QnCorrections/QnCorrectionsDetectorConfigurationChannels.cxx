@@ -32,7 +32,9 @@
 /// \file QnCorrectionsDetectorConfigurationChannels.cxx
 /// \brief Implementation of the channel detector configuration class 
 
+#include <THashList.h>
 #include "QnCorrectionsProfileComponents.h"
+#include "QnCorrectionsManager.h"
 #include "QnCorrectionsDetectorConfigurationChannels.h"
 #include "QnCorrectionsLog.h"
 
@@ -53,6 +55,10 @@ QnCorrectionsDetectorConfigurationChannels::QnCorrectionsDetectorConfigurationCh
   fChannelMap = NULL;
   fChannelGroup = NULL;
   fHardCodedGroupWeights = NULL;
+  fChannelPhi = NULL;
+  fNoOfDenseChannels = 0;
+  fDenseChannelId = NULL;
+  fDenseChannelPhi = NULL;
   /* QA section */
   fQACentralityVarId = -1;
   fQAnBinsMultiplicity = 100;
@@ -83,6 +89,10 @@ QnCorrectionsDetectorConfigurationChannels::QnCorrectionsDetectorConfigurationCh
   fChannelMap = NULL;
   fChannelGroup = NULL;
   fHardCodedGroupWeights = NULL;
+  fChannelPhi = NULL;
+  fNoOfDenseChannels = 0;
+  fDenseChannelId = NULL;
+  fDenseChannelPhi = NULL;
   /* QA section */
   fQACentralityVarId = -1;
   fQAnBinsMultiplicity = 100;
@@ -101,6 +111,9 @@ QnCorrectionsDetectorConfigurationChannels::~QnCorrectionsDetectorConfigurationC
   if (fChannelMap != NULL) delete [] fChannelMap;
   if (fChannelGroup != NULL) delete [] fChannelGroup;
   if (fHardCodedGroupWeights != NULL) delete [] fHardCodedGroupWeights;
+  if (fChannelPhi != NULL) delete [] fChannelPhi;
+  if (fDenseChannelId != NULL) delete [] fDenseChannelId;
+  if (fDenseChannelPhi != NULL) delete [] fDenseChannelPhi;
   if (fQAQnAverageHistogram != NULL) delete fQAQnAverageHistogram;
 }
 
@@ -163,6 +176,19 @@ void QnCorrectionsDetectorConfigurationChannels::SetChannelsScheme(
   }
 }
 
+/// Incorporates the azimuthal angle of each detector channel
+///
+/// Once incorporated the detector configuration accepts the whole
+/// array of channels amplitudes per event.
+/// \param phi array with the azimuthal angle of each channel
+void QnCorrectionsDetectorConfigurationChannels::SetChannelsPhi(const Float_t *phi) {
+  if (fChannelPhi == NULL)
+    fChannelPhi = new Float_t[fNoOfChannels];
+  for (Int_t ixChannel = 0; ixChannel < fNoOfChannels; ixChannel++) {
+    fChannelPhi[ixChannel] = phi[ixChannel];
+  }
+}
+
 /// Stores the framework manager pointer
 /// Orders the base class to store the correction manager and informs the input data corrections
 /// and the Qn vector corrections they are now attached to the framework
@@ -186,10 +212,32 @@ void QnCorrectionsDetectorConfigurationChannels::AttachCorrectionsManager(QnCorr
 ///
 /// The input data vector bank is allocated and the request is
 /// transmitted to the input data corrections and then to the Q vector corrections.
+/// The set of cuts, if any, is compiled for its fast evaluation
+/// separating the cuts on event level variables.
 void QnCorrectionsDetectorConfigurationChannels::CreateSupportDataStructures() {
 
   /* this is executed in the remote node so, allocate the data bank */
-  fDataVectorBank = new TClonesArray("QnCorrectionsDataVectorChannelized", INITIALDATAVECTORBANKSIZE);
+  fDataVectorBank = new QnCorrectionsDataVectorBank(INITIALDATAVECTORBANKSIZE);
+  /* and take the Qn vectors structure for the building values which are not cloned */
+  fTempQnVector.SetStructure(fPlainQnVector);
+  fTempQ2nVector.SetStructure(fPlainQ2nVector);
+
+  /* if the channels phi are known build the fixed used channels layout */
+  if (fChannelPhi != NULL) {
+    fNoOfDenseChannels = 0;
+    fDenseChannelId = new Int_t[fNoOfChannels];
+    fDenseChannelPhi = new Float_t[fNoOfChannels];
+    for (Int_t ixChannel = 0; ixChannel < fNoOfChannels; ixChannel++) {
+      if (fUsedChannel[ixChannel]) {
+        fDenseChannelId[fNoOfDenseChannels] = ixChannel;
+        fDenseChannelPhi[fNoOfDenseChannels] = fChannelPhi[ixChannel];
+        fNoOfDenseChannels++;
+      }
+    }
+  }
+
+  /* the cuts are already complete so, compile them */
+  if (fCuts != NULL) fCuts->Compile((fCorrectionsManager != NULL) ? fCorrectionsManager->GetEventLevelVariablesMap() : NULL);
 
   for (Int_t ixCorrection = 0; ixCorrection < fInputDataCorrections.GetEntries(); ixCorrection++) {
     fInputDataCorrections.At(ixCorrection)->CreateSupportDataStructures();
@@ -209,7 +257,7 @@ void QnCorrectionsDetectorConfigurationChannels::CreateSupportDataStructures() {
 /// \return kTRUE if everything went OK
 Bool_t QnCorrectionsDetectorConfigurationChannels::CreateSupportHistograms(TList *list) {
 
-  TList *detectorConfigurationList = new TList();
+  TList *detectorConfigurationList = new THashList(TCollection::kInitHashTableCapacity, 2);
   detectorConfigurationList->SetName(this->GetName());
   detectorConfigurationList->SetOwner(kTRUE);
   Bool_t retValue = kTRUE;
@@ -242,7 +290,7 @@ Bool_t QnCorrectionsDetectorConfigurationChannels::CreateSupportHistograms(TList
 /// \param list list where the histograms should be incorporated for its persistence
 /// \return kTRUE if everything went OK
 Bool_t QnCorrectionsDetectorConfigurationChannels::CreateQAHistograms(TList *list) {
-  TList *detectorConfigurationList = new TList();
+  TList *detectorConfigurationList = new THashList(TCollection::kInitHashTableCapacity, 2);
   detectorConfigurationList->SetName(this->GetName());
   detectorConfigurationList->SetOwner(kTRUE);
 
@@ -368,7 +416,7 @@ Bool_t QnCorrectionsDetectorConfigurationChannels::CreateQAHistograms(TList *lis
 /// \param list list where the histograms should be incorporated for its persistence
 /// \return kTRUE if everything went OK
 Bool_t QnCorrectionsDetectorConfigurationChannels::CreateNveQAHistograms(TList *list) {
-  TList *detectorConfigurationList = new TList();
+  TList *detectorConfigurationList = new THashList(TCollection::kInitHashTableCapacity, 2);
   detectorConfigurationList->SetName(this->GetName());
   detectorConfigurationList->SetOwner(kTRUE);
 
@@ -435,6 +483,39 @@ void QnCorrectionsDetectorConfigurationChannels::AfterInputsAttachActions() {
   }
 }
 
+/// Transfers the accumulated contents to the support and QA histograms
+///
+/// Transfers the order to the input data and Q vector correction steps
+/// and flushes the own QA histograms
+void QnCorrectionsDetectorConfigurationChannels::FlushHistograms() {
+  for (Int_t ixCorrection = 0; ixCorrection < fInputDataCorrections.GetEntries(); ixCorrection++) {
+    fInputDataCorrections.At(ixCorrection)->FlushHistograms();
+  }
+
+  for (Int_t ixCorrection = 0; ixCorrection < fQnVectorCorrections.GetEntries(); ixCorrection++) {
+    fQnVectorCorrections.At(ixCorrection)->FlushHistograms();
+  }
+  if (fQAQnAverageHistogram != NULL) {
+    fQAQnAverageHistogram->FlushHistograms();
+  }
+}
+
+/// Shares the support histograms of the same detector configuration of another framework instance
+///
+/// Transfers the order to the input data and Q vector correction steps pairing them
+/// with the ones of the passed detector configuration
+/// \param master the detector configuration whose support histograms will be shared
+void QnCorrectionsDetectorConfigurationChannels::ShareSupportHistograms(QnCorrectionsDetectorConfigurationBase *master) {
+  QnCorrectionsDetectorConfigurationChannels *masterConfiguration = static_cast<QnCorrectionsDetectorConfigurationChannels *>(master);
+
+  for (Int_t ixCorrection = 0; ixCorrection < fInputDataCorrections.GetEntries(); ixCorrection++) {
+    fInputDataCorrections.At(ixCorrection)->ShareSupportHistograms(masterConfiguration->fInputDataCorrections.At(ixCorrection));
+  }
+  for (Int_t ixCorrection = 0; ixCorrection < fQnVectorCorrections.GetEntries(); ixCorrection++) {
+    fQnVectorCorrections.At(ixCorrection)->ShareSupportHistograms(masterConfiguration->fQnVectorCorrections.At(ixCorrection));
+  }
+}
+
 /// Incorporates the passed correction to the set of input data corrections
 /// \param correctionOnInputData the correction to add
 void QnCorrectionsDetectorConfigurationChannels::AddCorrectionOnInputData(QnCorrectionsCorrectionOnInputData *correctionOnInputData) {
@@ -447,11 +528,12 @@ void QnCorrectionsDetectorConfigurationChannels::AddCorrectionOnInputData(QnCorr
 /// \param variableContainer pointer to the variable content bank
 void QnCorrectionsDetectorConfigurationChannels::FillQAHistograms(const Float_t *variableContainer) {
   if (fQAMultiplicityBefore3D != NULL && fQAMultiplicityAfter3D != NULL) {
-    for(Int_t ixData = 0; ixData < fDataVectorBank->GetEntriesFast(); ixData++){
-      QnCorrectionsDataVectorChannelized *dataVector =
-          static_cast<QnCorrectionsDataVectorChannelized *>(fDataVectorBank->At(ixData));
-      fQAMultiplicityBefore3D->Fill(variableContainer[fQACentralityVarId], fChannelMap[dataVector->GetId()], dataVector->Weight());
-      fQAMultiplicityAfter3D->Fill(variableContainer[fQACentralityVarId], fChannelMap[dataVector->GetId()], dataVector->EqualizedWeight());
+    const Int_t *id = fDataVectorBank->GetId();
+    const Float_t *weight = fDataVectorBank->GetWeight();
+    const Float_t *equalizedWeight = fDataVectorBank->GetEqualizedWeight();
+    for(Int_t ixData = 0; ixData < fDataVectorBank->GetEntries(); ixData++){
+      fQAMultiplicityBefore3D->Fill(variableContainer[fQACentralityVarId], fChannelMap[id[ixData]], weight[ixData]);
+      fQAMultiplicityAfter3D->Fill(variableContainer[fQACentralityVarId], fChannelMap[id[ixData]], equalizedWeight[ixData]);
     }
   }
   if (fQAQnAverageHistogram != NULL) {
@@ -568,3 +650,33 @@ void QnCorrectionsDetectorConfigurationChannels::ReportOnCorrections(TList *step
   apply->Add(myapply);
 }
 
+/// Provide information about the memory taken by the detector configuration
+///
+/// A list with the detector configuration name is incorporated to the
+/// passed list. It gets the memory taken by the data vector bank and the
+/// own QA histograms, and then the one taken by the input data corrections
+/// and the Q vector corrections.
+/// \param list list for incorporating the detector configuration memory list
+void QnCorrectionsDetectorConfigurationChannels::ReportOnMemory(TList *list) const {
+  TList *mymemory = new TList();
+  mymemory->SetOwner(kTRUE);
+  mymemory->SetName(GetName());
+
+  /* the own structures */
+  if (fDataVectorBank != NULL)
+    QnCorrectionsCorrectionStepBase::AddMemoryUsage(mymemory, szDataVectorBankMemoryName, fDataVectorBank->GetMemorySize());
+  QnCorrectionsCorrectionStepBase::AddMemoryUsage(mymemory, QnCorrectionsCorrectionStepBase::szQAHistogramsMemoryName,
+      QnCorrectionsHistogramBase::GetStorageSize(fQAMultiplicityBefore3D) + QnCorrectionsHistogramBase::GetStorageSize(fQAMultiplicityAfter3D));
+  QnCorrectionsCorrectionStepBase::AddMemoryUsage(mymemory, QnCorrectionsCorrectionStepBase::szQAHistogramsMemoryName, fQAQnAverageHistogram);
+
+  /* first the input data corrections */
+  for (Int_t ixCorrection = 0; ixCorrection < fInputDataCorrections.GetEntries(); ixCorrection++) {
+    fInputDataCorrections.At(ixCorrection)->ReportOnMemory(mymemory);
+  }
+  /* now the Qn vector corrections */
+  for (Int_t ixCorrection = 0; ixCorrection < fQnVectorCorrections.GetEntries(); ixCorrection++) {
+    fQnVectorCorrections.At(ixCorrection)->ReportOnMemory(mymemory);
+  }
+  list->Add(mymemory);
+}
+
@@ -16,8 +16,8 @@
 ///
 
 #include "QnCorrectionsCorrectionsSetOnInputData.h"
-#include "QnCorrectionsDataVectorChannelized.h"
 #include "QnCorrectionsDetectorConfigurationBase.h"
+#include "QnCorrectionsLog.h"
 
 class QnCorrectionsProfileComponents;
 
@@ -31,6 +31,11 @@ class QnCorrectionsProfileComponents;
 /// According to that, the proper channelized data vector is used and an extra
 /// Q vector builder is incorporated.
 ///
+/// If the azimuthal angle of each channel is provided, the detector
+/// configuration also accepts, per event, the whole array of channels
+/// amplitudes. The data vectors bank is then filled at once from the fixed
+/// used channels layout, avoiding the per channel incorporation.
+///
 /// \author Jaap Onderwaater <jacobus.onderwaater@cern.ch>, GSI
 /// \author Ilya Selyuzhenkov <ilya.selyuzhenkov@gmail.com>, GSI
 /// \author Víctor González <victor.gonzalez@cern.ch>, UCM
@@ -68,6 +73,7 @@ public:
 
 
   void SetChannelsScheme(Bool_t *bUsedChannel, Int_t *nChannelGroup, Float_t *hardCodedGroupWeights = NULL);
+  void SetChannelsPhi(const Float_t *phi);
 
   /* QA section */
   /// Sets the variable id used for centrality in QA histograms.
@@ -100,6 +106,9 @@ public:
   virtual void AddCorrectionOnInputData(QnCorrectionsCorrectionOnInputData *correctionOnInputData);
 
   virtual Bool_t AddDataVector(const Float_t *variableContainer, Double_t phi, Double_t weight, Int_t channelId);
+  virtual Int_t AddDataVectors(const Float_t *variableContainer, const Float_t *phi, const Float_t *weight,
+      const Int_t *channelId, Int_t n, Int_t stride = 0);
+  virtual Int_t AddChannelsAmplitudes(const Float_t *variableContainer, const Float_t *amplitude);
 
   virtual void BuildQnVector();
   void BuildRawQnVector();
@@ -107,19 +116,24 @@ public:
   virtual void FillOverallInputCorrectionStepList(TList *list) const;
   virtual void FillOverallQnVectorCorrectionStepList(TList *list) const;
   virtual void ReportOnCorrections(TList *steps, TList *calib, TList *apply) const;
+  virtual void ReportOnMemory(TList *list) const;
 
   /// Checks if the current content of the variable bank applies to
-  /// the detector configuration for the passed channel.
+  /// the detector configuration for the passed channel. The event
+  /// level cuts are only evaluated once per event.
   /// \param variableContainer pointer to the variable content bank
   /// \param nChannel the interested external channel number
   /// \return kTRUE if the current content applies to the configuration
   virtual Bool_t IsSelected(const Float_t *variableContainer, Int_t nChannel)
-    { return ((fUsedChannel[nChannel]) ? ((fCuts != NULL) ? fCuts->IsSelected(variableContainer) : kTRUE) : kFALSE); }
+    { return (IsEventSelected(variableContainer) && fUsedChannel[nChannel] &&
+        ((fCuts != NULL) ? fCuts->IsDataVectorSelected(variableContainer) : kTRUE)); }
   /// wrong call for this class invoke base class behavior
   virtual Bool_t IsSelected(const Float_t *variableContainer)
   { return QnCorrectionsDetectorConfigurationBase::IsSelected(variableContainer); }
 
   virtual void ClearConfiguration();
+  virtual void FlushHistograms();
+  virtual void ShareSupportHistograms(QnCorrectionsDetectorConfigurationBase *master);
 
 private:
   static const char *szRawQnVectorName;   ///< the name of the raw Qn vector from raw data without input data corrections
@@ -133,6 +147,11 @@ private:
   Int_t *fChannelGroup;                   //[fNoOfChannels]
   /// array, group hard coded weight
   Float_t *fHardCodedGroupWeights;         //[fNoOfChannels]
+  /// array, the azimuthal angle of each channel
+  Float_t *fChannelPhi;                    //[fNoOfChannels]
+  Int_t fNoOfDenseChannels;                //!<! the number of used channels in the fixed channels layout
+  Int_t *fDenseChannelId;                  //!<! array, the used channels ids in the fixed channels layout
+  Float_t *fDenseChannelPhi;               //!<! array, the used channels azimuthal angles in the fixed channels layout
   QnCorrectionsCorrectionsSetOnInputData fInputDataCorrections; ///< set of corrections to apply on input data vectors
 
   /* QA section */
@@ -156,15 +175,17 @@ private:
   QnCorrectionsDetectorConfigurationChannels& operator= (const QnCorrectionsDetectorConfigurationChannels &);
 
 /// \cond CLASSIMP
-  ClassDef(QnCorrectionsDetectorConfigurationChannels, 2);
+  ClassDef(QnCorrectionsDetectorConfigurationChannels, 3);
 /// \endcond
 };
 
 /// New data vector for the detector configuration.
-/// A check is made to match the channel Id with the ones assigned
-/// to the detector configuration and then an additional one to
-/// see if the current variable bank content passes
-/// the associated cuts. If so, the data vector is stored.
+/// A check is made to see if the current event passes the event level
+/// cuts, only evaluated for the first data vector of the event, then
+/// to match the channel Id with the ones assigned to the detector
+/// configuration and then an additional one to see if the current
+/// variable bank content passes the remaining associated cuts. If so,
+/// the data vector is stored.
 /// \param variableContainer pointer to the variable content bank
 /// \param phi azimuthal angle
 /// \param weight the weight of the data vector. Ignored for track detector configurations.
@@ -174,13 +195,75 @@ inline Bool_t QnCorrectionsDetectorConfigurationChannels::AddDataVector(
     const Float_t *variableContainer, Double_t phi, Double_t weight, Int_t channelId) {
   if (IsSelected(variableContainer, channelId)) {
     /// add the data vector to the bank
-    new (fDataVectorBank->ConstructedAt(fDataVectorBank->GetEntriesFast()))
-      QnCorrectionsDataVectorChannelized(channelId, phi, weight);
+    fDataVectorBank->AddDataVector(channelId, phi, weight);
     return kTRUE;
   }
   return kFALSE;
 }
 
+/// New set of data vectors for the detector configuration.
+/// The associated cuts are checked only once with the current variable
+/// bank content so, the whole set shares the same variable values. If
+/// they are passed, each data vector is stored if its channel Id is
+/// one of the ones assigned to the detector configuration. Channel Ids
+/// out of the detector channels range are discarded.
+/// \param variableContainer pointer to the variable content bank
+/// \param phi array of azimuthal angles
+/// \param weight array of data vector weights. NULL for unit weights
+/// \param channelId array of channel Ids that originate the data vectors. Mandatory
+/// \param n the number of data vectors
+/// \param stride the distance in bytes between consecutive elements. Zero for contiguous arrays
+/// \return the number of data vectors accepted and stored
+inline Int_t QnCorrectionsDetectorConfigurationChannels::AddDataVectors(const Float_t *variableContainer,
+    const Float_t *phi, const Float_t *weight, const Int_t *channelId, Int_t n, Int_t stride) {
+  if (channelId == NULL) {
+    QnCorrectionsError(Form("Detector configuration %s requires the channel Id of each data vector. FIX IT, PLEASE.", GetName()));
+    return 0;
+  }
+  if (!IsEventSelected(variableContainer)) return 0;
+  if ((fCuts != NULL) && !fCuts->IsDataVectorSelected(variableContainer)) return 0;
+
+  Int_t idStride = (stride != 0) ? stride : sizeof(Int_t);
+  Int_t valueStride = (stride != 0) ? stride : sizeof(Float_t);
+  const char *pId = reinterpret_cast<const char *>(channelId);
+  const char *pPhi = reinterpret_cast<const char *>(phi);
+  const char *pWeight = reinterpret_cast<const char *>(weight);
+  Int_t nAccepted = 0;
+
+  for (Int_t ixData = 0; ixData < n; ixData++) {
+    Int_t id = *reinterpret_cast<const Int_t *>(pId + ixData * idStride);
+    if ((0 <= id) && (id < fNoOfChannels) && fUsedChannel[id]) {
+      fDataVectorBank->AddDataVector(id,
+          *reinterpret_cast<const Float_t *>(pPhi + ixData * valueStride),
+          (pWeight != NULL) ? *reinterpret_cast<const Float_t *>(pWeight + ixData * valueStride) : 1.0);
+      nAccepted++;
+    }
+  }
+  return nAccepted;
+}
+
+/// New set of amplitudes for all the detector channels.
+/// The associated cuts are checked only once with the current variable
+/// bank content. If they are passed the data vector bank is filled at once
+/// with the amplitudes of the used channels, their azimuthal angles
+/// being the ones of the fixed channels layout. The channels phi must
+/// have been provided, otherwise an error is raised and no data vector is stored.
+/// \param variableContainer pointer to the variable content bank
+/// \param amplitude array with the amplitude of each detector channel
+/// \return the number of data vectors stored
+inline Int_t QnCorrectionsDetectorConfigurationChannels::AddChannelsAmplitudes(const Float_t *variableContainer,
+    const Float_t *amplitude) {
+  if (fDenseChannelPhi == NULL) {
+    QnCorrectionsError(Form("Detector configuration %s has not the channels phi. Use SetChannelsPhi or AddDataVector. FIX IT, PLEASE.", GetName()));
+    return 0;
+  }
+  if (!IsEventSelected(variableContainer)) return 0;
+  if ((fCuts != NULL) && !fCuts->IsDataVectorSelected(variableContainer)) return 0;
+
+  fDataVectorBank->SetChannelsDataVectors(fDenseChannelId, fDenseChannelPhi, amplitude, fNoOfDenseChannels);
+  return fNoOfDenseChannels;
+}
+
 /// Builds raw Qn vector before Q vector corrections and before input
 /// data corrections but considering the chosen calibration method.
 /// This is a channelized configuration so this Q vector will NOT be
@@ -188,13 +271,10 @@ inline Bool_t QnCorrectionsDetectorConfigurationChannels::AddDataVector(
 inline void QnCorrectionsDetectorConfigurationChannels::BuildRawQnVector() {
   fTempQnVector.Reset();
 
-  for(Int_t ixData = 0; ixData < fDataVectorBank->GetEntriesFast(); ixData++){
-    QnCorrectionsDataVectorChannelized *dataVector = static_cast<QnCorrectionsDataVectorChannelized *>(fDataVectorBank->At(ixData));
-    fTempQnVector.Add(dataVector->Phi(), dataVector->Weight());
-  }
+  fTempQnVector.Add(fDataVectorBank->GetPhi(), fDataVectorBank->GetWeight(), fDataVectorBank->GetEntries());
   fTempQnVector.CheckQuality();
   fTempQnVector.Normalize(fQnNormalizationMethod);
-  fRawQnVector.Set(&fTempQnVector, kFALSE);
+  fRawQnVector.Set(fTempQnVector);
 }
 
 /// Builds Qn vector before Q vector corrections and after input corrections
@@ -205,19 +285,16 @@ inline void QnCorrectionsDetectorConfigurationChannels::BuildQnVector() {
   fTempQnVector.Reset();
   fTempQ2nVector.Reset();
 
-  for(Int_t ixData = 0; ixData < fDataVectorBank->GetEntriesFast(); ixData++){
-    QnCorrectionsDataVectorChannelized *dataVector = static_cast<QnCorrectionsDataVectorChannelized *>(fDataVectorBank->At(ixData));
-    fTempQnVector.Add(dataVector->Phi(), dataVector->EqualizedWeight());
-    fTempQ2nVector.Add(dataVector->Phi(), dataVector->EqualizedWeight());
-  }
+  fTempQnVector.Add(fDataVectorBank->GetPhi(), fDataVectorBank->GetEqualizedWeight(), fDataVectorBank->GetEntries());
+  fTempQ2nVector.Add(fDataVectorBank->GetPhi(), fDataVectorBank->GetEqualizedWeight(), fDataVectorBank->GetEntries());
   fTempQnVector.CheckQuality();
   fTempQ2nVector.CheckQuality();
   fTempQnVector.Normalize(fQnNormalizationMethod);
   fTempQ2nVector.Normalize(fQnNormalizationMethod);
-  fPlainQnVector.Set(&fTempQnVector, kFALSE);
-  fPlainQ2nVector.Set(&fTempQ2nVector, kFALSE);
-  fCorrectedQnVector.Set(&fTempQnVector, kFALSE);
-  fCorrectedQ2nVector.Set(&fTempQ2nVector, kFALSE);
+  fPlainQnVector.Set(fTempQnVector);
+  fPlainQ2nVector.Set(fTempQ2nVector);
+  fCorrectedQnVector.Set(fTempQnVector);
+  fCorrectedQ2nVector.Set(fTempQ2nVector);
 }
 
 
@@ -230,22 +307,26 @@ inline void QnCorrectionsDetectorConfigurationChannels::BuildQnVector() {
 inline Bool_t QnCorrectionsDetectorConfigurationChannels::ProcessCorrections(const Float_t *variableContainer) {
 
   /* first we build the raw Q vector with the chosen calibration */
+  Long64_t start = StartTiming();
   BuildRawQnVector();
+  StopTiming(TIMING_rawQnVectorBuild, start);
 
   /* then we transfer the request to the input data correction steps */
   for (Int_t ixCorrection = 0; ixCorrection < fInputDataCorrections.GetEntries(); ixCorrection++) {
-    if (fInputDataCorrections.At(ixCorrection)->ProcessCorrections(variableContainer))
+    if (ProcessStepCorrections(fInputDataCorrections.At(ixCorrection), variableContainer))
       continue;
     else
       return kFALSE;
   }
 
   /* input corrections were applied so let's build the Q vector with the chosen calibration */
+  start = StartTiming();
   BuildQnVector();
+  StopTiming(TIMING_qnVectorBuild, start);
 
   /* now let's propagate it to Q vector corrections */
   for (Int_t ixCorrection = 0; ixCorrection < fQnVectorCorrections.GetEntries(); ixCorrection++) {
-    if (fQnVectorCorrections.At(ixCorrection)->ProcessCorrections(variableContainer))
+    if (ProcessStepCorrections(fQnVectorCorrections.At(ixCorrection), variableContainer))
       continue;
     else
       return kFALSE;
@@ -264,18 +345,20 @@ inline Bool_t QnCorrectionsDetectorConfigurationChannels::ProcessDataCollection(
 
   /* we transfer the request to the input data correction steps */
   for (Int_t ixCorrection = 0; ixCorrection < fInputDataCorrections.GetEntries(); ixCorrection++) {
-    if (fInputDataCorrections.At(ixCorrection)->ProcessDataCollection(variableContainer))
+    if (ProcessStepDataCollection(fInputDataCorrections.At(ixCorrection), variableContainer))
       continue;
     else
       return kFALSE;
   }
 
   /* check whether QA histograms must be filled */
+  Long64_t start = StartTiming();
   FillQAHistograms(variableContainer);
+  StopTiming(TIMING_QAHistograms, start);
 
   /* now let's propagate it to Q vector corrections */
   for (Int_t ixCorrection = 0; ixCorrection < fQnVectorCorrections.GetEntries(); ixCorrection++) {
-    if (fQnVectorCorrections.At(ixCorrection)->ProcessDataCollection(variableContainer))
+    if (ProcessStepDataCollection(fQnVectorCorrections.At(ixCorrection), variableContainer))
       continue;
     else
       return kFALSE;
@@ -306,8 +389,10 @@ inline void QnCorrectionsDetectorConfigurationChannels::ClearConfiguration() {
   fPlainQ2nVector.Reset();
   fCorrectedQnVector.Reset();
   fCorrectedQ2nVector.Reset();
+  /* the event level cuts will be evaluated again */
+  fEventSelection = kEventNotChecked;
   /* and now clear the the input data bank */
-  fDataVectorBank->Clear("C");
+  fDataVectorBank->Clear();
 }
 
 #endif // QNCORRECTIONS_DETECTORCONFCHANNEL_H
@@ -32,7 +32,9 @@
 /// \file QnCorrectionsDetectorConfigurationTracks.cxx
 /// \brief Implementation of the track detector configuration class
 
+#include <THashList.h>
 #include "QnCorrectionsProfileComponents.h"
+#include "QnCorrectionsManager.h"
 #include "QnCorrectionsDetectorConfigurationTracks.h"
 #include "QnCorrectionsLog.h"
 
@@ -89,10 +91,18 @@ void QnCorrectionsDetectorConfigurationTracks::AttachCorrectionsManager(QnCorrec
 ///
 /// The input data vector bank is allocated and the request is
 /// transmitted to the Q vector corrections.
+/// The set of cuts, if any, is compiled for its fast evaluation
+/// separating the cuts on event level variables.
 void QnCorrectionsDetectorConfigurationTracks::CreateSupportDataStructures() {
 
   /* this is executed in the remote node so, allocate the data bank */
-  fDataVectorBank = new TClonesArray("QnCorrectionsDataVector", INITIALDATAVECTORBANKSIZE);
+  fDataVectorBank = new QnCorrectionsDataVectorBank(INITIALDATAVECTORBANKSIZE);
+  /* and take the Qn vectors structure for the building values which are not cloned */
+  fTempQnVector.SetStructure(fPlainQnVector);
+  fTempQ2nVector.SetStructure(fPlainQ2nVector);
+
+  /* the cuts are already complete so, compile them */
+  if (fCuts != NULL) fCuts->Compile((fCorrectionsManager != NULL) ? fCorrectionsManager->GetEventLevelVariablesMap() : NULL);
 
   for (Int_t ixCorrection = 0; ixCorrection < fQnVectorCorrections.GetEntries(); ixCorrection++) {
     fQnVectorCorrections.At(ixCorrection)->CreateSupportDataStructures();
@@ -109,7 +119,7 @@ void QnCorrectionsDetectorConfigurationTracks::CreateSupportDataStructures() {
 /// \return kTRUE if everything went OK
 Bool_t QnCorrectionsDetectorConfigurationTracks::CreateSupportHistograms(TList *list) {
   Bool_t retValue = kTRUE;
-  TList *detectorConfigurationList = new TList();
+  TList *detectorConfigurationList = new THashList(TCollection::kInitHashTableCapacity, 2);
   detectorConfigurationList->SetName(this->GetName());
   detectorConfigurationList->SetOwner(kTRUE);
   for (Int_t ixCorrection = 0; ixCorrection < fQnVectorCorrections.GetEntries(); ixCorrection++) {
@@ -135,7 +145,7 @@ Bool_t QnCorrectionsDetectorConfigurationTracks::CreateSupportHistograms(TList *
 /// \return kTRUE if everything went OK
 Bool_t QnCorrectionsDetectorConfigurationTracks::CreateQAHistograms(TList *list) {
   Bool_t retValue = kTRUE;
-  TList *detectorConfigurationList = new TList();
+  TList *detectorConfigurationList = new THashList(TCollection::kInitHashTableCapacity, 2);
   detectorConfigurationList->SetName(this->GetName());
   detectorConfigurationList->SetOwner(kTRUE);
 
@@ -175,7 +185,7 @@ Bool_t QnCorrectionsDetectorConfigurationTracks::CreateQAHistograms(TList *list)
 /// \return kTRUE if everything went OK
 Bool_t QnCorrectionsDetectorConfigurationTracks::CreateNveQAHistograms(TList *list) {
   Bool_t retValue = kTRUE;
-  TList *detectorConfigurationList = new TList();
+  TList *detectorConfigurationList = new THashList(TCollection::kInitHashTableCapacity, 2);
   detectorConfigurationList->SetName(this->GetName());
   detectorConfigurationList->SetOwner(kTRUE);
   for (Int_t ixCorrection = 0; ixCorrection < fQnVectorCorrections.GetEntries(); ixCorrection++) {
@@ -223,6 +233,33 @@ void QnCorrectionsDetectorConfigurationTracks::AfterInputsAttachActions() {
   }
 }
 
+/// Transfers the accumulated contents to the support and QA histograms
+///
+/// Transfers the order to the Q vector correction steps and flushes
+/// the own QA histograms
+void QnCorrectionsDetectorConfigurationTracks::FlushHistograms() {
+
+  for (Int_t ixCorrection = 0; ixCorrection < fQnVectorCorrections.GetEntries(); ixCorrection++) {
+    fQnVectorCorrections.At(ixCorrection)->FlushHistograms();
+  }
+  if (fQAQnAverageHistogram != NULL) {
+    fQAQnAverageHistogram->FlushHistograms();
+  }
+}
+
+/// Shares the support histograms of the same detector configuration of another framework instance
+///
+/// Transfers the order to the Q vector correction steps pairing them
+/// with the ones of the passed detector configuration
+/// \param master the detector configuration whose support histograms will be shared
+void QnCorrectionsDetectorConfigurationTracks::ShareSupportHistograms(QnCorrectionsDetectorConfigurationBase *master) {
+  QnCorrectionsDetectorConfigurationTracks *masterConfiguration = static_cast<QnCorrectionsDetectorConfigurationTracks *>(master);
+
+  for (Int_t ixCorrection = 0; ixCorrection < fQnVectorCorrections.GetEntries(); ixCorrection++) {
+    fQnVectorCorrections.At(ixCorrection)->ShareSupportHistograms(masterConfiguration->fQnVectorCorrections.At(ixCorrection));
+  }
+}
+
 /// Fills the QA plain Qn vector average components histogram
 /// \param variableContainer pointer to the variable content bank
 void QnCorrectionsDetectorConfigurationTracks::FillQAHistograms(const Float_t *variableContainer) {
@@ -328,3 +365,26 @@ void QnCorrectionsDetectorConfigurationTracks::ReportOnCorrections(TList *steps,
   apply->Add(myapply);
 }
 
+/// Provide information about the memory taken by the detector configuration
+///
+/// A list with the detector configuration name is incorporated to the
+/// passed list. It gets the memory taken by the data vector bank and the
+/// own QA histograms, and then the one taken by the Q vector corrections.
+/// \param list list for incorporating the detector configuration memory list
+void QnCorrectionsDetectorConfigurationTracks::ReportOnMemory(TList *list) const {
+  TList *mymemory = new TList();
+  mymemory->SetOwner(kTRUE);
+  mymemory->SetName(GetName());
+
+  /* the own structures */
+  if (fDataVectorBank != NULL)
+    QnCorrectionsCorrectionStepBase::AddMemoryUsage(mymemory, szDataVectorBankMemoryName, fDataVectorBank->GetMemorySize());
+  QnCorrectionsCorrectionStepBase::AddMemoryUsage(mymemory, QnCorrectionsCorrectionStepBase::szQAHistogramsMemoryName, fQAQnAverageHistogram);
+
+  /* the Qn vector corrections */
+  for (Int_t ixCorrection = 0; ixCorrection < fQnVectorCorrections.GetEntries(); ixCorrection++) {
+    fQnVectorCorrections.At(ixCorrection)->ReportOnMemory(mymemory);
+  }
+  list->Add(mymemory);
+}
+
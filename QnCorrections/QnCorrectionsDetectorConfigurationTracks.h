@@ -15,7 +15,6 @@
 /// \brief Track detector configuration class for Q vector correction framework
 ///
 
-#include "QnCorrectionsDataVector.h"
 #include "QnCorrectionsDetectorConfigurationBase.h"
 
 class QnCorrectionsProfileComponents;
@@ -62,24 +61,30 @@ public:
   virtual Bool_t ProcessCorrections(const Float_t *variableContainer);
   virtual Bool_t ProcessDataCollection(const Float_t *variableContainer);
   virtual Bool_t AddDataVector(const Float_t *variableContainer, Double_t phi, Double_t weight = 1.0, Int_t channelId = -1);
+  virtual Int_t AddDataVectors(const Float_t *variableContainer, const Float_t *phi, const Float_t *weight,
+      const Int_t *channelId, Int_t n, Int_t stride = 0);
 
   virtual void BuildQnVector();
   virtual void IncludeQnVectors(TList *list);
   virtual void FillOverallInputCorrectionStepList(TList *list) const;
   virtual void FillOverallQnVectorCorrectionStepList(TList *list) const;
   virtual void ReportOnCorrections(TList *steps, TList *calib, TList *apply) const;
+  virtual void ReportOnMemory(TList *list) const;
 
   /// Checks if the current content of the variable bank applies to
-  /// the detector configuration
+  /// the detector configuration. The event level cuts are only
+  /// evaluated once per event.
   /// \param variableContainer pointer to the variable content bank
   /// \return kTRUE if the current content applies to the configuration
   virtual Bool_t IsSelected(const Float_t *variableContainer)
-    { return ((fCuts != NULL) ? fCuts->IsSelected(variableContainer) : kTRUE); }
+    { return (IsEventSelected(variableContainer) && ((fCuts != NULL) ? fCuts->IsDataVectorSelected(variableContainer) : kTRUE)); }
   /// wrong call for this class invoke base class behavior
   virtual Bool_t IsSelected(const Float_t *variableContainer, Int_t nChannel)
   { return QnCorrectionsDetectorConfigurationBase::IsSelected(variableContainer,nChannel); }
 
   virtual void ClearConfiguration();
+  virtual void FlushHistograms();
+  virtual void ShareSupportHistograms(QnCorrectionsDetectorConfigurationBase *master);
 
 private:
   /* QA section */
@@ -104,13 +109,39 @@ inline Bool_t QnCorrectionsDetectorConfigurationTracks::AddDataVector(
     const Float_t *variableContainer, Double_t phi, Double_t weight, Int_t id) {
   if (IsSelected(variableContainer)) {
     /// add the data vector to the bank
-    new (fDataVectorBank->ConstructedAt(fDataVectorBank->GetEntriesFast()))
-        QnCorrectionsDataVector(id, phi, weight);
+    fDataVectorBank->AddDataVector(id, phi, weight);
     return kTRUE;
   }
   return kFALSE;
 }
 
+/// New set of data vectors for the detector configuration.
+/// The associated cuts are checked only once with the current variable
+/// bank content so, the whole set shares the same variable values. If
+/// they are passed, the data vectors are stored.
+///
+/// The data vector level cuts, e.g. on the track charge, are evaluated
+/// as well only once so, they are not applied to each element of the set.
+/// Only sets of data vectors sharing the values of the variables involved
+/// in those cuts, e.g. tracks grouped by charge, must be passed. Otherwise
+/// the data vectors must be passed one by one with AddDataVector.
+/// \param variableContainer pointer to the variable content bank
+/// \param phi array of azimuthal angles
+/// \param weight array of weights. NULL for the usual track detector unit weights
+/// \param channelId array of Ids associated to the data vectors. Could represent the tracks id. Could be NULL
+/// \param n the number of data vectors
+/// \param stride the distance in bytes between consecutive elements. Zero for contiguous arrays
+/// \return the number of data vectors accepted and stored
+inline Int_t QnCorrectionsDetectorConfigurationTracks::AddDataVectors(const Float_t *variableContainer,
+    const Float_t *phi, const Float_t *weight, const Int_t *channelId, Int_t n, Int_t stride) {
+  if (IsSelected(variableContainer)) {
+    /// add the data vectors to the bank
+    fDataVectorBank->AddDataVectors(channelId, phi, weight, n, stride);
+    return n;
+  }
+  return 0;
+}
+
 /// Clean the configuration to accept a new event
 ///
 /// Transfers the order to the Q vector correction steps and
@@ -126,8 +157,10 @@ inline void QnCorrectionsDetectorConfigurationTracks::ClearConfiguration() {
   fPlainQ2nVector.Reset();
   fCorrectedQnVector.Reset();
   fCorrectedQ2nVector.Reset();
+  /* the event level cuts will be evaluated again */
+  fEventSelection = kEventNotChecked;
   /* and now clear the the input data bank */
-  fDataVectorBank->Clear("C");
+  fDataVectorBank->Clear();
 }
 
 /// Builds Qn vectors before Q vector corrections but
@@ -139,20 +172,17 @@ inline void QnCorrectionsDetectorConfigurationTracks::BuildQnVector() {
   fTempQnVector.Reset();
   fTempQ2nVector.Reset();
 
-  for(Int_t ixData = 0; ixData < fDataVectorBank->GetEntriesFast(); ixData++){
-    QnCorrectionsDataVector *dataVector = static_cast<QnCorrectionsDataVector *>(fDataVectorBank->At(ixData));
-    fTempQnVector.Add(dataVector->Phi(), dataVector->Weight());
-    fTempQ2nVector.Add(dataVector->Phi(), dataVector->Weight());
-  }
+  fTempQnVector.Add(fDataVectorBank->GetPhi(), fDataVectorBank->GetWeight(), fDataVectorBank->GetEntries());
+  fTempQ2nVector.Add(fDataVectorBank->GetPhi(), fDataVectorBank->GetWeight(), fDataVectorBank->GetEntries());
   /* check the quality of the Qn vector */
   fTempQnVector.CheckQuality();
   fTempQ2nVector.CheckQuality();
   fTempQnVector.Normalize(fQnNormalizationMethod);
   fTempQ2nVector.Normalize(fQnNormalizationMethod);
-  fPlainQnVector.Set(&fTempQnVector, kFALSE);
-  fPlainQ2nVector.Set(&fTempQ2nVector, kFALSE);
-  fCorrectedQnVector.Set(&fTempQnVector, kFALSE);
-  fCorrectedQ2nVector.Set(&fTempQ2nVector, kFALSE);
+  fPlainQnVector.Set(fTempQnVector);
+  fPlainQ2nVector.Set(fTempQ2nVector);
+  fCorrectedQnVector.Set(fTempQnVector);
+  fCorrectedQ2nVector.Set(fTempQ2nVector);
 }
 
 
@@ -163,12 +193,14 @@ inline void QnCorrectionsDetectorConfigurationTracks::BuildQnVector() {
 /// \return kTRUE if all correction steps were applied
 inline Bool_t QnCorrectionsDetectorConfigurationTracks::ProcessCorrections(const Float_t *variableContainer) {
   /* first we build the Q vector with the chosen calibration */
+  Long64_t start = StartTiming();
   BuildQnVector();
+  StopTiming(TIMING_qnVectorBuild, start);
 
   /* then we transfer the request to the Q vector correction steps */
   /* the loop is broken when a correction step has not been applied */
   for (Int_t ixCorrection = 0; ixCorrection < fQnVectorCorrections.GetEntries(); ixCorrection++) {
-    if (fQnVectorCorrections.At(ixCorrection)->ProcessCorrections(variableContainer))
+    if (ProcessStepCorrections(fQnVectorCorrections.At(ixCorrection), variableContainer))
       continue;
     else
       return kFALSE;
@@ -185,12 +217,14 @@ inline Bool_t QnCorrectionsDetectorConfigurationTracks::ProcessCorrections(const
 inline Bool_t QnCorrectionsDetectorConfigurationTracks::ProcessDataCollection(const Float_t *variableContainer) {
 
   /* fill QA information */
+  Long64_t start = StartTiming();
   FillQAHistograms(variableContainer);
+  StopTiming(TIMING_QAHistograms, start);
 
   /* we transfer the request to the Q vector correction steps */
   /* the loop is broken when a correction step has not been applied */
   for (Int_t ixCorrection = 0; ixCorrection < fQnVectorCorrections.GetEntries(); ixCorrection++) {
-    if (fQnVectorCorrections.At(ixCorrection)->ProcessDataCollection(variableContainer))
+    if (ProcessStepDataCollection(fQnVectorCorrections.At(ixCorrection), variableContainer))
       continue;
     else
       return kFALSE;
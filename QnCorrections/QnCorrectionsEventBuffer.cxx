@@ -0,0 +1,217 @@
+/**************************************************************************************************
+ *                                                                                                *
+ * Package:       FlowVectorCorrections                                                           *
+ * Authors:       Jaap Onderwaater, GSI, jacobus.onderwaater@cern.ch                              *
+ *                Ilya Selyuzhenkov, GSI, ilya.selyuzhenkov@gmail.com                             *
+ *                Víctor González, UCM, victor.gonzalez@cern.ch                                   *
+ *                Contributors are mentioned in the code where appropriate.                       *
+ * Development:   2012-2016                                                                       *
+ *                                                                                                *
+ * This file is part of FlowVectorCorrections, a software package that corrects Q-vector          *
+ * measurements for effects of nonuniform detector acceptance. The corrections in this package    *
+ * are based on publication:                                                                      *
+ *                                                                                                *
+ *  [1] "Effects of non-uniform acceptance in anisotropic flow measurements"                      *
+ *  Ilya Selyuzhenkov and Sergei Voloshin                                                         *
+ *  Phys. Rev. C 77, 034904 (2008)                                                                *
+ *                                                                                                *
+ * The procedure proposed in [1] is extended with the following steps:                            *
+ * (*) alignment correction between subevents                                                     *
+ * (*) possibility to extract the twist and rescaling corrections                                 *
+ *      for the case of three detector subevents                                                  *
+ *      (currently limited to the case of two “hit-only” and one “tracking” detectors)            *
+ * (*) (optional) channel equalization                                                            *
+ * (*) flow vector width equalization                                                             *
+ *                                                                                                *
+ * FlowVectorCorrections is distributed under the terms of the GNU General Public License (GPL)   *
+ * (https://en.wikipedia.org/wiki/GNU_General_Public_License)                                     *
+ * either version 3 of the License, or (at your option) any later version.                        *
+ *                                                                                                *
+ **************************************************************************************************/
+
+/// \file QnCorrectionsEventBuffer.cxx
+/// \brief Implementation of the packed buffer of events input
+
+#include <string.h>
+#include "QnCorrectionsDetectorConfigurationBase.h"
+#include "QnCorrectionsEventBuffer.h"
+
+/// \cond CLASSIMP
+ClassImp(QnCorrectionsEventBuffer);
+/// \endcond
+
+/// Default constructor
+QnCorrectionsEventBuffer::QnCorrectionsEventBuffer() : TObject() {
+  fNoOfVariables = 0;
+  fVariableId = NULL;
+  fNoOfConfigurations = 0;
+  fNoOfEvents = 0;
+  fFirstDataVector = NULL;
+  fNoOfValues = 0;
+  fValues = NULL;
+  fNoOfBlocks = 0;
+  fNoOfDataVectors = NULL;
+  fNoOfStoredDataVectors = 0;
+  fId = NULL;
+  fPhi = NULL;
+  fWeight = NULL;
+  fEventsSize = 0;
+  fValuesSize = 0;
+  fBlocksSize = 0;
+  fDataVectorsSize = 0;
+}
+
+/// Default destructor
+/// Releases the memory taken
+QnCorrectionsEventBuffer::~QnCorrectionsEventBuffer() {
+  delete [] fVariableId;
+  delete [] fFirstDataVector;
+  delete [] fValues;
+  delete [] fNoOfDataVectors;
+  delete [] fId;
+  delete [] fPhi;
+  delete [] fWeight;
+}
+
+/// Establishes what will be stored for each event
+///
+/// The variables flagged in the passed map will be stored and
+/// the data vectors of the given number of detector configurations.
+/// The current content, if any, is discarded.
+/// \param variablesMap flags, addressed by var Id, for the variables to store
+/// \param nVariables the size of the variables map
+/// \param nConfigurations the number of detector configurations
+void QnCorrectionsEventBuffer::SetLayout(const Bool_t *variablesMap, Int_t nVariables, Int_t nConfigurations) {
+  Clear();
+
+  delete [] fVariableId;
+  fNoOfVariables = 0;
+  for (Int_t ixVariable = 0; ixVariable < nVariables; ixVariable++) {
+    if (variablesMap[ixVariable]) fNoOfVariables++;
+  }
+  fVariableId = new Int_t[fNoOfVariables];
+  fNoOfVariables = 0;
+  for (Int_t ixVariable = 0; ixVariable < nVariables; ixVariable++) {
+    if (variablesMap[ixVariable]) fVariableId[fNoOfVariables++] = ixVariable;
+  }
+  fNoOfConfigurations = nConfigurations;
+}
+
+/// Discards the buffered events
+///
+/// The allocated storage is kept for further events.
+/// \param option not used
+void QnCorrectionsEventBuffer::Clear(Option_t *option) {
+  fNoOfEvents = 0;
+  fNoOfValues = 0;
+  fNoOfBlocks = 0;
+  fNoOfStoredDataVectors = 0;
+}
+
+/// Stores the current event
+///
+/// The values of the layout variables are taken from the variables
+/// bank and the data vectors from the data banks of the detector
+/// configurations.
+/// \param variableContainer pointer to the variable content bank
+/// \param configurations the detector configurations, in the layout order
+void QnCorrectionsEventBuffer::AddEvent(const Float_t *variableContainer, const TObjArray *configurations) {
+  /* the allocated sizes are not persistent: a buffer read back from a file */
+  /* has its columns sized to its content and zero allocated sizes */
+  if (fEventsSize <= fNoOfEvents) {
+    Int_t newSize = (fNoOfEvents < 32) ? 64 : 2 * fNoOfEvents;
+    fFirstDataVector = GrowArray(fFirstDataVector, fNoOfEvents, newSize);
+    fEventsSize = newSize;
+  }
+  if (fValuesSize < fNoOfValues + fNoOfVariables) {
+    Int_t newSize = ((fNoOfValues + fNoOfVariables) < 2 * fValuesSize) ? 2 * fValuesSize : 64 * fNoOfVariables + fNoOfValues;
+    fValues = GrowArray(fValues, fNoOfValues, newSize);
+    fValuesSize = newSize;
+  }
+  if (fBlocksSize < fNoOfBlocks + fNoOfConfigurations) {
+    Int_t newSize = ((fNoOfBlocks + fNoOfConfigurations) < 2 * fBlocksSize) ? 2 * fBlocksSize : 64 * fNoOfConfigurations + fNoOfBlocks;
+    fNoOfDataVectors = GrowArray(fNoOfDataVectors, fNoOfBlocks, newSize);
+    fBlocksSize = newSize;
+  }
+
+  fFirstDataVector[fNoOfEvents] = fNoOfStoredDataVectors;
+  for (Int_t ixVariable = 0; ixVariable < fNoOfVariables; ixVariable++) {
+    fValues[fNoOfValues++] = variableContainer[fVariableId[ixVariable]];
+  }
+  for (Int_t ixConfiguration = 0; ixConfiguration < fNoOfConfigurations; ixConfiguration++) {
+    QnCorrectionsDataVectorBank *bank =
+        ((QnCorrectionsDetectorConfigurationBase *) configurations->At(ixConfiguration))->GetInputDataBank();
+    Int_t n = bank->GetEntries();
+
+    if (fDataVectorsSize < fNoOfStoredDataVectors + n) {
+      Int_t newSize = ((fNoOfStoredDataVectors + n) < 2 * fDataVectorsSize) ? 2 * fDataVectorsSize : 2 * (fNoOfStoredDataVectors + n);
+      fId = GrowArray(fId, fNoOfStoredDataVectors, newSize);
+      fPhi = GrowArray(fPhi, fNoOfStoredDataVectors, newSize);
+      fWeight = GrowArray(fWeight, fNoOfStoredDataVectors, newSize);
+      fDataVectorsSize = newSize;
+    }
+    memcpy(fId + fNoOfStoredDataVectors, bank->GetId(), n * sizeof(Int_t));
+    memcpy(fPhi + fNoOfStoredDataVectors, bank->GetPhi(), n * sizeof(Float_t));
+    memcpy(fWeight + fNoOfStoredDataVectors, bank->GetWeight(), n * sizeof(Float_t));
+    fNoOfStoredDataVectors += n;
+    fNoOfDataVectors[fNoOfBlocks++] = n;
+  }
+  fNoOfEvents++;
+}
+
+/// Restores a buffered event
+///
+/// The layout variables are stored in the variables bank and the
+/// data vectors are added to the data banks of the detector
+/// configurations which should have been cleared before.
+/// \param ixEvent the buffered event number
+/// \param variableContainer pointer to the variable content bank
+/// \param configurations the detector configurations, in the layout order
+void QnCorrectionsEventBuffer::GetEvent(Int_t ixEvent, Float_t *variableContainer, const TObjArray *configurations) const {
+  const Float_t *values = fValues + ixEvent * fNoOfVariables;
+  const Int_t *noOfDataVectors = fNoOfDataVectors + ixEvent * fNoOfConfigurations;
+  Int_t first = fFirstDataVector[ixEvent];
+
+  for (Int_t ixVariable = 0; ixVariable < fNoOfVariables; ixVariable++) {
+    variableContainer[fVariableId[ixVariable]] = values[ixVariable];
+  }
+  for (Int_t ixConfiguration = 0; ixConfiguration < fNoOfConfigurations; ixConfiguration++) {
+    Int_t n = noOfDataVectors[ixConfiguration];
+
+    if (n != 0) {
+      ((QnCorrectionsDetectorConfigurationBase *) configurations->At(ixConfiguration))->GetInputDataBank()->AddDataVectors(
+          fId + first, fPhi + first, fWeight + first, n);
+      first += n;
+    }
+  }
+}
+
+/// Enlarges an integer column keeping its current content
+/// \param array the column
+/// \param nUsed the number of elements in use
+/// \param newSize the new number of elements the column can hold
+/// \return the enlarged column
+Int_t *QnCorrectionsEventBuffer::GrowArray(Int_t *array, Int_t nUsed, Int_t newSize) {
+  Int_t *newArray = new Int_t[newSize];
+
+  if (nUsed != 0) {
+    memcpy(newArray, array, nUsed * sizeof(Int_t));
+  }
+  delete [] array;
+  return newArray;
+}
+
+/// Enlarges a float column keeping its current content
+/// \param array the column
+/// \param nUsed the number of elements in use
+/// \param newSize the new number of elements the column can hold
+/// \return the enlarged column
+Float_t *QnCorrectionsEventBuffer::GrowArray(Float_t *array, Int_t nUsed, Int_t newSize) {
+  Float_t *newArray = new Float_t[newSize];
+
+  if (nUsed != 0) {
+    memcpy(newArray, array, nUsed * sizeof(Float_t));
+  }
+  delete [] array;
+  return newArray;
+}
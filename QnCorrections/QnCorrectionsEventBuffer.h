@@ -0,0 +1,101 @@
+#ifndef QNCORRECTIONS_EVENTBUFFER_H
+#define QNCORRECTIONS_EVENTBUFFER_H
+
+/***************************************************************************
+ * Package:       FlowVectorCorrections                                    *
+ * Authors:       Jaap Onderwaater, GSI, jacobus.onderwaater@cern.ch       *
+ *                Ilya Selyuzhenkov, GSI, ilya.selyuzhenkov@gmail.com      *
+ *                Víctor González, UCM, victor.gonzalez@cern.ch            *
+ *                Contributors are mentioned in the code where appropriate.*
+ * Development:   2012-2016                                                *
+ * See cxx source for GPL licence et. al.                                  *
+ ***************************************************************************/
+
+/// \file QnCorrectionsEventBuffer.h
+/// \brief Packed buffer of events input for the Q vector correction framework
+
+#include <TObject.h>
+#include <TObjArray.h>
+
+/// \class QnCorrectionsEventBuffer
+/// \brief Packed storage of the framework input of a set of events
+///
+/// Keeps, event by event, what the framework needs to process
+/// an event again: the values of the event level variables and,
+/// for each detector configuration, the data vectors it accepted.
+/// The data vectors are stored once the detector configurations
+/// cuts have been applied so, when an event is restored, they
+/// go directly to the detector configurations data banks.
+///
+/// The content is kept in a few packed columns: the variables
+/// values, the number of data vectors of each detector configuration
+/// and the data vectors channel Id, azimuthal angle and raw weight.
+/// The columns grow as needed. The buffer is a regular persistent
+/// object so it can be stored in a local file and read back to
+/// process again the same events.
+///
+/// The detector configurations are addressed by their position
+/// within the passed array so, the buffer can only be restored
+/// on a framework with the same detector configurations set.
+///
+/// \author Jaap Onderwaater <jacobus.onderwaater@cern.ch>, GSI
+/// \author Ilya Selyuzhenkov <ilya.selyuzhenkov@gmail.com>, GSI
+/// \author Víctor González <victor.gonzalez@cern.ch>, UCM
+/// \date Oct 16, 2026
+
+class QnCorrectionsEventBuffer : public TObject {
+public:
+  QnCorrectionsEventBuffer();
+  virtual ~QnCorrectionsEventBuffer();
+
+  void SetLayout(const Bool_t *variablesMap, Int_t nVariables, Int_t nConfigurations);
+  virtual void Clear(Option_t *option = "");
+
+  /// Gets the number of buffered events
+  /// \return the number of events
+  Int_t GetEntries() const { return fNoOfEvents; }
+  /// Gets the number of variables stored per event
+  /// \return the number of variables
+  Int_t GetNoOfVariables() const { return fNoOfVariables; }
+  /// Gets the number of detector configurations stored per event
+  /// \return the number of detector configurations
+  Int_t GetNoOfConfigurations() const { return fNoOfConfigurations; }
+
+  void AddEvent(const Float_t *variableContainer, const TObjArray *configurations);
+  void GetEvent(Int_t ixEvent, Float_t *variableContainer, const TObjArray *configurations) const;
+
+private:
+  static Int_t *GrowArray(Int_t *array, Int_t nUsed, Int_t newSize);
+  static Float_t *GrowArray(Float_t *array, Int_t nUsed, Int_t newSize);
+
+  Int_t fNoOfVariables;                ///< the number of variables stored per event
+  Int_t *fVariableId;                  //[fNoOfVariables]
+  Int_t fNoOfConfigurations;           ///< the number of detector configurations stored per event
+  Int_t fNoOfEvents;                   ///< the number of buffered events
+  Int_t *fFirstDataVector;             //[fNoOfEvents]
+  Int_t fNoOfValues;                   ///< the number of stored variables values
+  Float_t *fValues;                    //[fNoOfValues]
+  Int_t fNoOfBlocks;                   ///< the number of stored detector configurations blocks
+  Int_t *fNoOfDataVectors;             //[fNoOfBlocks]
+  Int_t fNoOfStoredDataVectors;        ///< the number of stored data vectors
+  Int_t *fId;                          //[fNoOfStoredDataVectors]
+  Float_t *fPhi;                       //[fNoOfStoredDataVectors]
+  Float_t *fWeight;                    //[fNoOfStoredDataVectors]
+  Int_t fEventsSize;                   //!<! the allocated size of the events column
+  Int_t fValuesSize;                   //!<! the allocated size of the variables values column
+  Int_t fBlocksSize;                   //!<! the allocated size of the blocks column
+  Int_t fDataVectorsSize;              //!<! the allocated size of the data vectors columns
+
+  /// Copy constructor
+  /// Not allowed. Forced private.
+  QnCorrectionsEventBuffer(const QnCorrectionsEventBuffer &);
+  /// Assignment operator
+  /// Not allowed. Forced private.
+  QnCorrectionsEventBuffer& operator= (const QnCorrectionsEventBuffer &);
+
+/// \cond CLASSIMP
+  ClassDef(QnCorrectionsEventBuffer, 1);
+/// \endcond
+};
+
+#endif // QNCORRECTIONS_EVENTBUFFER_H
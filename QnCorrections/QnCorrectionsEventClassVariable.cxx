@@ -45,6 +45,8 @@ fVarId(-1),
 fNBins(0),
 fNBinsPlusOne(0),
 fBins(NULL),
+fLastValue(0.0),
+fLastBin(-1),
 fLabel("") {
 
 }
@@ -56,6 +58,8 @@ fVarId(ecv.fVarId),
 fNBins(ecv.fNBins),
 fNBinsPlusOne(ecv.fNBinsPlusOne),
 fBins(NULL),
+fLastValue(0.0),
+fLastBin(-1),
 fLabel(ecv.fLabel) {
 
   fBins = new Double_t[ecv.fNBins + 1];
@@ -79,6 +83,8 @@ fVarId(varId),
 fNBins(nbins),
 fNBinsPlusOne(nbins+1),
 fBins(NULL),
+fLastValue(0.0),
+fLastBin(-1),
 fLabel(varname) {
 
   fBins = new Double_t[fNBins + 1];
@@ -105,6 +111,8 @@ fVarId(varId),
 fNBins(nbins),
 fNBinsPlusOne(nbins+1),
 fBins(NULL),
+fLastValue(0.0),
+fLastBin(-1),
 fLabel(varname) {
 
   fBins = new Double_t[fNBins + 1];
@@ -132,6 +140,8 @@ fVarId(varId),
 fNBins(0),
 fNBinsPlusOne(0),
 fBins(NULL),
+fLastValue(0.0),
+fLastBin(-1),
 fLabel(varname) {
 
   for(Int_t section = 1; section < (Int_t) binArray[0][1]; section++)
@@ -28,6 +28,7 @@
 
 #include <TObject.h>
 #include <TObjArray.h>
+#include <TMath.h>
 
 
 class QnCorrectionsEventClassVariable : public TObject {
@@ -60,12 +61,16 @@ class QnCorrectionsEventClassVariable : public TObject {
   /// Gets the highest variabel value considered
   Double_t        GetUpperEdge() {return fBins[fNBins]; }
 
+  Int_t           FindBin(Double_t value);
+
  private:
   Int_t         fVarId;        ///< The external Id for the variable in the data bank
   Int_t         fNBins;        ///< The number of bins for the variable when shown in a histogram
   Int_t         fNBinsPlusOne; ///< the number of bins plus one. Needed for object persistence
   /// Bin edges array for the variable when shown in a histogram
   Double_t     *fBins;         //[fNBinsPlusOne]
+  Double_t      fLastValue;    //!<! the last value a bin was searched for
+  Int_t         fLastBin;      //!<! the bin found for the last value, -1 if none
   TString       fLabel;        ///< Label to use in an axis that shows the variable
 
  private:
@@ -77,4 +82,27 @@ class QnCorrectionsEventClassVariable : public TObject {
 /// \endcond
 };
 
+/// Finds the bin number for the passed variable value
+///
+/// Follows the TAxis::FindFixBin conventions so, the result matches the
+/// bin of a histogram axis built with the variable binning: zero for
+/// underflow and number of bins plus one for overflow.
+///
+/// The found bin is kept so that, within an event, the many histograms
+/// built on the variable search it only once.
+/// \param value the variable value
+/// \return the bin number
+inline Int_t QnCorrectionsEventClassVariable::FindBin(Double_t value) {
+  if ((fLastBin < 0) || (value != fLastValue)) {
+    if (value < fBins[0])
+      fLastBin = 0;
+    else if (!(value < fBins[fNBins]))
+      fLastBin = fNBins + 1;
+    else
+      fLastBin = 1 + TMath::BinarySearch(fNBinsPlusOne, fBins, value);
+    fLastValue = value;
+  }
+  return fLastBin;
+}
+
 #endif /* QNCORRECTIONS_EVENTCLASSVAR_H */
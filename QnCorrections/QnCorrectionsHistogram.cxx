@@ -67,7 +67,7 @@ Bool_t QnCorrectionsHistogram::CreateHistogram(TList *histogramList) {
   fEventClassVariables.GetMultidimensionalConfiguration(nbins,minvals,maxvals);
 
   /* create the values multidimensional histogram */
-  fValues = new THnF((const char *) histoName, (const char *) histoTitle,nVariables,nbins,minvals,maxvals);
+  fValues = CreateStorage((const char *) histoName, (const char *) histoTitle,nVariables,nbins,minvals,maxvals,kTRUE);
 
   /* now let's set the proper binning and label on each axis */
   for (Int_t var = 0; var < nVariables; var++) {
@@ -78,6 +78,7 @@ Bool_t QnCorrectionsHistogram::CreateHistogram(TList *histogramList) {
   fValues->Sumw2();
 
   histogramList->Add(fValues);
+  fStorageList = histogramList;
 
   delete [] minvals;
   delete [] maxvals;
@@ -97,7 +98,7 @@ Long64_t QnCorrectionsHistogram::GetBin(const Float_t *variableContainer) {
 
   FillBinAxesValues(variableContainer);
   /* store the channel number */
-  return fValues->GetBin(fBinAxesValues);
+  return FindBin(fValues);
 }
 
 /// Check the validity of the content of the passed bin
@@ -148,8 +149,9 @@ void QnCorrectionsHistogram::Fill(const Float_t *variableContainer, Float_t weig
 
   FillBinAxesValues(variableContainer);
   /* and now update the bin */
-  fValues->Fill(fBinAxesValues, weight);
+  fValues->FillBin(FindBin(fValues), weight);
   fValues->SetEntries(nEntries + 1);
+  fValues = UpdateStorage(fValues);
 }
 
 
@@ -1,7 +1,15 @@
 /// \file QnCorrectionsHistogramBase.cxx
 /// \brief Implementation of the multidimensional profile base class
 
+#include <atomic>
 #include "TList.h"
+#include "THnSparse.h"
+#include "TH1.h"
+#include "TArrayC.h"
+#include "TArrayS.h"
+#include "TArrayI.h"
+#include "TArrayF.h"
+#include "TArrayD.h"
 
 #include "QnCorrectionsEventClassVariablesSet.h"
 #include "QnCorrectionsHistogramBase.h"
@@ -27,6 +35,29 @@ const UInt_t QnCorrectionsHistogramBase::correlationYXmask = 0x0004;
 const UInt_t QnCorrectionsHistogramBase::correlationYYmask = 0x0008;
 const Int_t QnCorrectionsHistogramBase::nDefaultMinNoOfEntriesValidated = 2;
 
+/// The number of stripes of the shared bins locks
+static const Int_t nSharedBinLockStripes = 1024;
+/// A shared bins lock on its own cache line
+struct QnCorrectionsSharedBinLock {
+  alignas(64) std::atomic<Int_t> fLocked; ///< non zero while the lock is taken
+};
+/// The shared bins locks
+static QnCorrectionsSharedBinLock sharedBinLocks[nSharedBinLockStripes];
+
+/// The memory taken by a dense storage bin, content and squared weights
+static const Int_t nDenseStorageBinSize = sizeof(Float_t) + sizeof(Double_t);
+/// The approximate memory taken by a filled sparse storage bin beyond its
+/// content and squared weights: compacted coordinates and hash table entry
+static const Int_t nSparseStorageBinOverhead = 28;
+/// The approximate memory taken by a filled sparse storage bin
+static const Int_t nSparseStorageBinSize = nDenseStorageBinSize + nSparseStorageBinOverhead;
+/// The storages memory budget, zero if no storage selection is configured
+static Long64_t storageMemoryBudget = 0;
+/// The expected bins occupancy for the storage selection
+static Float_t storageExpectedOccupancy = 0.0;
+/// The memory already taken by the dense storages created within the budget
+static std::atomic<Long64_t> denseStorageMemoryInUse(0);
+
 /// \cond CLASSIMP
 ClassImp(QnCorrectionsHistogramBase);
 /// \endcond
@@ -35,7 +66,12 @@ ClassImp(QnCorrectionsHistogramBase);
 QnCorrectionsHistogramBase::QnCorrectionsHistogramBase() :
   TNamed(),
   fEventClassVariables(),
-  fBinAxesValues(NULL) {
+  fBinAxesValues(NULL),
+  fBinAxesIndexes(NULL),
+  fEventClassAxesMatch(kTRUE),
+  fStorageList(NULL),
+  fDenseStorageThreshold(-1),
+  fDenseStorageMemory(0) {
 
   fErrorMode = kERRORMEAN;
   fMinNoOfEntriesToValidate = nDefaultMinNoOfEntriesValidated;
@@ -43,10 +79,14 @@ QnCorrectionsHistogramBase::QnCorrectionsHistogramBase() :
 
 /// Default destructor
 ///
-/// restores the taken memory for the bin axes values bank
+/// restores the taken memory for the bin axes values bank and
+/// releases the dense storage memory reserved within the budget
 QnCorrectionsHistogramBase::~QnCorrectionsHistogramBase() {
   if (fBinAxesValues != NULL)
     delete [] fBinAxesValues;
+  if (fBinAxesIndexes != NULL)
+    delete [] fBinAxesIndexes;
+  ReleaseDenseStorageMemory();
 }
 
 /// Normal constructor
@@ -73,10 +113,16 @@ QnCorrectionsHistogramBase::QnCorrectionsHistogramBase(const char *name,
     Option_t *option) :
   TNamed(name, title),
   fEventClassVariables(ecvs),
-  fBinAxesValues(NULL) {
+  fBinAxesValues(NULL),
+  fBinAxesIndexes(NULL),
+  fEventClassAxesMatch(kTRUE),
+  fStorageList(NULL),
+  fDenseStorageThreshold(-1),
+  fDenseStorageMemory(0) {
 
   /* one place more for storing the channel number by inherited classes */
   fBinAxesValues = new Double_t[fEventClassVariables.GetEntries() + 1];
+  fBinAxesIndexes = new Int_t[fEventClassVariables.GetEntries() + 1];
 
   TString opt = option;
   opt.ToLower();
@@ -85,6 +131,31 @@ QnCorrectionsHistogramBase::QnCorrectionsHistogramBase(const char *name,
   fMinNoOfEntriesToValidate = nDefaultMinNoOfEntriesValidated;
 }
 
+/// Checks the event class axes of an attached histogram against the event class variables binning
+///
+/// The result is stored to decide how the bin numbers will be located.
+/// \param histogram the attached histogram
+/// \return kTRUE if the event class axes match the variables binning
+Bool_t QnCorrectionsHistogramBase::CheckEventClassAxes(THnBase *histogram) {
+  fEventClassAxesMatch = kTRUE;
+  for (Int_t var = 0; var < fEventClassVariables.GetEntriesFast(); var++) {
+    TAxis *axis = histogram->GetAxis(var);
+    QnCorrectionsEventClassVariable *variable = fEventClassVariables.At(var);
+    if (axis->GetNbins() != variable->GetNBins()) {
+      fEventClassAxesMatch = kFALSE;
+      break;
+    }
+    for (Int_t bin = 1; bin < variable->GetNBins() + 1; bin++) {
+      if ((axis->GetBinLowEdge(bin) != variable->GetBinLowerEdge(bin)) ||
+          (axis->GetBinUpEdge(bin) != variable->GetBinUpperEdge(bin))) {
+        fEventClassAxesMatch = kFALSE;
+        break;
+      }
+    }
+  }
+  return fEventClassAxesMatch;
+}
+
 /// Attaches existing histograms as the supporting histograms
 ///
 /// Interface declaration function.
@@ -904,3 +975,198 @@ void QnCorrectionsHistogramBase::CopyTHnFDimension(THnF *hDest, THnF *hSource, I
   }
 }
 
+/// Takes the lock of a bin of a shared storage
+///
+/// The bins of the different shared storages are distributed among
+/// a fixed set of locks. Consecutive bins get consecutive locks so
+/// that neighbour event classes do not collide. The lock is held
+/// just for updating the bin so it is acquired by spinning.
+/// \param storage the shared storage
+/// \param bin the bin to lock
+void QnCorrectionsHistogramBase::LockSharedBin(const void *storage, Long64_t bin) {
+  std::atomic<Int_t> &lock =
+      sharedBinLocks[(reinterpret_cast<ULong64_t>(storage) / 64 + bin) % nSharedBinLockStripes].fLocked;
+  while (lock.exchange(1, std::memory_order_acquire) != 0) {
+    while (lock.load(std::memory_order_relaxed) != 0) {}
+  }
+}
+
+/// Releases the lock of a bin of a shared storage
+/// \param storage the shared storage
+/// \param bin the bin to unlock
+void QnCorrectionsHistogramBase::UnlockSharedBin(const void *storage, Long64_t bin) {
+  sharedBinLocks[(reinterpret_cast<ULong64_t>(storage) / 64 + bin) % nSharedBinLockStripes].fLocked.store(0, std::memory_order_release);
+}
+
+/// Prepares a histogram for being shared
+///
+/// The histogram bins storage is allocated on its first update. That
+/// is forced here so that concurrent fills find it already in place.
+/// \param histogram the histogram to share
+void QnCorrectionsHistogramBase::PrepareSharedHistogram(THnBase *histogram) {
+  histogram->AddBinContent(0, 0.0);
+  if (histogram->GetCalculateErrors()) histogram->AddBinError2(0, 0.0);
+}
+
+/// Configures the bins storage selection for the histograms created from now on
+///
+/// The memory budget is shared by all the dense storages created within
+/// the process, the ones created as dense and the ones switched from
+/// sparse. A storage is created dense if the expected bins occupancy
+/// is above the point where dense storage takes less memory than sparse
+/// storage, and its size fits in the remaining budget. The memory taken
+/// by the dense storages still in use keeps being accounted.
+/// \param memoryBudget the memory budget in bytes, zero to disable the selection
+/// \param expectedOccupancy the expected fraction of filled bins
+void QnCorrectionsHistogramBase::SetStorageSelection(Long64_t memoryBudget, Float_t expectedOccupancy) {
+  storageMemoryBudget = memoryBudget;
+  storageExpectedOccupancy = expectedOccupancy;
+}
+
+/// Reserves memory for a dense storage within the budget
+/// \param size the memory needed by the dense storage
+/// \return kTRUE if the memory fits in the remaining budget
+static Bool_t ReserveDenseStorageMemory(Long64_t size) {
+  Long64_t inUse = denseStorageMemoryInUse.load();
+  do {
+    if (storageMemoryBudget < inUse + size) return kFALSE;
+  } while (!denseStorageMemoryInUse.compare_exchange_weak(inUse, inUse + size));
+  return kTRUE;
+}
+
+/// Releases the dense storage memory reserved within the budget
+///
+/// To be called once the bins storage is not in use anymore.
+void QnCorrectionsHistogramBase::ReleaseDenseStorageMemory() {
+  if (fDenseStorageMemory != 0) {
+    denseStorageMemoryInUse -= fDenseStorageMemory;
+    fDenseStorageMemory = 0;
+  }
+}
+
+/// Creates the bins storage for a histogram
+///
+/// If no storage selection is configured the storage is created as
+/// requested. Otherwise it is created dense if the expected occupancy
+/// makes it worth and it fits in the memory budget, and sparse if not.
+/// For a sparse storage whose dense version fits in the budget, the
+/// number of filled bins for switching to dense storage is fixed.
+///
+/// The storage is not added to any list, the caller should do it and
+/// keep the list in fStorageList so that the storage can be replaced.
+/// \param name the name of the storage
+/// \param title the title of the storage
+/// \param nDimensions the number of dimensions
+/// \param nbins the number of bins of each dimension
+/// \param minvals the lower edge of each dimension
+/// \param maxvals the upper edge of each dimension
+/// \param bDense kTRUE for dense storage if no storage selection is configured
+/// \return the new bins storage
+THnBase *QnCorrectionsHistogramBase::CreateStorage(const char *name, const char *title,
+    Int_t nDimensions, const Int_t *nbins, const Double_t *minvals, const Double_t *maxvals, Bool_t bDense) {
+
+  fDenseStorageThreshold = -1;
+  if (storageMemoryBudget > 0) {
+    /* the dense storage includes the underflow and overflow bins */
+    Long64_t nTotalBins = 1;
+    for (Int_t dim = 0; dim < nDimensions; dim++) {
+      nTotalBins *= nbins[dim] + 2;
+    }
+    Long64_t denseSize = nTotalBins * nDenseStorageBinSize;
+    Float_t breakEvenOccupancy = Float_t(nDenseStorageBinSize) / nSparseStorageBinSize;
+
+    bDense = (breakEvenOccupancy <= storageExpectedOccupancy) && ReserveDenseStorageMemory(denseSize);
+    if (bDense) fDenseStorageMemory += denseSize;
+    if (!bDense && (denseSize <= storageMemoryBudget)) {
+      fDenseStorageThreshold = TMath::Max(Long64_t(1), Long64_t(nTotalBins * breakEvenOccupancy));
+    }
+  }
+
+  if (bDense)
+    return new THnF(name, title, nDimensions, nbins, minvals, maxvals);
+  else
+    return new THnSparseF(name, title, nDimensions, nbins, minvals, maxvals);
+}
+
+/// Switches a sparse bins storage to a dense one
+///
+/// If the dense storage does not fit in the remaining memory budget
+/// the sparse storage is kept and no further switch is attempted.
+/// Otherwise the dense storage is built with the sparse storage axes
+/// and content and replaces it, at the same position, in the list which
+/// owns it.
+/// \param storage the sparse bins storage
+/// \return the bins storage to use from now on
+THnBase *QnCorrectionsHistogramBase::SwitchToDenseStorage(THnBase *storage) {
+
+  fDenseStorageThreshold = -1;
+
+  Long64_t nTotalBins = 1;
+  for (Int_t dim = 0; dim < storage->GetNdimensions(); dim++) {
+    nTotalBins *= storage->GetAxis(dim)->GetNbins() + 2;
+  }
+  if (!ReserveDenseStorageMemory(nTotalBins * nDenseStorageBinSize))
+    return storage;
+  fDenseStorageMemory += nTotalBins * nDenseStorageBinSize;
+
+  THnBase *dense = THn::CreateHn(storage->GetName(), storage->GetTitle(), storage);
+  if (fStorageList != NULL) {
+    /* keep the list order, the framework instances lists are merged position by position */
+    Int_t index = fStorageList->IndexOf(storage);
+    if (index < 0) {
+      fStorageList->Add(dense);
+    }
+    else {
+      fStorageList->RemoveAt(index);
+      fStorageList->AddAt(dense, index);
+    }
+  }
+  delete storage;
+  return dense;
+}
+
+/// Gets the memory taken by a multidimensional histogram
+///
+/// For a dense histogram all its bins, including underflow and
+/// overflow, are considered. For a sparse histogram only its filled
+/// bins, including the compacted coordinates and the hash table entry.
+/// \param storage the multidimensional histogram
+/// \return the memory in bytes, zero for a NULL histogram
+Long64_t QnCorrectionsHistogramBase::GetStorageSize(const THnBase *storage) {
+  if (storage == NULL) return 0;
+
+  Int_t elementSize = sizeof(Double_t);
+  if ((dynamic_cast<const THnF *>(storage) != NULL) || (dynamic_cast<const THnSparseF *>(storage) != NULL))
+    elementSize = sizeof(Float_t);
+  else if ((dynamic_cast<const THnI *>(storage) != NULL) || (dynamic_cast<const THnSparseI *>(storage) != NULL))
+    elementSize = sizeof(Int_t);
+  else if ((dynamic_cast<const THnC *>(storage) != NULL) || (dynamic_cast<const THnSparseC *>(storage) != NULL))
+    elementSize = sizeof(Char_t);
+
+  Long64_t binSize = elementSize + (storage->GetCalculateErrors() ? sizeof(Double_t) : 0);
+  if (dynamic_cast<const THnSparse *>(storage) != NULL)
+    binSize += nSparseStorageBinOverhead;
+  return storage->GetNbins() * binSize;
+}
+
+/// Gets the memory taken by a histogram
+///
+/// All its bins, including underflow and overflow, are considered
+/// as well as the squared weights if they are kept.
+/// \param histogram the histogram
+/// \return the memory in bytes, zero for a NULL histogram
+Long64_t QnCorrectionsHistogramBase::GetStorageSize(const TH1 *histogram) {
+  if (histogram == NULL) return 0;
+
+  Int_t elementSize = sizeof(Double_t);
+  if (dynamic_cast<const TArrayF *>(histogram) != NULL)
+    elementSize = sizeof(Float_t);
+  else if (dynamic_cast<const TArrayI *>(histogram) != NULL)
+    elementSize = sizeof(Int_t);
+  else if (dynamic_cast<const TArrayS *>(histogram) != NULL)
+    elementSize = sizeof(Short_t);
+  else if (dynamic_cast<const TArrayC *>(histogram) != NULL)
+    elementSize = sizeof(Char_t);
+
+  return Long64_t(histogram->GetNcells()) * elementSize + Long64_t(histogram->GetSumw2N()) * sizeof(Double_t);
+}
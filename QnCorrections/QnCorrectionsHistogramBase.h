@@ -7,6 +7,8 @@
 #include <THn.h>
 #include "QnCorrectionsEventClassVariablesSet.h"
 
+class TH1;
+
 /// \class QnCorrectionsHistogramBase
 /// \brief Base class for the Q vector correction histograms
 ///
@@ -28,6 +30,22 @@
 /// The encapsulated bin axes values provide an efficient
 /// runtime storage for computing bin numbers.
 ///
+/// Support histograms created for filling can be shared by several
+/// framework instances, i.e. the workers, which then accumulate their
+/// bin contents into the ones of a single instance. Concurrent updates
+/// of the same bin are serialized with a striped set of bin locks while
+/// each instance keeps its own entries bookkeeping.
+///
+/// The bins storage of the histogram classes can be selected at
+/// creation time according to a memory budget shared by the whole
+/// process and the expected bins occupancy. Once the selection is
+/// configured, a storage is created dense only if the expected
+/// occupancy makes it worth and it fits in the remaining budget,
+/// otherwise it is created sparse. A sparse storage is switched to
+/// a dense one, within the budget, when its occupancy reaches the
+/// point where the dense storage takes less memory. With no
+/// selection configured each histogram class keeps its own storage.
+///
 /// Provides the interface for the whole set of histogram
 /// classes providing error information that helps debugging.
 ///
@@ -107,18 +125,43 @@ public:
   virtual void FillYX(Int_t harmonic, const Float_t *variableContainer, Float_t weight);
   virtual void FillYY(Int_t harmonic, const Float_t *variableContainer, Float_t weight);
 
+  static void SetStorageSelection(Long64_t memoryBudget, Float_t expectedOccupancy);
+
+  /// Gets the memory taken by the histograms storage
+  /// Default behavior: no storage
+  /// \return the memory in bytes
+  virtual Long64_t GetMemorySize() const { return 0; }
+  static Long64_t GetStorageSize(const THnBase *storage);
+  static Long64_t GetStorageSize(const TH1 *histogram);
+
 protected:
+  THnBase *CreateStorage(const char *name, const char *title,
+      Int_t nDimensions, const Int_t *nbins, const Double_t *minvals, const Double_t *maxvals, Bool_t bDense);
+  THnBase *UpdateStorage(THnBase *storage);
+  THnBase *SwitchToDenseStorage(THnBase *storage);
+  void ReleaseDenseStorageMemory();
   void FillBinAxesValues(const Float_t *variableContainer, Int_t chgrpId = -1);
+  Long64_t FindBin(THnBase *histogram);
+  static void LockSharedBin(const void *storage, Long64_t bin);
+  static void UnlockSharedBin(const void *storage, Long64_t bin);
+  static void PrepareSharedHistogram(THnBase *histogram);
+  static void FillSharedBin(THnBase *shared, THnBase *own, Long64_t bin, Double_t weight);
+  Bool_t CheckEventClassAxes(THnBase *histogram);
   THnF* DivideTHnF(THnF* values, THnI* entries, THnC *valid = NULL);
   void CopyTHnF(THnF *hDest, THnF *hSource, Int_t *binsArray);
   void CopyTHnFDimension(THnF *hDest, THnF *hSource, Int_t *binsArray, Int_t dimension);
 
   QnCorrectionsEventClassVariablesSet fEventClassVariables;  //!<! The variables set that determines the event classes
   Double_t *fBinAxesValues;                                  //!<! Runtime place holder for computing bin number
+  Int_t *fBinAxesIndexes;                                    //!<! Runtime place holder for computing bin number on shared histograms
+  Bool_t fEventClassAxesMatch;                               //!<! kTRUE if the histograms event class axes match the event class variables binning
   QnCorrectionHistogramErrorMode fErrorMode;                 //!<! The error type for the current instance
   Int_t fMinNoOfEntriesToValidate;                           ///< the minimum number of entries for validating a bin content
+  TList *fStorageList;                                       //!<! The list which owns the bins storage
+  Long64_t fDenseStorageThreshold;                           //!<! The number of filled bins to switch to dense storage, -1 if never
+  Long64_t fDenseStorageMemory;                              //!<! The memory reserved within the budget for the dense storage
   /// \cond CLASSIMP
-  ClassDef(QnCorrectionsHistogramBase, 2);
+  ClassDef(QnCorrectionsHistogramBase, 3);
   /// \endcond
   static const char *szChannelAxisTitle;                 ///< The title for the channel extra axis
   static const char *szGroupAxisTitle;                   ///< The title for the channel group extra axis
@@ -154,5 +197,73 @@ inline void QnCorrectionsHistogramBase::FillBinAxesValues(const Float_t *variabl
   fBinAxesValues[fEventClassVariables.GetEntriesFast()] = chgrpId;
 }
 
+/// Finds the bin number for the current bin axes values
+///
+/// THn::GetBin(const Double_t *) stores the bin coordinates in an internal
+/// buffer of the histogram. This is avoided here by locating the bin
+/// coordinates and keeping them in the own place holder so that histograms
+/// shared by several framework instances, i.e. the calibration histograms,
+/// can be concurrently addressed.
+///
+/// The event class coordinates are taken from the event class variables.
+/// They keep the last found bin so, the axes search is done once per event
+/// for all the histograms of the detector configuration. Only if the
+/// histogram event class axes do not match the variables binning, which
+/// could happen for attached histograms, or for the extra channel or group
+/// axis, the histogram axes are searched.
+///
+/// The bin axes values should have been filled before.
+/// \param histogram the histogram to address
+/// \return the associated bin to the current bin axes values
+inline Long64_t QnCorrectionsHistogramBase::FindBin(THnBase *histogram) {
+  Int_t nVariables = fEventClassVariables.GetEntriesFast();
+  if (fEventClassAxesMatch) {
+    for (Int_t var = 0; var < nVariables; var++) {
+      fBinAxesIndexes[var] = fEventClassVariables.At(var)->FindBin(fBinAxesValues[var]);
+    }
+  }
+  else {
+    for (Int_t var = 0; var < nVariables; var++) {
+      fBinAxesIndexes[var] = histogram->GetAxis(var)->FindFixBin(fBinAxesValues[var]);
+    }
+  }
+  for (Int_t var = nVariables; var < histogram->GetNdimensions(); var++) {
+    fBinAxesIndexes[var] = histogram->GetAxis(var)->FindFixBin(fBinAxesValues[var]);
+  }
+  return histogram->GetBin(fBinAxesIndexes);
+}
+
+/// Updates the bins storage after a fill
+///
+/// A sparse storage is switched to a dense one once its number
+/// of filled bins reaches the threshold fixed at creation time.
+/// The bin numbers obtained before the switch are not valid
+/// afterwards.
+/// \param storage the current bins storage
+/// \return the bins storage to use from now on
+inline THnBase *QnCorrectionsHistogramBase::UpdateStorage(THnBase *storage) {
+  if ((0 < fDenseStorageThreshold) && (fDenseStorageThreshold <= storage->GetNbins()))
+    return SwitchToDenseStorage(storage);
+  return storage;
+}
+
+/// Fills a bin of a histogram shared with other framework instances
+///
+/// The content, and the squared weight if errors are computed, are
+/// added to the shared histogram bin under its bin lock. The entries
+/// are kept in the own histogram which is in that way ready for
+/// being merged.
+/// \param shared the shared histogram
+/// \param own the own histogram which keeps the entries
+/// \param bin the bin to fill
+/// \param weight the increment in the bin content
+inline void QnCorrectionsHistogramBase::FillSharedBin(THnBase *shared, THnBase *own, Long64_t bin, Double_t weight) {
+  LockSharedBin(shared, bin);
+  shared->AddBinContent(bin, weight);
+  if (shared->GetCalculateErrors()) shared->AddBinError2(bin, weight * weight);
+  UnlockSharedBin(shared, bin);
+  own->SetEntries(own->GetEntries() + 1);
+}
+
 
 #endif
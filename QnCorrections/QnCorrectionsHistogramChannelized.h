@@ -54,8 +54,12 @@ public:
   virtual void Fill(const Float_t *variableContainer, Float_t weight)
   { QnCorrectionsHistogramBase::Fill(variableContainer, weight); }
   virtual void Fill(const Float_t *variableContainer, Int_t nChannel, Float_t weight);
+
+  /// Gets the memory taken by the histogram storage
+  /// \return the memory in bytes
+  virtual Long64_t GetMemorySize() const { return GetStorageSize(fValues); }
 private:
-  THnF *fValues;              //!<! Cumulates values for each of the event classes
+  THnBase *fValues;                 //!<! Cumulates values for each of the event classes
   Bool_t *fUsedChannel;       //!<! array, which of the detector channels is used for this configuration
   Int_t fNoOfChannels;        //!<! The number of channels associated to the whole detector
   Int_t fActualNoOfChannels;  //!<! The actual number of channels handled by the histogram
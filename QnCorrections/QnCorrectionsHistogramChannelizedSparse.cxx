@@ -114,7 +114,7 @@ Bool_t QnCorrectionsHistogramChannelizedSparse::CreateChannelizedHistogram(TList
   nbins[nVariables] = fActualNoOfChannels;
 
   /* create the values multidimensional histogram */
-  fValues = new THnSparseF((const char *) histoName, (const char *) histoTitle,nVariables+1,nbins,minvals,maxvals);
+  fValues = CreateStorage((const char *) histoName, (const char *) histoTitle,nVariables+1,nbins,minvals,maxvals,kFALSE);
 
   /* now let's set the proper binning and label on each axis */
   for (Int_t var = 0; var < nVariables; var++) {
@@ -137,6 +137,7 @@ Bool_t QnCorrectionsHistogramChannelizedSparse::CreateChannelizedHistogram(TList
   fValues->Sumw2();
 
   histogramList->Add(fValues);
+  fStorageList = histogramList;
 
   delete [] minvals;
   delete [] maxvals;
@@ -157,7 +158,7 @@ Long64_t QnCorrectionsHistogramChannelizedSparse::GetBin(const Float_t *variable
 
   FillBinAxesValues(variableContainer, fChannelMap[nChannel]);
   /* store the channel number */
-  return fValues->GetBin(fBinAxesValues);
+  return FindBin(fValues);
 }
 
 /// Check the validity of the content of the passed bin
@@ -209,8 +210,9 @@ void QnCorrectionsHistogramChannelizedSparse::Fill(const Float_t *variableContai
 
   FillBinAxesValues(variableContainer, fChannelMap[nChannel]);
   /* and now update the bin */
-  fValues->Fill(fBinAxesValues, weight);
+  fValues->FillBin(FindBin(fValues), weight);
   fValues->SetEntries(nEntries + 1);
+  fValues = UpdateStorage(fValues);
 }
 
 
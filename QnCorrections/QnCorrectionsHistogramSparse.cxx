@@ -65,7 +65,7 @@ Bool_t QnCorrectionsHistogramSparse::CreateHistogram(TList *histogramList) {
   fEventClassVariables.GetMultidimensionalConfiguration(nbins,minvals,maxvals);
 
   /* create the values multidimensional histogram */
-  fValues = new THnSparseF((const char *) histoName, (const char *) histoTitle,nVariables,nbins,minvals,maxvals);
+  fValues = CreateStorage((const char *) histoName, (const char *) histoTitle,nVariables,nbins,minvals,maxvals,kFALSE);
 
   /* now let's set the proper binning and label on each axis */
   for (Int_t var = 0; var < nVariables; var++) {
@@ -76,6 +76,7 @@ Bool_t QnCorrectionsHistogramSparse::CreateHistogram(TList *histogramList) {
   fValues->Sumw2();
 
   histogramList->Add(fValues);
+  fStorageList = histogramList;
 
   delete [] minvals;
   delete [] maxvals;
@@ -95,7 +96,7 @@ Long64_t QnCorrectionsHistogramSparse::GetBin(const Float_t *variableContainer)
 
   FillBinAxesValues(variableContainer);
   /* store the channel number */
-  return fValues->GetBin(fBinAxesValues);
+  return FindBin(fValues);
 }
 
 /// Check the validity of the content of the passed bin
@@ -146,8 +147,9 @@ void QnCorrectionsHistogramSparse::Fill(const Float_t *variableContainer, Float_
 
   FillBinAxesValues(variableContainer);
   /* and now update the bin */
-  fValues->Fill(fBinAxesValues, weight);
+  fValues->FillBin(FindBin(fValues), weight);
   fValues->SetEntries(nEntries + 1);
+  fValues = UpdateStorage(fValues);
 }
 
 
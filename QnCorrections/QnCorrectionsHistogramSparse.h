@@ -45,8 +45,12 @@ public:
   /// wrong call for this class invoke base class behavior
   virtual void Fill(const Float_t *variableContainer, Int_t nChannel, Float_t weight)
   { QnCorrectionsHistogramBase::Fill(variableContainer, nChannel, weight); }
+
+  /// Gets the memory taken by the histogram storage
+  /// \return the memory in bytes
+  virtual Long64_t GetMemorySize() const { return GetStorageSize(fValues); }
 private:
-  THnSparseF *fValues;              //!<! Cumulates values for each of the event classes
+  THnBase *fValues;                 //!<! Cumulates values for each of the event classes
 
   /// \cond CLASSIMP
   ClassDef(QnCorrectionsHistogramSparse, 1);
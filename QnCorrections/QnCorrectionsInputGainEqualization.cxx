@@ -72,6 +72,12 @@ QnCorrectionsInputGainEqualization::QnCorrectionsInputGainEqualization() :
   fUseChannelGroupsWeights = kFALSE;
   fHardCodedWeights = NULL;
   fMinNoOfEntriesToValidate = fDefaultMinNoOfEntries;
+  fNoOfChannels = 0;
+  fReferenceChannel = -1;
+  fTableEventClassBin = -1;
+  fTableScale = NULL;
+  fTableOffset = NULL;
+  fTableValidated = NULL;
 }
 
 /// Default destructor
@@ -87,6 +93,12 @@ QnCorrectionsInputGainEqualization::~QnCorrectionsInputGainEqualization() {
     delete fQAMultiplicityAfter;
   if (fQANotValidatedBin != NULL)
     delete fQANotValidatedBin;
+  if (fTableScale != NULL)
+    delete [] fTableScale;
+  if (fTableOffset != NULL)
+    delete [] fTableOffset;
+  if (fTableValidated != NULL)
+    delete [] fTableValidated;
 }
 
 /// Attaches the needed input information to the correction step
@@ -102,6 +114,8 @@ Bool_t QnCorrectionsInputGainEqualization::AttachInput(TList *list) {
       ownerConfiguration->GetUsedChannelsMask(), ownerConfiguration->GetChannelsGroups())) {
     fState = QCORRSTEP_applyCollect;
     fHardCodedWeights = ownerConfiguration->GetHardCodedGroupWeights();
+    /* the equalization table must be rebuilt from the new input */
+    fTableEventClassBin = -1;
     return kTRUE;
   }
   return kFALSE;
@@ -109,9 +123,78 @@ Bool_t QnCorrectionsInputGainEqualization::AttachInput(TList *list) {
 
 /// Asks for support data structures creation
 ///
-/// Does nothing for the time being
+/// Allocates the per channel equalization table and locates the
+/// first used channel to identify the event class
 void QnCorrectionsInputGainEqualization::CreateSupportDataStructures() {
+  QnCorrectionsDetectorConfigurationChannels *ownerConfiguration =
+      static_cast<QnCorrectionsDetectorConfigurationChannels *>(fDetectorConfiguration);
+  const Bool_t *usedChannel = ownerConfiguration->GetUsedChannelsMask();
+
+  fNoOfChannels = ownerConfiguration->GetNoOfChannels();
+  fReferenceChannel = -1;
+  for (Int_t ixChannel = 0; ixChannel < fNoOfChannels; ixChannel++) {
+    if (usedChannel[ixChannel]) {
+      fReferenceChannel = ixChannel;
+      break;
+    }
+  }
+  fTableEventClassBin = -1;
+  fTableScale = new Float_t[fNoOfChannels];
+  fTableOffset = new Float_t[fNoOfChannels];
+  fTableValidated = new Bool_t[fNoOfChannels];
+}
+
+/// Builds the per channel equalization table for the current event class
+///
+/// For each used channel the equalization, group weight included, is
+/// expressed as a scale and an offset to apply to the channel weight.
+/// Channels with not validated calibration bin content keep their weight.
+/// \param variableContainer the current variables content addressed by var Id
+void QnCorrectionsInputGainEqualization::BuildEqualizationTable(const Float_t *variableContainer) {
+  const Bool_t *usedChannel =
+      static_cast<QnCorrectionsDetectorConfigurationChannels *>(fDetectorConfiguration)->GetUsedChannelsMask();
+
+  for (Int_t ixChannel = 0; ixChannel < fNoOfChannels; ixChannel++) {
+    fTableScale[ixChannel] = 1.0;
+    fTableOffset[ixChannel] = 0.0;
+    fTableValidated[ixChannel] = kTRUE;
+    if (!usedChannel[ixChannel]) continue;
 
+    Long64_t bin = fInputHistograms->GetBin(variableContainer, ixChannel);
+    if (!fInputHistograms->BinContentValidated(bin)) {
+      fTableValidated[ixChannel] = kFALSE;
+      continue;
+    }
+    Float_t average = fInputHistograms->GetBinContent(bin);
+    /* let's handle the potential group weights usage */
+    Float_t groupweight = 1.0;
+    if (fUseChannelGroupsWeights) {
+      groupweight = fInputHistograms->GetGrpBinContent(fInputHistograms->GetGrpBin(variableContainer, ixChannel));
+    }
+    else {
+      if (fHardCodedWeights != NULL) {
+        groupweight = fHardCodedWeights[ixChannel];
+      }
+    }
+    if (!(fMinimumSignificantValue < average)) {
+      fTableScale[ixChannel] = 0.0;
+      continue;
+    }
+    switch (fEqualizationMethod) {
+    case GEQUAL_averageEqualization:
+      fTableScale[ixChannel] = groupweight / average;
+      break;
+    case GEQUAL_widthEqualization: {
+        Float_t width = fInputHistograms->GetBinError(bin);
+        fTableScale[ixChannel] = fScale / width * groupweight;
+        fTableOffset[ixChannel] = (fShift - fScale * average / width) * groupweight;
+      }
+      break;
+    default:
+      break;
+    }
+  }
+  fTableEventClassBin = fInputHistograms->GetBin(variableContainer, fReferenceChannel);
 }
 
 /// Asks for support histograms creation
@@ -137,6 +220,8 @@ QnCorrectionsDetectorConfigurationChannels *ownerConfiguration =
   fInputHistograms = new QnCorrectionsProfileChannelizedIngress((const char *) histoNameAndTitle, (const char *) histoNameAndTitle,
       ownerConfiguration->GetEventClassVariablesSet(),ownerConfiguration->GetNoOfChannels(), "s");
   fInputHistograms->SetNoOfEntriesThreshold(fMinNoOfEntriesToValidate);
+  /* they are rebuilt, between passes, when the events are processed several times */
+  if (fCalibrationHistograms != NULL) delete fCalibrationHistograms;
   fCalibrationHistograms = new QnCorrectionsProfileChannelized((const char *) histoNameAndTitle, (const char *) histoNameAndTitle,
       ownerConfiguration->GetEventClassVariablesSet(),ownerConfiguration->GetNoOfChannels(), "s");
   fCalibrationHistograms->CreateProfileHistograms(list,
@@ -144,6 +229,14 @@ QnCorrectionsDetectorConfigurationChannels *ownerConfiguration =
   return kTRUE;
 }
 
+/// Shares the support histograms of the same correction step of another framework instance
+/// \param master the correction step whose support histograms will be shared
+void QnCorrectionsInputGainEqualization::ShareSupportHistograms(QnCorrectionsCorrectionStepBase *master) {
+
+  if (fCalibrationHistograms != NULL)
+    fCalibrationHistograms->ShareHistograms(static_cast<QnCorrectionsInputGainEqualization *>(master)->fCalibrationHistograms);
+}
+
 /// Asks for QA histograms creation
 ///
 /// Allocates the histogram objects and creates the QA histograms.
@@ -210,104 +303,51 @@ Bool_t QnCorrectionsInputGainEqualization::CreateNveQAHistograms(TList *list) {
 /// structures should be included.
 /// \return kTRUE if the correction step was applied
 Bool_t QnCorrectionsInputGainEqualization::ProcessCorrections(const Float_t *variableContainer) {
+  QnCorrectionsDataVectorBank *bank = fDetectorConfiguration->GetInputDataBank();
+  Int_t nEntries = bank->GetEntries();
+  const Int_t *id = bank->GetId();
+  Float_t *equalizedWeight = bank->GetEqualizedWeight();
+
   switch (fState) {
   case QCORRSTEP_calibration:
     /* collect the data needed to further produce equalization parameters */
-    for(Int_t ixData = 0; ixData < fDetectorConfiguration->GetInputDataBank()->GetEntriesFast(); ixData++){
-      QnCorrectionsDataVectorChannelized *dataVector =
-          static_cast<QnCorrectionsDataVectorChannelized *>(fDetectorConfiguration->GetInputDataBank()->At(ixData));
-      fCalibrationHistograms->Fill(variableContainer, dataVector->GetId(), dataVector->EqualizedWeight());
+    for(Int_t ixData = 0; ixData < nEntries; ixData++){
+      fCalibrationHistograms->Fill(variableContainer, id[ixData], equalizedWeight[ixData]);
     }
     return kFALSE;
     break;
   case QCORRSTEP_applyCollect:
     /* collect the data needed to further produce equalization parameters */
-    for(Int_t ixData = 0; ixData < fDetectorConfiguration->GetInputDataBank()->GetEntriesFast(); ixData++){
-      QnCorrectionsDataVectorChannelized *dataVector =
-          static_cast<QnCorrectionsDataVectorChannelized *>(fDetectorConfiguration->GetInputDataBank()->At(ixData));
-      fCalibrationHistograms->Fill(variableContainer, dataVector->GetId(), dataVector->EqualizedWeight());
+    for(Int_t ixData = 0; ixData < nEntries; ixData++){
+      fCalibrationHistograms->Fill(variableContainer, id[ixData], equalizedWeight[ixData]);
     }
     /* and proceed to ... */
   case QCORRSTEP_apply: /* apply the equalization */
     /* collect QA data if asked */
     if (fQAMultiplicityBefore != NULL) {
-      for(Int_t ixData = 0; ixData < fDetectorConfiguration->GetInputDataBank()->GetEntriesFast(); ixData++){
-        QnCorrectionsDataVectorChannelized *dataVector =
-            static_cast<QnCorrectionsDataVectorChannelized *>(fDetectorConfiguration->GetInputDataBank()->At(ixData));
-        fQAMultiplicityBefore->Fill(variableContainer, dataVector->GetId(), dataVector->EqualizedWeight());
+      for(Int_t ixData = 0; ixData < nEntries; ixData++){
+        fQAMultiplicityBefore->Fill(variableContainer, id[ixData], equalizedWeight[ixData]);
       }
     }
     /* store the equalized weights in the data vector bank according to equalization method */
-    switch (fEqualizationMethod) {
-    case GEQUAL_noEqualization:
-      for(Int_t ixData = 0; ixData < fDetectorConfiguration->GetInputDataBank()->GetEntriesFast(); ixData++){
-        QnCorrectionsDataVectorChannelized *dataVector =
-            static_cast<QnCorrectionsDataVectorChannelized *>(fDetectorConfiguration->GetInputDataBank()->At(ixData));
-        dataVector->SetEqualizedWeight(dataVector->EqualizedWeight());
+    if ((fEqualizationMethod != GEQUAL_noEqualization) && (fReferenceChannel >= 0)) {
+      /* the equalization table only changes with the event class */
+      if (fInputHistograms->GetBin(variableContainer, fReferenceChannel) != fTableEventClassBin) {
+        BuildEqualizationTable(variableContainer);
       }
-      break;
-    case GEQUAL_averageEqualization:
-      for(Int_t ixData = 0; ixData < fDetectorConfiguration->GetInputDataBank()->GetEntriesFast(); ixData++){
-        QnCorrectionsDataVectorChannelized *dataVector =
-            static_cast<QnCorrectionsDataVectorChannelized *>(fDetectorConfiguration->GetInputDataBank()->At(ixData));
-        Long64_t bin = fInputHistograms->GetBin(variableContainer, dataVector->GetId());
-        if (fInputHistograms->BinContentValidated(bin)) {
-          Float_t average = fInputHistograms->GetBinContent(bin);
-          /* let's handle the potential group weights usage */
-          Float_t groupweight = 1.0;
-          if (fUseChannelGroupsWeights) {
-            groupweight = fInputHistograms->GetGrpBinContent(fInputHistograms->GetGrpBin(variableContainer, dataVector->GetId()));
-          }
-          else {
-            if (fHardCodedWeights != NULL) {
-              groupweight = fHardCodedWeights[dataVector->GetId()];
-            }
-          }
-          if (fMinimumSignificantValue < average)
-            dataVector->SetEqualizedWeight((dataVector->EqualizedWeight() / average) * groupweight);
-          else
-            dataVector->SetEqualizedWeight(0.0);
-        }
-        else {
-          if (fQANotValidatedBin != NULL) fQANotValidatedBin->Fill(variableContainer, dataVector->GetId(), 1.0);
-        }
+      for(Int_t ixData = 0; ixData < nEntries; ixData++){
+        equalizedWeight[ixData] = equalizedWeight[ixData] * fTableScale[id[ixData]] + fTableOffset[id[ixData]];
       }
-      break;
-    case GEQUAL_widthEqualization:
-      for(Int_t ixData = 0; ixData < fDetectorConfiguration->GetInputDataBank()->GetEntriesFast(); ixData++){
-        QnCorrectionsDataVectorChannelized *dataVector =
-            static_cast<QnCorrectionsDataVectorChannelized *>(fDetectorConfiguration->GetInputDataBank()->At(ixData));
-        Long64_t bin = fInputHistograms->GetBin(variableContainer, dataVector->GetId());
-        if (fInputHistograms->BinContentValidated(bin)) {
-          Float_t average = fInputHistograms->GetBinContent(fInputHistograms->GetBin(variableContainer, dataVector->GetId()));
-          Float_t width = fInputHistograms->GetBinError(fInputHistograms->GetBin(variableContainer, dataVector->GetId()));
-          /* let's handle the potential group weights usage */
-          Float_t groupweight = 1.0;
-          if (fUseChannelGroupsWeights) {
-            groupweight = fInputHistograms->GetGrpBinContent(fInputHistograms->GetGrpBin(variableContainer, dataVector->GetId()));
-          }
-          else {
-            if (fHardCodedWeights != NULL) {
-              groupweight = fHardCodedWeights[dataVector->GetId()];
-            }
-          }
-          if (fMinimumSignificantValue < average)
-            dataVector->SetEqualizedWeight((fShift + fScale * (dataVector->EqualizedWeight() - average) / width) * groupweight);
-          else
-            dataVector->SetEqualizedWeight(0.0);
-        }
-        else {
-          if (fQANotValidatedBin != NULL) fQANotValidatedBin->Fill(variableContainer, dataVector->GetId(), 1.0);
+      if (fQANotValidatedBin != NULL) {
+        for(Int_t ixData = 0; ixData < nEntries; ixData++){
+          if (!fTableValidated[id[ixData]]) fQANotValidatedBin->Fill(variableContainer, id[ixData], 1.0);
         }
       }
-      break;
     }
     /* collect QA data if asked */
     if (fQAMultiplicityAfter != NULL) {
-      for(Int_t ixData = 0; ixData < fDetectorConfiguration->GetInputDataBank()->GetEntriesFast(); ixData++){
-        QnCorrectionsDataVectorChannelized *dataVector =
-            static_cast<QnCorrectionsDataVectorChannelized *>(fDetectorConfiguration->GetInputDataBank()->At(ixData));
-        fQAMultiplicityAfter->Fill(variableContainer, dataVector->GetId(), dataVector->EqualizedWeight());
+      for(Int_t ixData = 0; ixData < nEntries; ixData++){
+        fQAMultiplicityAfter->Fill(variableContainer, id[ixData], equalizedWeight[ixData]);
       }
     }
     break;
@@ -375,3 +415,26 @@ Bool_t QnCorrectionsInputGainEqualization::ReportUsage(TList *calibrationList, T
   return kTRUE;
 }
 
+/// Report on the memory taken by the correction step
+///
+/// A list with the step name and the memory taken by its
+/// calibration inputs, the equalization table derived from them
+/// included, support, QA and non validated entries QA histograms
+/// is incorporated to the passed list.
+/// \param list list where the correction step memory list should be incorporated
+void QnCorrectionsInputGainEqualization::ReportOnMemory(TList *list) const {
+  TList *stepList = new TList();
+  stepList->SetOwner(kTRUE);
+  stepList->SetName(GetName());
+
+  AddMemoryUsage(stepList, szCalibrationInputsMemoryName, fInputHistograms);
+  if (fTableScale != NULL)
+    AddMemoryUsage(stepList, szCalibrationInputsMemoryName,
+        Long64_t(fNoOfChannels) * (sizeof(Float_t) + sizeof(Float_t) + sizeof(Bool_t)));
+  AddMemoryUsage(stepList, szSupportHistogramsMemoryName, fCalibrationHistograms);
+  AddMemoryUsage(stepList, szQAHistogramsMemoryName, fQAMultiplicityBefore);
+  AddMemoryUsage(stepList, szQAHistogramsMemoryName, fQAMultiplicityAfter);
+  AddMemoryUsage(stepList, szNveQAHistogramsMemoryName, fQANotValidatedBin);
+  list->Add(stepList);
+}
+
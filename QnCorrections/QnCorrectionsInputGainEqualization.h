@@ -49,6 +49,12 @@
 /// If the class instance is not in the correction status then, it is
 /// in the calibration one, collecting data for producing, once merged in a
 /// further phase, the calibration histograms.
+///
+/// All the channels of an event share the same event class so, when correcting,
+/// the equalization parameters of each channel, group weight included, are
+/// turned into a scale and an offset on a per channel table that is only
+/// rebuilt when the event class changes. The equalization is then a
+/// multiply-add of the channel weight with its table entry.
 
 #include "QnCorrectionsCorrectionOnInputData.h"
 
@@ -98,6 +104,12 @@ class QnCorrectionsHistogramChannelizedSparse;
 /// If the class instance is not in the correction status then, it is
 /// in the calibration one, collecting data for producing, once merged in a
 /// further phase, the calibration histograms.
+///
+/// All the channels of an event share the same event class so, when correcting,
+/// the equalization parameters of each channel, group weight included, are
+/// turned into a scale and an offset on a per channel table that is only
+/// rebuilt when the event class changes. The equalization is then a
+/// multiply-add of the channel weight with its table entry.
 
 class QnCorrectionsInputGainEqualization : public QnCorrectionsCorrectionOnInputData {
 public:
@@ -153,9 +165,13 @@ public:
   /// Clean the correction to accept a new event
   /// Does nothing for the time being
   virtual void ClearCorrectionStep() {}
+  virtual void ShareSupportHistograms(QnCorrectionsCorrectionStepBase *master);
   virtual Bool_t ReportUsage(TList *calibrationList, TList *applyList);
+  virtual void ReportOnMemory(TList *list) const;
 
 private:
+  void BuildEqualizationTable(const Float_t *variableContainer);
+
   static const Float_t  fMinimumSignificantValue;     ///< the minimum value that will be considered as meaningful for processing
   static const Int_t fDefaultMinNoOfEntries;         ///< the minimum number of entries for bin content validation
   static const char *szCorrectionName;               ///< the name of the correction step
@@ -175,9 +191,15 @@ private:
   Bool_t fUseChannelGroupsWeights;              ///< use group weights extracted from channel multiplicity
   const Float_t *fHardCodedWeights;             //!<! group hard coded weights stored in the detector configuration
   Int_t fMinNoOfEntriesToValidate;              ///< number of entries for bin content validation threshold
+  Int_t fNoOfChannels;                          //!<! the number of channels of the detector
+  Int_t fReferenceChannel;                      //!<! the channel used to identify the event class
+  Long64_t fTableEventClassBin;                 //!<! the event class bin the equalization table was built for, -1 if none
+  Float_t *fTableScale;                         //!<! array, the per channel equalization scale
+  Float_t *fTableOffset;                        //!<! array, the per channel equalization offset
+  Bool_t *fTableValidated;                      //!<! array, the per channel calibration bin content validated flag
 
 /// \cond CLASSIMP
-  ClassDef(QnCorrectionsInputGainEqualization, 2);
+  ClassDef(QnCorrectionsInputGainEqualization, 3);
 /// \endcond
 };
 
@@ -68,42 +68,41 @@ void QnCorrectionsPrintMessageHandler(UInt_t type, const char* message,
 {
 // print the given message
 
+  /* don't build the location for messages that will not be printed */
+  if (type < nLoggingLevel) return;
+
   TString sLocation = Form("%s/%s::%s: (%s:%.0d)",module,className,function,file,line);
 
   if (message != NULL) {
-    if (!(type < nLoggingLevel)) {
-      switch (type) {
-      case kInfo:
-        Info(Form("I-%s", (const char *) sLocation), "%s", message);
-        break;
-      case kWarning:
-        Warning(Form("W-%s", (const char *) sLocation), "%s", message);
-        break;
-      case kError:
-        Error(Form("E-%s", (const char *) sLocation), "%s", message);
-        break;
-      case kFatal:
-        Fatal(Form("FATAL-%s", (const char *) sLocation), "%s", message);
-        break;
-      }
+    switch (type) {
+    case kInfo:
+      Info(Form("I-%s", (const char *) sLocation), "%s", message);
+      break;
+    case kWarning:
+      Warning(Form("W-%s", (const char *) sLocation), "%s", message);
+      break;
+    case kError:
+      Error(Form("E-%s", (const char *) sLocation), "%s", message);
+      break;
+    case kFatal:
+      Fatal(Form("FATAL-%s", (const char *) sLocation), "%s", message);
+      break;
     }
   }
   else {
-    if (!(type < nLoggingLevel)) {
-      switch (type) {
-      case kInfo:
-        Info(Form("I-%s", (const char *) sLocation), "%s", " ");
-        break;
-      case kWarning:
-        Warning(Form("W-%s", (const char *) sLocation), "%s", " ");
-        break;
-      case kError:
-        Error(Form("E-%s", (const char *) sLocation), "%s", " ");
-        break;
-      case kFatal:
-        Fatal(Form("FATAL-%s", (const char *) sLocation), "%s", " ");
-        break;
-      }
+    switch (type) {
+    case kInfo:
+      Info(Form("I-%s", (const char *) sLocation), "%s", " ");
+      break;
+    case kWarning:
+      Warning(Form("W-%s", (const char *) sLocation), "%s", " ");
+      break;
+    case kError:
+      Error(Form("E-%s", (const char *) sLocation), "%s", " ");
+      break;
+    case kFatal:
+      Fatal(Form("FATAL-%s", (const char *) sLocation), "%s", " ");
+      break;
     }
   }
 }
@@ -39,17 +39,31 @@ extern void QnCorrectionsPrintMessageHandler(UInt_t type, const char* message,
                           const char* module, const char* className,
                           const char* function, const char* file, Int_t line);
 extern void QnCorrectionsSetTracingLevel(UInt_t level);
+extern UInt_t nLoggingLevel;
+
+/// Checks if messages of the passed level will be printed
+/// \param lvl level of the logging message
+#define QnCorrectionsLevelEnabled(lvl) (!(UInt_t(lvl) < nLoggingLevel))
 
 /// Actual way to invoke the logging function. It is
 /// a macro that incorporates the additional information needed
 /// for locating the source code the message was raised.
+///
+/// The logging level is checked first so, the message is only
+/// built when it is going to be printed.
 /// \param lvl level of the logging message
 /// \param message meaningful message to print
 #define QnCorrectionsMessage(lvl,message) do { \
-      QnCorrectionsPrintMessageHandler(lvl, message, MODULENAME(), ClassName(), FUNCTIONNAME(), __FILE__, __LINE__);} while(false)
+      if (QnCorrectionsLevelEnabled(lvl)) \
+        QnCorrectionsPrintMessageHandler(lvl, message, MODULENAME(), ClassName(), FUNCTIONNAME(), __FILE__, __LINE__);} while(false)
 
+#ifndef QNCORRECTIONSNOINFO
 /// User function for an Info message
 #define QnCorrectionsInfo(message)               QnCorrectionsMessage(kInfo, message)
+#else /* QNCORRECTIONSNOINFO */
+/// User function for an Info message. Info messages compiled out
+#define QnCorrectionsInfo(message)               do {} while(false)
+#endif /* QNCORRECTIONSNOINFO */
 /// User function for a Warning message
 #define QnCorrectionsWarning(message)            QnCorrectionsMessage(kWarning, message)
 /// User function for an Error message
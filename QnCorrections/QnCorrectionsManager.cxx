@@ -33,13 +33,26 @@
 
 #include <TFile.h>
 #include <TList.h>
+#include <THashList.h>
 #include <TKey.h>
+#include <TH1.h>
+#include <TBranch.h>
+#include <TParameter.h>
+#include <RConfigure.h>
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#include <ROOT/TSeq.hxx>
+#endif // R__USE_IMT
 #include "QnCorrectionsManager.h"
+#include "QnCorrectionsCalibrationList.h"
+#include "QnCorrectionsEventBuffer.h"
 #include "QnCorrectionsLog.h"
 
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <mutex>
+#include <string.h>
 
 using std::cout;
 using std::endl;
@@ -49,6 +62,9 @@ using std::setw;
 ClassImp(QnCorrectionsManager);
 /// \endcond
 
+/// The lock of the manager output trees when shared with the workers
+static std::mutex sharedOutputTreesLock;
+
 const Int_t QnCorrectionsManager::nMaxNoOfDetectors = 32;
 const Int_t QnCorrectionsManager::nMaxNoOfDataVariables = 2048;
 const char *QnCorrectionsManager::szCalibrationHistogramsKeyName = "CalibrationHistograms";
@@ -56,15 +72,24 @@ const char *QnCorrectionsManager::szCalibrationQAHistogramsKeyName = "Calibratio
 const char *QnCorrectionsManager::szCalibrationNveQAHistogramsKeyName = "CalibrationQANveHistograms";
 const char *QnCorrectionsManager::szDummyProcessListName = "dummyprocess";
 const char *QnCorrectionsManager::szAllProcessesListName = "all data";
+const char *QnCorrectionsManager::szQnVectorTreeName = "QnVectorTree";
+const char *QnCorrectionsManager::szTimingHistogramsKeyName = "ProcessingTimingHistograms";
+const char *QnCorrectionsManager::szTimingUnitNames[TIMING_NoOfUnits] = {
+    "data vectors ingestion",
+    "event clearing"
+};
 
 /// Default constructor.
 /// The class owns the detectors and will be destroyed with it
 QnCorrectionsManager::QnCorrectionsManager() :
-    TObject(), fDetectorsSet(), fProcessListName(szDummyProcessListName) {
+    TObject(), fDetectorsSet(), fConfigurationsRegistry(), fProcessListName(szDummyProcessListName) {
 
   fDetectorsSet.SetOwner(kTRUE);
   fDetectorsIdMap = NULL;
   fDataContainer = NULL;
+  fNoOfEventLevelVariables = 0;
+  fEventLevelVariables = NULL;
+  fEventLevelVariablesMap = NULL;
   fCalibrationHistogramsList = NULL;
   fSupportHistogramsList = NULL;
   fQAHistogramsList = NULL;
@@ -75,7 +100,39 @@ QnCorrectionsManager::QnCorrectionsManager() :
   fFillQAHistograms = kFALSE;
   fFillNveQAHistograms = kFALSE;
   fFillQnVectorTree = kFALSE;
+  fQnVectorTreeBasketSize = 32000;
+  fQnVectorTreeCompressionSettings = -1;
+  fQnVectorTreeDirectory = NULL;
+  fQnVectorTreeNoOfQnVectors = 0;
+  fQnVectorTreeQnVectors = NULL;
+  fQnVectorTreeOffset = NULL;
+  fQnVectorTreeHarmonics = NULL;
+  fQnVectorTreeComponents = NULL;
+  fQnVectorTreeN = NULL;
+  fQnVectorTreeSumW = NULL;
+  fQnVectorTreeGood = NULL;
+  fProcessConfigurationsConcurrently = kFALSE;
+  fScheduledConfigurations = NULL;
+  fNoOfIndependentConfigurations = 0;
+  fEventClassVariables = NULL;
+  fConfigurationsExecutor = NULL;
   fProcessesNames = NULL;
+  fNoOfWorkers = 0;
+  fWorkers = NULL;
+  fShareSupportHistograms = kFALSE;
+  fMasterManager = NULL;
+  fEventBuffer = NULL;
+  fBufferedConfigurations = NULL;
+  fRecordPlainQnVectors = kFALSE;
+  fPlainQnVectorsRecordDirectory = NULL;
+  fPlainQnVectorsRecord = NULL;
+  fTimeProcessing = kFALSE;
+  for (Int_t unit = 0; unit < TIMING_NoOfUnits; unit++) {
+    fProcessingTime[unit] = 0;
+    fProcessingCalls[unit] = 0;
+  }
+  fIngestionStart = 0;
+  fTimingHistogramsList = NULL;
 }
 
 /// Default destructor
@@ -84,11 +141,39 @@ QnCorrectionsManager::~QnCorrectionsManager() {
 
   if (fDetectorsIdMap != NULL) delete [] fDetectorsIdMap;
   if (fDataContainer != NULL) delete [] fDataContainer;
-  if (fCalibrationHistogramsList != NULL) delete fCalibrationHistogramsList;
+  if (fEventLevelVariables != NULL) delete [] fEventLevelVariables;
+  if (fEventLevelVariablesMap != NULL) delete [] fEventLevelVariablesMap;
+  if (fWorkers != NULL) delete fWorkers;
+  /* the workers share the manager calibration histograms */
+  if (fCalibrationHistogramsList != NULL && fMasterManager == NULL) delete fCalibrationHistogramsList;
   if (fProcessesNames != NULL) delete fProcessesNames;
+  /* a tree attached to a directory is owned by it */
+  if (fQnVectorTree != NULL && fQnVectorTreeDirectory == NULL) delete fQnVectorTree;
+  if (fQnVectorTreeQnVectors != NULL) delete [] fQnVectorTreeQnVectors;
+  if (fQnVectorTreeOffset != NULL) delete [] fQnVectorTreeOffset;
+  if (fQnVectorTreeHarmonics != NULL) delete [] fQnVectorTreeHarmonics;
+  if (fQnVectorTreeComponents != NULL) delete [] fQnVectorTreeComponents;
+  if (fQnVectorTreeN != NULL) delete [] fQnVectorTreeN;
+  if (fQnVectorTreeSumW != NULL) delete [] fQnVectorTreeSumW;
+  if (fQnVectorTreeGood != NULL) delete [] fQnVectorTreeGood;
+  if (fScheduledConfigurations != NULL) delete fScheduledConfigurations;
+  if (fEventClassVariables != NULL) delete fEventClassVariables;
+  if (fEventBuffer != NULL) delete fEventBuffer;
+  if (fBufferedConfigurations != NULL) delete fBufferedConfigurations;
+  if (fPlainQnVectorsRecord != NULL) delete fPlainQnVectorsRecord;
+  if (fTimingHistogramsList != NULL) delete fTimingHistogramsList;
+#ifdef R__USE_IMT
+  if (fConfigurationsExecutor != NULL) delete fConfigurationsExecutor;
+#endif // R__USE_IMT
 }
 
 /// Sets the base list that will own the input calibration histograms
+///
+/// If the calibration histograms were stored with the indexed layout
+/// (see QnCorrectionsCalibrationList::WriteIndexed) the histograms are
+/// read on demand when the detector configurations attach their inputs.
+/// In that case the file must stay open while process list names could
+/// still be changed. Otherwise the whole calibration list is read at once.
 /// \param calibrationFile the file
 void QnCorrectionsManager::SetCalibrationHistogramsList(TFile *calibrationFile) {
   if (calibrationFile) {
@@ -100,7 +185,17 @@ void QnCorrectionsManager::SetCalibrationHistogramsList(TFile *calibrationFile)
         delete fCalibrationHistogramsList;
         fCalibrationHistogramsList = NULL;
       }
-      fCalibrationHistogramsList = (TList*)((TKey*)calibrationFile->GetListOfKeys()->FindObject(szCalibrationHistogramsKeyName))->ReadObj()->Clone();
+      TKey *key = calibrationFile->GetKey(szCalibrationHistogramsKeyName);
+      if (key != NULL) {
+        if (TString(key->GetClassName()).EqualTo("TDirectoryFile")) {
+          /* indexed layout: only the histograms asked for will be read, the file must stay open */
+          fCalibrationHistogramsList = new QnCorrectionsCalibrationList(calibrationFile->GetDirectory(szCalibrationHistogramsKeyName));
+        }
+        else {
+          /* single key layout: the whole list is read at once */
+          fCalibrationHistogramsList = QnCorrectionsCalibrationList::BuildHashedList((TList*) key->ReadObj());
+        }
+      }
       if (fCalibrationHistogramsList != NULL) {
         QnCorrectionsInfo(Form("Stored calibration list %s from file %s",
             fCalibrationHistogramsList->GetName(),
@@ -108,11 +203,43 @@ void QnCorrectionsManager::SetCalibrationHistogramsList(TFile *calibrationFile)
         /* we need the histograms ownership once we go to the GRID */
         fCalibrationHistogramsList->SetOwner(kTRUE);
       }
+      /* the workers, if any, share it */
+      if (fWorkers != NULL) {
+        for (Int_t ixWorker = 0; ixWorker < fWorkers->GetEntriesFast(); ixWorker++) {
+          ((QnCorrectionsManager *) fWorkers->At(ixWorker))->fCalibrationHistogramsList = fCalibrationHistogramsList;
+        }
+      }
     }
   }
 }
 
 
+/// Declares a variable as an event level one
+///
+/// Its value is then considered constant within each event so, the
+/// detector configurations cuts on it are evaluated only once per event.
+/// The event class variables need not to be declared.
+/// Must be called before framework initialization.
+/// \param varId the external Id of the variable
+void QnCorrectionsManager::SetEventLevelVariable(Int_t varId) {
+  if ((varId < 0) || !(varId < nMaxNoOfDataVariables)) {
+    QnCorrectionsFatal(Form("You are trying to declare variable Id %d as event level one " \
+        "while the highest variable Id supported is %d. FIX IT, PLEASE.",
+        varId,
+        nMaxNoOfDataVariables - 1));
+    return;
+  }
+  for (Int_t ixVariable = 0; ixVariable < fNoOfEventLevelVariables; ixVariable++) {
+    if (fEventLevelVariables[ixVariable] == varId) return;
+  }
+  Int_t *newVariables = new Int_t[fNoOfEventLevelVariables + 1];
+  for (Int_t ixVariable = 0; ixVariable < fNoOfEventLevelVariables; ixVariable++) {
+    newVariables[ixVariable] = fEventLevelVariables[ixVariable];
+  }
+  newVariables[fNoOfEventLevelVariables++] = varId;
+  if (fEventLevelVariables != NULL) delete [] fEventLevelVariables;
+  fEventLevelVariables = newVariables;
+}
 
 /// Adds a new detector
 /// Checks for an already added detector and for a detector id
@@ -150,6 +277,11 @@ QnCorrectionsDetector *QnCorrectionsManager::FindDetector(const char *name) cons
 /// \param id the id of the detector to find
 /// \return pointer to the found detector (NULL if not found)
 QnCorrectionsDetector *QnCorrectionsManager::FindDetector(Int_t id) const {
+  /* once the framework is initialized the detectors map is available */
+  if (fDetectorsIdMap != NULL) {
+    return ((-1 < id) && (id < nMaxNoOfDetectors)) ? fDetectorsIdMap[id] : NULL;
+  }
+
   QnCorrectionsDetector *detector = NULL;
   for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
     detector = (QnCorrectionsDetector *) fDetectorsSet.At(ixDetector);
@@ -169,6 +301,11 @@ QnCorrectionsDetector *QnCorrectionsManager::FindDetector(Int_t id) const {
 /// \param name the name of the detector configuration to find
 /// \return pointer to the found detector configuration (NULL if not found)
 QnCorrectionsDetectorConfigurationBase *QnCorrectionsManager::FindDetectorConfiguration(const char *name) const {
+  /* once the framework is initialized the registry is available */
+  if (fConfigurationsRegistry.GetEntries() != 0) {
+    return (QnCorrectionsDetectorConfigurationBase *) fConfigurationsRegistry.FindObject(name);
+  }
+
   QnCorrectionsDetectorConfigurationBase *detectorConfiguration;
   for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
     detectorConfiguration = ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->FindDetectorConfiguration(name);
@@ -225,23 +362,103 @@ const QnCorrectionsQnVector *QnCorrectionsManager::GetDetectorQnVector(
   return theQnVector;
 }
 
+/// Creates the worker instances
+///
+/// Each worker is a clone of the configured, not yet initialized, framework.
+/// The input calibration histograms are kept out of the cloning and
+/// shared with the workers.
+void QnCorrectionsManager::CreateWorkers() {
+  TList *calibrationHistogramsList = fCalibrationHistogramsList;
+  fCalibrationHistogramsList = NULL;
+
+  fWorkers = new TObjArray(fNoOfWorkers);
+  fWorkers->SetOwner(kTRUE);
+  for (Int_t ixWorker = 0; ixWorker < fNoOfWorkers; ixWorker++) {
+    QnCorrectionsManager *worker = (QnCorrectionsManager *) Clone();
+    worker->fMasterManager = this;
+    worker->fCalibrationHistogramsList = calibrationHistogramsList;
+    fWorkers->Add(worker);
+  }
+  fCalibrationHistogramsList = calibrationHistogramsList;
+}
+
+/// Makes a worker share the support histograms of the manager
+///
+/// The request is transmitted to the worker detectors pairing them
+/// with the manager ones.
+/// \param worker the worker instance
+void QnCorrectionsManager::ShareSupportHistograms(QnCorrectionsManager *worker) {
+  for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
+    ((QnCorrectionsDetector *) worker->fDetectorsSet.At(ixDetector))->
+        ShareSupportHistograms((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector));
+  }
+}
+
 /// Initializes the correction framework
 /// Basically the different list containing framework objects are built.
 /// Calibration histograms are on a per process basis while QA histograms
 /// don't.
+///
+/// If worker instances were requested they are created out of the
+/// configured framework and initialized as well.
+///
+/// The memory taken by the framework is not reported, call
+/// PrintMemoryReport once the framework is initialized for that.
 void QnCorrectionsManager::InitializeQnCorrectionsFramework() {
 
+  /* the workers out of the not yet initialized framework */
+  if (0 < fNoOfWorkers) {
+    CreateWorkers();
+  }
+
   /* the data bank */
   fDataContainer = new Float_t[nMaxNoOfDataVariables];
 
   /* let's build the detectors map */
   fDetectorsIdMap = new QnCorrectionsDetector *[nMaxNoOfDetectors];
+  for (Int_t ixDetector = 0; ixDetector < nMaxNoOfDetectors; ixDetector++) {
+    fDetectorsIdMap[ixDetector] = NULL;
+  }
   QnCorrectionsDetector *detector = NULL;
   for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
     detector = (QnCorrectionsDetector *) fDetectorsSet.At(ixDetector);
     fDetectorsIdMap[detector->GetId()] = detector;
   }
 
+  /* and the detector configurations registry */
+  TList configurations;
+  configurations.SetOwner(kFALSE);
+  for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
+    ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->FillDetectorConfigurationsList(&configurations);
+  }
+  fConfigurationsRegistry.Expand(configurations.GetEntries());
+  for (Int_t ixConfiguration = 0; ixConfiguration < configurations.GetEntries(); ixConfiguration++) {
+    fConfigurationsRegistry.Add(configurations.At(ixConfiguration));
+  }
+
+  /* the detector configurations processing timing if needed */
+  if (GetShouldTimeProcessing()) {
+    for (Int_t ixConfiguration = 0; ixConfiguration < configurations.GetEntries(); ixConfiguration++) {
+      ((QnCorrectionsDetectorConfigurationBase *) configurations.At(ixConfiguration))->SetTimeProcessing(kTRUE);
+    }
+  }
+
+  /* the event level variables: the declared ones and the event class ones */
+  fEventLevelVariablesMap = new Bool_t[nMaxNoOfDataVariables];
+  for (Int_t ixVariable = 0; ixVariable < nMaxNoOfDataVariables; ixVariable++) {
+    fEventLevelVariablesMap[ixVariable] = kFALSE;
+  }
+  for (Int_t ixVariable = 0; ixVariable < fNoOfEventLevelVariables; ixVariable++) {
+    fEventLevelVariablesMap[fEventLevelVariables[ixVariable]] = kTRUE;
+  }
+  for (Int_t ixConfiguration = 0; ixConfiguration < configurations.GetEntries(); ixConfiguration++) {
+    QnCorrectionsEventClassVariablesSet &ecvs =
+        ((QnCorrectionsDetectorConfigurationBase *) configurations.At(ixConfiguration))->GetEventClassVariablesSet();
+    for (Int_t ixVariable = 0; ixVariable < ecvs.GetEntriesFast(); ixVariable++) {
+      fEventLevelVariablesMap[ecvs.At(ixVariable)->GetVariableId()] = kTRUE;
+    }
+  }
+
 
   /* create the support data structures */
   for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
@@ -249,7 +466,7 @@ void QnCorrectionsManager::InitializeQnCorrectionsFramework() {
   }
 
   /* build the support histograms list */
-  fSupportHistogramsList = new TList();
+  fSupportHistogramsList = new THashList(TCollection::kInitHashTableCapacity, 2);
   fSupportHistogramsList->SetName(szCalibrationHistogramsKeyName);
   fSupportHistogramsList->SetOwner(kTRUE);
 
@@ -258,7 +475,7 @@ void QnCorrectionsManager::InitializeQnCorrectionsFramework() {
   if (fProcessesNames != NULL && fProcessesNames->GetEntries() != 0) {
     for (Int_t i = 0; i < fProcessesNames->GetEntries(); i++) {
       /* the support histgrams list */
-      TList *newList = new TList();
+      TList *newList = new THashList(TCollection::kInitHashTableCapacity, 2);
       newList->SetName(((TObjString *) fProcessesNames->At(i))->GetName());
       newList->SetOwner(kTRUE);
       fSupportHistogramsList->Add(newList);
@@ -282,7 +499,7 @@ void QnCorrectionsManager::InitializeQnCorrectionsFramework() {
       processList = (TList *) fSupportHistogramsList->FindObject(fProcessListName);
     }
     else {
-      processList = new TList();
+      processList = new THashList(TCollection::kInitHashTableCapacity, 2);
       processList->SetName((const char *) fProcessListName);
       processList->SetOwner(kTRUE);
       /* we add it but probably temporarily */
@@ -325,11 +542,11 @@ void QnCorrectionsManager::InitializeQnCorrectionsFramework() {
   /* now build the QA histograms list if needed */
   /* QA histograms are no longer stored on a per run basis */
   if (GetShouldFillQAHistograms()) {
-    fQAHistogramsList = new TList();
+    fQAHistogramsList = new THashList(TCollection::kInitHashTableCapacity, 2);
     fQAHistogramsList->SetName(szCalibrationQAHistogramsKeyName);
     fQAHistogramsList->SetOwner(kTRUE);
     if (GetShouldFillNveQAHistograms()) {
-      fNveQAHistogramsList = new TList();
+      fNveQAHistogramsList = new THashList(TCollection::kInitHashTableCapacity, 2);
       fNveQAHistogramsList->SetName(szCalibrationNveQAHistogramsKeyName);
       fNveQAHistogramsList->SetOwner(kTRUE);
     }
@@ -352,13 +569,354 @@ void QnCorrectionsManager::InitializeQnCorrectionsFramework() {
   }
 
   /* build the Qn vectors list */
-  fQnVectorList = new TList();
+  fQnVectorList = new THashList(TCollection::kInitHashTableCapacity, 2);
   /* the list does not own the Qn vectors */
   fQnVectorList->SetOwner(kFALSE);
   /* pass it to the detectors for Qn vector creation and attachment */
   for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
     ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->IncludeQnVectors(fQnVectorList);
   }
+
+  /* the Qn vector tree if needed */
+  if (GetShouldFillQnVectorTree()) {
+    CreateQnVectorTree();
+  }
+
+  /* the plain Qn vectors record if needed */
+  /* the workers ones are kept in memory and periodically transferred to the manager one */
+  if (GetShouldRecordPlainQnVectors()) {
+    fPlainQnVectorsRecord = new QnCorrectionsQnVectorRecord();
+    if (!fPlainQnVectorsRecord->CreateTree(fPlainQnVectorsRecordDirectory, fEventLevelVariablesMap, nMaxNoOfDataVariables, &configurations)) {
+      QnCorrectionsFatal("Failed to build the plain Qn vectors record.");
+    }
+  }
+
+  /* the detector configurations concurrent processing if needed */
+  if (GetShouldProcessConfigurationsConcurrently()) {
+    BuildConfigurationsSchedule();
+  }
+
+  /* and finally the workers */
+  /* each one sharing, if requested, the support histograms as soon as it is initialized */
+  if (fWorkers != NULL) {
+    for (Int_t ixWorker = 0; ixWorker < fWorkers->GetEntriesFast(); ixWorker++) {
+      ((QnCorrectionsManager *) fWorkers->At(ixWorker))->InitializeQnCorrectionsFramework();
+      if (fShareSupportHistograms) {
+        ShareSupportHistograms((QnCorrectionsManager *) fWorkers->At(ixWorker));
+      }
+    }
+  }
+}
+
+/// Creates the Qn vector tree out of the current Qn vectors list
+///
+/// For each detector configuration and for each of its Qn vectors a
+/// group of flat branches is created: the X and Y components of the
+/// active harmonics as fixed size arrays, the number of elements, the
+/// sum of weights and the quality flag. The branches are named after the
+/// detector configuration and the Qn vector, "latest" for the latest
+/// corrected one, e.g. TPC_rec_Qx.
+///
+/// The set of Qn vectors depends on the correction steps being applied
+/// so, the tree is rebuilt each time the Qn vectors list is, while it
+/// has no entries. Once it has, its layout is kept.
+void QnCorrectionsManager::CreateQnVectorTree() {
+
+  if (fQnVectorTree != NULL) {
+    if (fQnVectorTree->GetEntries() != 0) {
+      return;
+    }
+    delete fQnVectorTree;
+    fQnVectorTree = NULL;
+    delete [] fQnVectorTreeQnVectors;
+    delete [] fQnVectorTreeOffset;
+    delete [] fQnVectorTreeHarmonics;
+    delete [] fQnVectorTreeComponents;
+    delete [] fQnVectorTreeN;
+    delete [] fQnVectorTreeSumW;
+    delete [] fQnVectorTreeGood;
+  }
+
+  /* first the size of the branches buffers */
+  Int_t nQnVectors = 0;
+  Int_t nHarmonics = 0;
+  for (Int_t ixConfiguration = 0; ixConfiguration < fQnVectorList->GetEntries(); ixConfiguration++) {
+    TList *configurationList = (TList *) fQnVectorList->At(ixConfiguration);
+    for (Int_t ixQnVector = 0; ixQnVector < configurationList->GetEntries(); ixQnVector++) {
+      nQnVectors++;
+      nHarmonics += ((QnCorrectionsQnVector *) configurationList->At(ixQnVector))->GetNoOfHarmonics();
+    }
+  }
+
+  fQnVectorTreeNoOfQnVectors = nQnVectors;
+  fQnVectorTreeQnVectors = new QnCorrectionsQnVector *[nQnVectors];
+  fQnVectorTreeOffset = new Int_t[nQnVectors + 1];
+  fQnVectorTreeHarmonics = new Int_t[nHarmonics];
+  fQnVectorTreeComponents = new Float_t[2 * nHarmonics];
+  fQnVectorTreeN = new Int_t[nQnVectors];
+  fQnVectorTreeSumW = new Float_t[nQnVectors];
+  fQnVectorTreeGood = new Bool_t[nQnVectors];
+
+  fQnVectorTree = new TTree(szQnVectorTreeName, "Corrected Qn vectors");
+  fQnVectorTree->SetDirectory(fQnVectorTreeDirectory);
+
+  /* now the branches */
+  Int_t ixTreeQnVector = 0;
+  Int_t ixTreeHarmonic = 0;
+  for (Int_t ixConfiguration = 0; ixConfiguration < fQnVectorList->GetEntries(); ixConfiguration++) {
+    TList *configurationList = (TList *) fQnVectorList->At(ixConfiguration);
+    for (Int_t ixQnVector = 0; ixQnVector < configurationList->GetEntries(); ixQnVector++) {
+      QnCorrectionsQnVector *qn = (QnCorrectionsQnVector *) configurationList->At(ixQnVector);
+      /* the first one is the latest corrected Qn vector */
+      TString name = TString(configurationList->GetName()) + "_" + ((ixQnVector == 0) ? "latest" : qn->GetName());
+
+      fQnVectorTreeQnVectors[ixTreeQnVector] = qn;
+      fQnVectorTreeOffset[ixTreeQnVector] = ixTreeHarmonic;
+      Int_t nQnHarmonics = 0;
+      for (Int_t harmonic = qn->GetFirstHarmonic(); harmonic != -1; harmonic = qn->GetNextHarmonic(harmonic)) {
+        fQnVectorTreeHarmonics[ixTreeHarmonic + nQnHarmonics] = harmonic;
+        nQnHarmonics++;
+      }
+
+      TBranch *branches[5];
+      Int_t nBranches = 0;
+      if (nQnHarmonics != 0) {
+        Float_t *qx = fQnVectorTreeComponents + 2 * ixTreeHarmonic;
+        branches[nBranches++] = fQnVectorTree->Branch(name + "_Qx", qx, Form("Qx[%d]/F", nQnHarmonics), fQnVectorTreeBasketSize);
+        branches[nBranches++] = fQnVectorTree->Branch(name + "_Qy", qx + nQnHarmonics, Form("Qy[%d]/F", nQnHarmonics), fQnVectorTreeBasketSize);
+      }
+      branches[nBranches++] = fQnVectorTree->Branch(name + "_N", &fQnVectorTreeN[ixTreeQnVector], "N/I", fQnVectorTreeBasketSize);
+      branches[nBranches++] = fQnVectorTree->Branch(name + "_SumW", &fQnVectorTreeSumW[ixTreeQnVector], "SumW/F", fQnVectorTreeBasketSize);
+      branches[nBranches++] = fQnVectorTree->Branch(name + "_Good", &fQnVectorTreeGood[ixTreeQnVector], "Good/O", fQnVectorTreeBasketSize);
+      if (!(fQnVectorTreeCompressionSettings < 0)) {
+        for (Int_t ixBranch = 0; ixBranch < nBranches; ixBranch++) {
+          branches[ixBranch]->SetCompressionSettings(fQnVectorTreeCompressionSettings);
+        }
+      }
+
+      ixTreeHarmonic += nQnHarmonics;
+      ixTreeQnVector++;
+    }
+  }
+  fQnVectorTreeOffset[ixTreeQnVector] = ixTreeHarmonic;
+}
+
+/// Outputs the current event Qn vectors into a Qn vector tree shared with the workers
+///
+/// The manager fills its tree under the shared output trees lock. A worker
+/// fills its own tree and, once it reaches WORKERTREETRANSFERSIZE entries,
+/// transfers them to the manager tree under the same lock so that the
+/// memory taken by the worker tree stays bounded.
+void QnCorrectionsManager::FillSharedQnVectorTree() {
+  UpdateQnVectorTreeBuffers();
+  if (fMasterManager == NULL) {
+    std::lock_guard<std::mutex> guard(sharedOutputTreesLock);
+    fQnVectorTree->Fill();
+  }
+  else {
+    fQnVectorTree->Fill();
+    if (!(fQnVectorTree->GetEntries() < WORKERTREETRANSFERSIZE)) {
+      std::lock_guard<std::mutex> guard(sharedOutputTreesLock);
+      TransferQnVectorTree();
+    }
+  }
+}
+
+/// Transfers the worker Qn vector tree entries to the manager tree
+///
+/// Each entry is read back into the worker branches buffers, copied
+/// into the manager ones and filled in the manager tree. The worker
+/// tree is then reset. While the workers are processing it must be
+/// called with the shared output trees lock taken.
+void QnCorrectionsManager::TransferQnVectorTree() {
+  QnCorrectionsManager *manager = fMasterManager;
+
+  if (manager->fQnVectorTree == NULL) {
+    fQnVectorTree->Reset();
+    return;
+  }
+  Int_t nHarmonics = fQnVectorTreeOffset[fQnVectorTreeNoOfQnVectors];
+  if ((manager->fQnVectorTreeNoOfQnVectors != fQnVectorTreeNoOfQnVectors) ||
+      (manager->fQnVectorTreeOffset[manager->fQnVectorTreeNoOfQnVectors] != nHarmonics)) {
+    QnCorrectionsFatal("The worker Qn vector tree layout does not match the manager one. FIX IT, PLEASE.");
+    return;
+  }
+  for (Long64_t entry = 0; entry < fQnVectorTree->GetEntries(); entry++) {
+    fQnVectorTree->GetEntry(entry);
+    memcpy(manager->fQnVectorTreeComponents, fQnVectorTreeComponents, 2 * nHarmonics * sizeof(Float_t));
+    memcpy(manager->fQnVectorTreeN, fQnVectorTreeN, fQnVectorTreeNoOfQnVectors * sizeof(Int_t));
+    memcpy(manager->fQnVectorTreeSumW, fQnVectorTreeSumW, fQnVectorTreeNoOfQnVectors * sizeof(Float_t));
+    memcpy(manager->fQnVectorTreeGood, fQnVectorTreeGood, fQnVectorTreeNoOfQnVectors * sizeof(Bool_t));
+    manager->fQnVectorTree->Fill();
+  }
+  fQnVectorTree->Reset();
+}
+
+/// Records the current event plain Qn vectors into a record shared with the workers
+///
+/// The same scheme than FillSharedQnVectorTree: the manager fills its
+/// record under the shared output trees lock and a worker transfers its
+/// entries to the manager record each WORKERTREETRANSFERSIZE entries.
+void QnCorrectionsManager::FillSharedPlainQnVectorsRecord() {
+  if (fMasterManager == NULL) {
+    std::lock_guard<std::mutex> guard(sharedOutputTreesLock);
+    fPlainQnVectorsRecord->Fill(fDataContainer);
+  }
+  else {
+    fPlainQnVectorsRecord->Fill(fDataContainer);
+    if (!(fPlainQnVectorsRecord->GetTree()->GetEntries() < WORKERTREETRANSFERSIZE)) {
+      std::lock_guard<std::mutex> guard(sharedOutputTreesLock);
+      TransferPlainQnVectorsRecord();
+    }
+  }
+}
+
+/// Transfers the worker plain Qn vectors record entries to the manager record
+///
+/// While the workers are processing it must be called with the shared
+/// output trees lock taken.
+void QnCorrectionsManager::TransferPlainQnVectorsRecord() {
+  if (fMasterManager->fPlainQnVectorsRecord == NULL) {
+    fPlainQnVectorsRecord->GetTree()->Reset();
+    return;
+  }
+  if (!fPlainQnVectorsRecord->TransferEntries(fMasterManager->fPlainQnVectorsRecord)) {
+    QnCorrectionsFatal("The worker plain Qn vectors record layout does not match the manager one. FIX IT, PLEASE.");
+  }
+}
+
+/// Builds the schedule for the concurrent processing of detector configurations
+///
+/// The references of each detector configuration, i.e. the detector
+/// configurations its data collection reads from, are gathered. The
+/// configurations without references are scheduled first and will get
+/// their corrections and data collection processed in the same task.
+/// Those with references will get their data collection processed once
+/// the corrections of all configurations have been processed.
+///
+/// The event class variables involved in the detector configurations are
+/// gathered as well. Their bin search memory is shared among the detector
+/// configurations so, it is primed before starting the concurrent tasks.
+void QnCorrectionsManager::BuildConfigurationsSchedule() {
+#ifdef R__USE_IMT
+  TList *configurations = new TList();
+  configurations->SetOwner(kFALSE);
+  for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
+    ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->FillDetectorConfigurationsList(configurations);
+  }
+
+  fScheduledConfigurations = new TObjArray(configurations->GetEntries());
+  fScheduledConfigurations->SetOwner(kFALSE);
+  fEventClassVariables = new TObjArray();
+  fEventClassVariables->SetOwner(kFALSE);
+  TObjArray dependentConfigurations(configurations->GetEntries());
+  TList references;
+  references.SetOwner(kFALSE);
+  for (Int_t ixConfiguration = 0; ixConfiguration < configurations->GetEntries(); ixConfiguration++) {
+    QnCorrectionsDetectorConfigurationBase *configuration =
+        (QnCorrectionsDetectorConfigurationBase *) configurations->At(ixConfiguration);
+
+    references.Clear();
+    configuration->FillReferenceConfigurationsList(&references);
+    if (references.GetEntries() != 0) {
+      for (Int_t ixReference = 0; ixReference < references.GetEntries(); ixReference++) {
+        QnCorrectionsInfo(Form("Detector configuration %s data collection depends on %s corrections",
+            configuration->GetName(), references.At(ixReference)->GetName()));
+      }
+      dependentConfigurations.Add(configuration);
+    }
+    else {
+      fScheduledConfigurations->Add(configuration);
+    }
+
+    QnCorrectionsEventClassVariablesSet &variables = configuration->GetEventClassVariablesSet();
+    for (Int_t ixVariable = 0; ixVariable < variables.GetEntriesFast(); ixVariable++) {
+      if (fEventClassVariables->IndexOf(variables.At(ixVariable)) < 0) {
+        fEventClassVariables->Add(variables.At(ixVariable));
+      }
+    }
+  }
+  fNoOfIndependentConfigurations = fScheduledConfigurations->GetEntriesFast();
+  for (Int_t ixConfiguration = 0; ixConfiguration < dependentConfigurations.GetEntriesFast(); ixConfiguration++) {
+    fScheduledConfigurations->Add(dependentConfigurations.At(ixConfiguration));
+  }
+  delete configurations;
+
+  fConfigurationsExecutor = new ROOT::TThreadExecutor();
+#else
+  QnCorrectionsWarning("ROOT built without implicit multi-threading support. Detector configurations will be processed sequentially");
+#endif // R__USE_IMT
+}
+
+/// Primes the bin search memory of the involved event class variables
+///
+/// The event class variables are shared among detector configurations
+/// so, their bin search memory is updated with the current event values
+/// before the concurrent tasks only read it.
+void QnCorrectionsManager::PrimeEventClassVariables() {
+  for (Int_t ixVariable = 0; ixVariable < fEventClassVariables->GetEntriesFast(); ixVariable++) {
+    QnCorrectionsEventClassVariable *variable = (QnCorrectionsEventClassVariable *) fEventClassVariables->At(ixVariable);
+    variable->FindBin(fDataContainer[variable->GetVariableId()]);
+  }
+}
+
+/// Process the current event concurrently among detector configurations
+///
+/// The detector configurations without references get their corrections
+/// and data collection processed in a single task and the ones with
+/// references get their corrections processed. Once all of them are
+/// done, the Qn vectors tree is filled, if requested, and the data
+/// collection of the configurations with references is processed.
+void QnCorrectionsManager::ProcessEventConcurrently() {
+#ifdef R__USE_IMT
+  PrimeEventClassVariables();
+  fConfigurationsExecutor->Foreach([this](Int_t ixConfiguration) {
+    QnCorrectionsDetectorConfigurationBase *configuration =
+        (QnCorrectionsDetectorConfigurationBase *) fScheduledConfigurations->At(ixConfiguration);
+    configuration->ProcessCorrections(fDataContainer);
+    if (ixConfiguration < fNoOfIndependentConfigurations) {
+      configuration->ProcessDataCollection(fDataContainer);
+    }
+  }, ROOT::TSeqI(fScheduledConfigurations->GetEntriesFast()));
+
+  if (fQnVectorTree != NULL) {
+    FillQnVectorTree();
+  }
+  if (fPlainQnVectorsRecord != NULL) {
+    FillPlainQnVectorsRecord();
+  }
+
+  if (fNoOfIndependentConfigurations < fScheduledConfigurations->GetEntriesFast()) {
+    fConfigurationsExecutor->Foreach([this](Int_t ixConfiguration) {
+      ((QnCorrectionsDetectorConfigurationBase *) fScheduledConfigurations->At(ixConfiguration))->ProcessDataCollection(fDataContainer);
+    }, ROOT::TSeqI(fNoOfIndependentConfigurations, fScheduledConfigurations->GetEntriesFast()));
+  }
+#endif // R__USE_IMT
+}
+
+/// Apply the correction steps to the current event concurrently among detector configurations
+///
+/// The corrections of a detector configuration only involve its own Qn vectors
+/// so, all detector configurations can be processed concurrently.
+void QnCorrectionsManager::ProcessCorrectionsConcurrently() {
+#ifdef R__USE_IMT
+  PrimeEventClassVariables();
+  fConfigurationsExecutor->Foreach([this](Int_t ixConfiguration) {
+    ((QnCorrectionsDetectorConfigurationBase *) fScheduledConfigurations->At(ixConfiguration))->ProcessCorrections(fDataContainer);
+  }, ROOT::TSeqI(fScheduledConfigurations->GetEntriesFast()));
+#endif // R__USE_IMT
+}
+
+/// Collect the correction steps data for the current event concurrently among detector configurations
+///
+/// The corrections of all detector configurations are already processed
+/// so, all detector configurations can be processed concurrently.
+void QnCorrectionsManager::ProcessDataCollectionConcurrently() {
+#ifdef R__USE_IMT
+  fConfigurationsExecutor->Foreach([this](Int_t ixConfiguration) {
+    ((QnCorrectionsDetectorConfigurationBase *) fScheduledConfigurations->At(ixConfiguration))->ProcessDataCollection(fDataContainer);
+  }, ROOT::TSeqI(fScheduledConfigurations->GetEntriesFast()));
+#endif // R__USE_IMT
 }
 
 /// Set the name of the list that should be considered as assigned to the current process
@@ -395,8 +953,11 @@ void QnCorrectionsManager::SetCurrentProcessListName(const char *name) {
         }
       }
       else {
+        /* the hashed list must learn about the new name */
         TList *processList = (TList *) fSupportHistogramsList->FindObject((const char *)fProcessListName);
+        fSupportHistogramsList->Remove(processList);
         processList->SetName(name);
+        fSupportHistogramsList->Add(processList);
       }
 
       /* now get the process list on the calibration histograms list if any */
@@ -420,7 +981,7 @@ void QnCorrectionsManager::SetCurrentProcessListName(const char *name) {
       /* build the Qn vectors list  now that all histograms are loaded */
       if (fQnVectorList == NULL) {
         /* first we build it if it isn't already there */
-        fQnVectorList = new TList();
+        fQnVectorList = new THashList(TCollection::kInitHashTableCapacity, 2);
         /* the list does not own the Qn vectors */
         fQnVectorList->SetOwner(kFALSE);
       }
@@ -429,6 +990,11 @@ void QnCorrectionsManager::SetCurrentProcessListName(const char *name) {
       for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
         ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->IncludeQnVectors(fQnVectorList);
       }
+
+      /* and rebuild the Qn vector tree if it is still possible */
+      if (GetShouldFillQnVectorTree()) {
+        CreateQnVectorTree();
+      }
     }
     else {
       /* histograms list not yet created so, we just change the name */
@@ -439,6 +1005,9 @@ void QnCorrectionsManager::SetCurrentProcessListName(const char *name) {
     QnCorrectionsInfo(Form("Changing process on the fly from %s to %s", fProcessListName.Data(), name));
 
     if (fSupportHistogramsList != NULL) {
+      /* the accumulated contents belong to the previous process */
+      FlushHistograms();
+
       /* check the list of concurrent processes */
       if (fProcessesNames != NULL && fProcessesNames->GetEntries() != 0) {
         /* the new process name should be in the list of processes names */
@@ -449,7 +1018,7 @@ void QnCorrectionsManager::SetCurrentProcessListName(const char *name) {
           fSupportHistogramsList->RemoveAt(finalindex);
           delete previous;
           /* and build a new one in its place */
-          TList *newList = new TList();
+          TList *newList = new THashList(TCollection::kInitHashTableCapacity, 2);
           newList->SetName(name);
           newList->SetOwner(kTRUE);
           /* build the support histograms list associated to the new process passing the new list to the detectors */
@@ -464,8 +1033,11 @@ void QnCorrectionsManager::SetCurrentProcessListName(const char *name) {
         }
       }
       else {
+        /* the hashed list must learn about the new name */
         TList *processList = (TList *) fSupportHistogramsList->FindObject((const char *)fProcessListName);
+        fSupportHistogramsList->Remove(processList);
         processList->SetName(name);
+        fSupportHistogramsList->Add(processList);
       }
 
       /* now get the process list on the calibration histograms list if any */
@@ -489,7 +1061,7 @@ void QnCorrectionsManager::SetCurrentProcessListName(const char *name) {
       /* build the Qn vectors list  now that all histograms are loaded */
       if (fQnVectorList == NULL) {
         /* first we build it if it isn't already there */
-        fQnVectorList = new TList();
+        fQnVectorList = new THashList(TCollection::kInitHashTableCapacity, 2);
         /* the list does not own the Qn vectors */
         fQnVectorList->SetOwner(kFALSE);
       }
@@ -498,6 +1070,11 @@ void QnCorrectionsManager::SetCurrentProcessListName(const char *name) {
       for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
         ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->IncludeQnVectors(fQnVectorList);
       }
+
+      /* and rebuild the Qn vector tree if it is still possible */
+      if (GetShouldFillQnVectorTree()) {
+        CreateQnVectorTree();
+      }
     }
     else {
       /* histograms list not yet created so, we just change the name */
@@ -505,8 +1082,21 @@ void QnCorrectionsManager::SetCurrentProcessListName(const char *name) {
     }
   }
 
+  /* transfer the new process name to the workers */
+  /* the support histograms could have been rebuilt so, share them again if requested */
+  if (fWorkers != NULL) {
+    for (Int_t ixWorker = 0; ixWorker < fWorkers->GetEntriesFast(); ixWorker++) {
+      ((QnCorrectionsManager *) fWorkers->At(ixWorker))->SetCurrentProcessListName(name);
+      if (fShareSupportHistograms && fSupportHistogramsList != NULL) {
+        ShareSupportHistograms((QnCorrectionsManager *) fWorkers->At(ixWorker));
+      }
+    }
+  }
+
   /* now that we have everything let's print the configuration before we start */
-  PrintFrameworkConfiguration();
+  if (fMasterManager == NULL) {
+    PrintFrameworkConfiguration();
+  }
 }
 
 /// Produce an understandable picture of current correction configuration
@@ -741,11 +1331,502 @@ void QnCorrectionsManager::PrintFrameworkConfiguration() const {
   delete detectorApplyingCorrectionsList;
 }
 
+/// Gets the memory of a memory report list
+/// \param list the memory report list
+/// \return the memory in bytes of the list entries and its nested lists
+static Long64_t GetMemoryListSize(const TList *list) {
+  Long64_t size = 0;
+  for (Int_t ixEntry = 0; ixEntry < list->GetEntries(); ixEntry++) {
+    TList *nestedList = dynamic_cast<TList *>(list->At(ixEntry));
+    if (nestedList != NULL)
+      size += GetMemoryListSize(nestedList);
+    else
+      size += ((TParameter<Long64_t> *) list->At(ixEntry))->GetVal();
+  }
+  return size;
+}
+
+/// Prints a memory report list
+/// \param list the memory report list
+/// \param level the nesting level of the list
+static void PrintMemoryList(const TList *list, Int_t level) {
+  for (Int_t ixEntry = 0; ixEntry < list->GetEntries(); ixEntry++) {
+    TString label = TString(' ', 2 * level) + list->At(ixEntry)->GetName();
+    TList *nestedList = dynamic_cast<TList *>(list->At(ixEntry));
+    Long64_t size = (nestedList != NULL) ? GetMemoryListSize(nestedList) : ((TParameter<Long64_t> *) list->At(ixEntry))->GetVal();
+    cout << Form("%-60s%14.1f kB", label.Data(), size / 1024.0) << endl;
+    if (nestedList != NULL) {
+      PrintMemoryList(nestedList, level + 1);
+    }
+  }
+}
+
+/// Builds the report on the memory taken by the framework
+///
+/// The report has a list per detector, a list per detector configuration
+/// within it and a list per correction step within the detector
+/// configuration one. The memory taken by each category of structures,
+/// support, QA and non validated entries QA histograms, calibration
+/// inputs and their derived tables, and data vector banks, is kept as a
+/// Long64_t TParameter, in bytes, named after the category. The report
+/// of each worker, if any, is incorporated as an additional list. Support
+/// histograms shared with the framework manager are only accounted there.
+///
+/// The caller takes the ownership of the report
+/// \return the memory report list
+TList *QnCorrectionsManager::GetMemoryReport() const {
+  TList *report = new TList();
+  report->SetOwner(kTRUE);
+  report->SetName("Framework memory");
+
+  for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
+    ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->ReportOnMemory(report);
+  }
+
+  if (fWorkers != NULL) {
+    for (Int_t ixWorker = 0; ixWorker < fWorkers->GetEntriesFast(); ixWorker++) {
+      TList *workerReport = ((QnCorrectionsManager *) fWorkers->At(ixWorker))->GetMemoryReport();
+      workerReport->SetName(Form("Worker %d", ixWorker));
+      report->Add(workerReport);
+    }
+  }
+  return report;
+}
+
+/// Prints the report on the memory taken by the framework
+///
+/// The memory of each detector, detector configuration, correction
+/// step and category is printed with the overall framework one.
+void QnCorrectionsManager::PrintMemoryReport() const {
+  TList *report = GetMemoryReport();
+
+  cout << Form("%-60s%14.1f kB", "FLOW VECTOR FRAMEWORK MEMORY", GetMemoryListSize(report) / 1024.0) << endl;
+  PrintMemoryList(report, 1);
+
+  delete report;
+}
+
+/// Builds the processing timing histograms of the framework instance
+///
+/// The report has a list for the framework manager and a list per
+/// detector with a list per detector configuration within it. Each of
+/// them holds two histograms, with a bin per timed unit, one with the
+/// time spent, in seconds, and the other with the number of calls.
+///
+/// The caller takes the ownership of the report
+/// \return the processing timing histograms list
+TList *QnCorrectionsManager::GetTimingReport() const {
+  TList *report = new TList();
+  report->SetOwner(kTRUE);
+  report->SetName(szTimingHistogramsKeyName);
+
+  TH1D *time = new TH1D("Framework_ProcessingTime", "Framework processing time;;time (s)", TIMING_NoOfUnits, 0.0, TIMING_NoOfUnits);
+  TH1D *calls = new TH1D("Framework_ProcessingCalls", "Framework processing calls;;calls", TIMING_NoOfUnits, 0.0, TIMING_NoOfUnits);
+  time->SetDirectory(NULL);
+  calls->SetDirectory(NULL);
+  for (Int_t unit = 0; unit < TIMING_NoOfUnits; unit++) {
+    time->GetXaxis()->SetBinLabel(unit + 1, szTimingUnitNames[unit]);
+    time->SetBinContent(unit + 1, fProcessingTime[unit] * 1e-9);
+    calls->GetXaxis()->SetBinLabel(unit + 1, szTimingUnitNames[unit]);
+    calls->SetBinContent(unit + 1, fProcessingCalls[unit]);
+  }
+  TList *managerList = new TList();
+  managerList->SetOwner(kTRUE);
+  managerList->SetName("Framework");
+  managerList->Add(time);
+  managerList->Add(calls);
+  report->Add(managerList);
+
+  for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
+    ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->ReportOnTiming(report);
+  }
+  return report;
+}
+
+/// Prints a processing timing histograms list
+///
+/// For the lists which hold timing histograms the timed units with
+/// calls are printed, the remaining lists are traversed.
+/// \param list the processing timing histograms list
+/// \param level the nesting level of the list
+static void PrintTimingList(const TList *list, Int_t level) {
+  for (Int_t ixEntry = 0; ixEntry < list->GetEntries(); ixEntry++) {
+    TList *nestedList = (TList *) list->At(ixEntry);
+    cout << TString(' ', 2 * level) + nestedList->GetName() << endl;
+    TH1 *time = dynamic_cast<TH1 *>(nestedList->First());
+    if (time != NULL) {
+      TH1 *calls = (TH1 *) nestedList->At(1);
+      for (Int_t bin = 1; bin <= time->GetNbinsX(); bin++) {
+        Double_t nCalls = calls->GetBinContent(bin);
+        if (nCalls == 0) continue;
+        TString label = TString(' ', 2 * (level + 1)) + time->GetXaxis()->GetBinLabel(bin);
+        cout << Form("%-60s%14.0f%14.3f s%12.3f us", label.Data(),
+            nCalls, time->GetBinContent(bin), time->GetBinContent(bin) / nCalls * 1e6) << endl;
+      }
+    }
+    else {
+      PrintTimingList(nestedList, level + 1);
+    }
+  }
+}
+
+/// Prints the processing timing summary
+///
+/// For each timed unit of the framework manager, of each detector
+/// configuration and of each correction step the number of calls, the
+/// time spent and the time per call are printed.
+/// Only available after framework finalization
+void QnCorrectionsManager::PrintTimingReport() const {
+  if (fTimingHistogramsList == NULL) return;
+
+  cout << Form("%-60s%14s%16s%15s", "FLOW VECTOR FRAMEWORK PROCESSING TIME", "calls", "time", "per call") << endl;
+  PrintTimingList(fTimingHistogramsList, 1);
+}
+
+/// Merges the histograms of a list into the histograms of another one
+///
+/// Both lists are expected to have the same structure, as is the case
+/// for the lists of the manager and of its workers. The lists are
+/// traversed in order so that the merging result is reproducible.
+/// \param target the list whose histograms will incorporate the contributions
+/// \param source the list with the histograms to incorporate
+void QnCorrectionsManager::MergeHistogramsLists(TList *target, TList *source) const {
+  TIter nextTarget(target);
+  TIter nextSource(source);
+  TObject *targetObject;
+
+  while ((targetObject = nextTarget()) != NULL) {
+    TObject *sourceObject = nextSource();
+    if (sourceObject == NULL || !TString(targetObject->GetName()).EqualTo(sourceObject->GetName())) {
+      QnCorrectionsFatal(Form("Mismatch merging %s list at %s. FIX IT, PLEASE.",
+          target->GetName(),
+          targetObject->GetName()));
+      return;
+    }
+    if (targetObject->InheritsFrom("TList")) {
+      MergeHistogramsLists((TList *) targetObject, (TList *) sourceObject);
+    }
+    else if (targetObject->InheritsFrom("THnBase")) {
+      ((THnBase *) targetObject)->Add((THnBase *) sourceObject);
+    }
+    else if (targetObject->InheritsFrom("TH1")) {
+      ((TH1 *) targetObject)->Add((TH1 *) sourceObject);
+    }
+  }
+}
+
+/// Transfers the contents accumulated by the detectors to the
+/// support and QA histograms so that they can be written or merged
+void QnCorrectionsManager::FlushHistograms() {
+  for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
+    ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->FlushHistograms();
+  }
+}
+
+/// Resets the histograms of a list and of its sublists
+/// \param list the histograms list
+void QnCorrectionsManager::ResetHistogramsList(TList *list) const {
+  TIter next(list);
+  TObject *object;
+
+  while ((object = next()) != NULL) {
+    if (object->InheritsFrom("TList")) {
+      ResetHistogramsList((TList *) object);
+    }
+    else if (object->InheritsFrom("THnBase")) {
+      ((THnBase *) object)->Reset();
+    }
+    else if (object->InheritsFrom("TH1")) {
+      ((TH1 *) object)->Reset();
+    }
+  }
+}
+
+/// Sets the buffered events to process
+///
+/// Intended for processing again events buffered by a previous job
+/// and stored in a local file. The buffer should have been produced
+/// by a framework with the same detector configurations. The manager
+/// takes the buffer ownership.
+/// \param buffer the event buffer
+void QnCorrectionsManager::SetEventBuffer(QnCorrectionsEventBuffer *buffer) {
+  if (fEventBuffer != NULL && fEventBuffer != buffer) delete fEventBuffer;
+  fEventBuffer = buffer;
+  /* the layout will be checked again */
+  if (fBufferedConfigurations != NULL) {
+    delete fBufferedConfigurations;
+    fBufferedConfigurations = NULL;
+  }
+}
+
+/// Builds the detector configurations array the event buffer is addressed with
+///
+/// If the event buffer is empty its layout is established: the
+/// event level variables and the whole set of detector configurations.
+/// Otherwise its layout is checked against the detector configurations.
+void QnCorrectionsManager::BuildEventBufferLayout() {
+  TList configurations;
+  configurations.SetOwner(kFALSE);
+  for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
+    ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->FillDetectorConfigurationsList(&configurations);
+  }
+  fBufferedConfigurations = new TObjArray(configurations.GetEntries());
+  fBufferedConfigurations->SetOwner(kFALSE);
+  for (Int_t ixConfiguration = 0; ixConfiguration < configurations.GetEntries(); ixConfiguration++) {
+    fBufferedConfigurations->Add(configurations.At(ixConfiguration));
+  }
+
+  if (fEventBuffer->GetEntries() == 0) {
+    fEventBuffer->SetLayout(fEventLevelVariablesMap, nMaxNoOfDataVariables, fBufferedConfigurations->GetEntriesFast());
+  }
+  else if (fEventBuffer->GetNoOfConfigurations() != fBufferedConfigurations->GetEntriesFast()) {
+    QnCorrectionsFatal(Form("The event buffer holds %d detector configurations per event while the framework has %d. FIX IT, PLEASE.",
+        fEventBuffer->GetNoOfConfigurations(),
+        fBufferedConfigurations->GetEntriesFast()));
+  }
+}
+
+/// Stores the current event input in the event buffer
+///
+/// The event level variables values and the data vectors accepted by
+/// each detector configuration are recorded. The event is not processed.
+/// As for a processed event, ClearEvent must be called before starting
+/// with the next one.
+void QnCorrectionsManager::BufferEvent() {
+  StopIngestionTiming();
+  if (fEventBuffer == NULL) {
+    fEventBuffer = new QnCorrectionsEventBuffer();
+  }
+  if (fBufferedConfigurations == NULL) {
+    BuildEventBufferLayout();
+  }
+  fEventBuffer->AddEvent(fDataContainer, fBufferedConfigurations);
+}
+
+/// Processes the buffered events
+///
+/// The buffered events are processed, as if they were just read,
+/// as many times as passes are requested. After each pass but the
+/// last one the support histograms become the calibration histograms
+/// for the next pass. Only the last pass is output to the Qn vector
+/// tree, kept in the QA histograms and, if requested, recorded as
+/// plain Qn vectors so that each buffered event is recorded once.
+/// The event buffer is kept so that it could be stored or processed again.
+///
+/// The workers input is attached to the calibration histograms
+/// which are replaced between passes so, the buffered events cannot
+/// be processed when workers have been created.
+/// \param nPasses the number of passes over the buffered events
+void QnCorrectionsManager::ProcessBufferedEvents(Int_t nPasses) {
+  if (fWorkers != NULL) {
+    QnCorrectionsError("The buffered events cannot be processed with workers. FIX IT, PLEASE.");
+    return;
+  }
+  if (fEventBuffer == NULL) {
+    QnCorrectionsError("There are no buffered events to process");
+    return;
+  }
+  if (fBufferedConfigurations == NULL) {
+    BuildEventBufferLayout();
+  }
+
+  /* just in case the last buffered event was not cleared */
+  ClearEvent();
+  for (Int_t ixPass = 0; ixPass < nPasses; ixPass++) {
+    Bool_t lastPass = (ixPass == (nPasses - 1));
+    QnCorrectionsInfo(Form("Processing %d buffered events, pass %d of %d", fEventBuffer->GetEntries(), ixPass + 1, nPasses));
+
+    /* only the last pass goes to the Qn vector tree and to the plain Qn vectors record */
+    TTree *qnVectorTree = fQnVectorTree;
+    QnCorrectionsQnVectorRecord *plainQnVectorsRecord = fPlainQnVectorsRecord;
+    if (!lastPass) {
+      fQnVectorTree = NULL;
+      fPlainQnVectorsRecord = NULL;
+    }
+    for (Int_t ixEvent = 0; ixEvent < fEventBuffer->GetEntries(); ixEvent++) {
+      fEventBuffer->GetEvent(ixEvent, fDataContainer, fBufferedConfigurations);
+      ProcessEvent();
+      ClearEvent();
+    }
+    fQnVectorTree = qnVectorTree;
+    fPlainQnVectorsRecord = plainQnVectorsRecord;
+
+    if (!lastPass) {
+      UseSupportHistogramsAsCalibration();
+    }
+  }
+}
+
+/// Replays Q vector level passes out of a plain Qn vectors record
+///
+/// The recorded events are processed as many times as passes are
+/// requested. For each event the event level variables and the plain
+/// Qn vectors of the detector configurations are restored and then
+/// only the Q vector correction steps are processed. After each pass
+/// but the last one the support histograms become the calibration
+/// histograms for the next pass. Only the last pass is output to the
+/// Qn vector tree and kept in the Q vector correction steps QA histograms.
+/// The input data correction steps are not involved so, their support
+/// histograms stay empty. The detector configurations QA histograms,
+/// i.e. the multiplicity and the plain Qn vector average ones, are not
+/// filled either because there are no data vectors to build them
+/// from. As for the buffered events, the recorded events
+/// cannot be replayed when workers have been created.
+/// \param tree the plain Qn vectors record tree
+/// \param nPasses the number of passes over the recorded events
+void QnCorrectionsManager::ReplayPlainQnVectors(TTree *tree, Int_t nPasses) {
+  if (fWorkers != NULL) {
+    QnCorrectionsError("The plain Qn vectors record cannot be replayed with workers. FIX IT, PLEASE.");
+    return;
+  }
+  TList configurations;
+  configurations.SetOwner(kFALSE);
+  for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
+    ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->FillDetectorConfigurationsList(&configurations);
+  }
+  QnCorrectionsQnVectorRecord record;
+  if (tree == NULL || !record.AttachTree(tree, fEventLevelVariablesMap, nMaxNoOfDataVariables, &configurations)) {
+    QnCorrectionsError("The plain Qn vectors record could not be replayed");
+    return;
+  }
+
+  const TObjArray *recordConfigurations = record.GetConfigurations();
+  ClearEvent();
+  for (Int_t ixPass = 0; ixPass < nPasses; ixPass++) {
+    Bool_t lastPass = (ixPass == (nPasses - 1));
+    QnCorrectionsInfo(Form("Replaying %lld recorded events, pass %d of %d", tree->GetEntries(), ixPass + 1, nPasses));
+
+    for (Long64_t entry = 0; entry < tree->GetEntries(); entry++) {
+      record.GetEntry(entry, fDataContainer);
+      for (Int_t ixConfiguration = 0; ixConfiguration < recordConfigurations->GetEntriesFast(); ixConfiguration++) {
+        ((QnCorrectionsDetectorConfigurationBase *) recordConfigurations->At(ixConfiguration))->ProcessQnVectorCorrections(fDataContainer);
+      }
+      /* only the last pass goes to the Qn vector tree */
+      if (lastPass && fQnVectorTree != NULL) {
+        FillQnVectorTree();
+      }
+      for (Int_t ixConfiguration = 0; ixConfiguration < recordConfigurations->GetEntriesFast(); ixConfiguration++) {
+        ((QnCorrectionsDetectorConfigurationBase *) recordConfigurations->At(ixConfiguration))->ProcessQnVectorDataCollection(fDataContainer);
+      }
+      ClearEvent();
+    }
+
+    if (!lastPass) {
+      UseSupportHistogramsAsCalibration();
+    }
+  }
+}
+
+/// Turns the current process support histograms into the calibration histograms
+///
+/// The accumulated contents are transferred to the support histograms
+/// of the current process which then replace the calibration histograms.
+/// New support histograms are built for the current process and the
+/// detectors attach their inputs out of the new calibration histograms.
+/// The QA histograms are reset and the Qn vector tree, as it could now
+/// include new Qn vectors, is rebuilt.
+void QnCorrectionsManager::UseSupportHistogramsAsCalibration() {
+  FlushHistograms();
+
+  /* the current process support histograms go to the new calibration histograms list */
+  TList *processList = (TList *) fSupportHistogramsList->FindObject((const char *) fProcessListName);
+  Int_t index = fSupportHistogramsList->IndexOf(processList);
+  fSupportHistogramsList->Remove(processList);
+  TList *calibrationList = new THashList(TCollection::kInitHashTableCapacity, 2);
+  calibrationList->SetName(szCalibrationHistogramsKeyName);
+  calibrationList->SetOwner(kTRUE);
+  calibrationList->Add(processList);
+
+  /* build the new support histograms for the current process */
+  TList *newList = new THashList(TCollection::kInitHashTableCapacity, 2);
+  newList->SetName((const char *) fProcessListName);
+  newList->SetOwner(kTRUE);
+  Bool_t retvalue = kTRUE;
+  for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
+    retvalue = retvalue && ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->CreateSupportHistograms(newList);
+    if (!retvalue)
+      break;
+  }
+  if (!retvalue) {
+    QnCorrectionsFatal("Failed to build the necessary support histograms.");
+  }
+  fSupportHistogramsList->AddAt(newList, index);
+
+  /* replace the calibration histograms list, there are no workers attached to it */
+  if (fCalibrationHistogramsList != NULL) delete fCalibrationHistogramsList;
+  fCalibrationHistogramsList = calibrationList;
+
+  /* now transfer the order to the defined detectors */
+  for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
+    ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->AttachCorrectionInputs(processList);
+  }
+  /* now inform to the defined detectors the framework conditions are complete */
+  for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
+    ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->AfterInputsAttachActions();
+  }
+
+  /* the QA histograms only keep the next pass */
+  if (fQAHistogramsList != NULL) {
+    ResetHistogramsList(fQAHistogramsList);
+  }
+  if (fNveQAHistogramsList != NULL) {
+    ResetHistogramsList(fNveQAHistogramsList);
+  }
+
+  /* the Qn vectors of the correction steps now applied */
+  for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
+    ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->IncludeQnVectors(fQnVectorList);
+  }
+  if (GetShouldFillQnVectorTree()) {
+    CreateQnVectorTree();
+  }
+}
 
 /// Produce the final output and release the framework.
+/// The accumulated contents are transferred to the histograms.
+/// The workers, if any, support and QA histograms are incorporated, in
+/// worker order, to the own ones.
 /// Produce the all data lists that collect data from all concurrent processes.
+/// If the processing was timed, the processing timing histograms are built,
+/// adding up the workers ones, and the timing summary is printed.
 void QnCorrectionsManager::FinalizeQnCorrectionsFramework() {
 
+  FlushHistograms();
+
+  if (fWorkers != NULL) {
+    for (Int_t ixWorker = 0; ixWorker < fWorkers->GetEntriesFast(); ixWorker++) {
+      QnCorrectionsManager *worker = (QnCorrectionsManager *) fWorkers->At(ixWorker);
+      worker->FlushHistograms();
+      MergeHistogramsLists(fSupportHistogramsList, worker->fSupportHistogramsList);
+      if (fQAHistogramsList != NULL) {
+        MergeHistogramsLists(fQAHistogramsList, worker->fQAHistogramsList);
+      }
+      if (fNveQAHistogramsList != NULL) {
+        MergeHistogramsLists(fNveQAHistogramsList, worker->fNveQAHistogramsList);
+      }
+      if (fQnVectorTree != NULL && worker->fQnVectorTree != NULL) {
+        worker->TransferQnVectorTree();
+      }
+      if (fPlainQnVectorsRecord != NULL && worker->fPlainQnVectorsRecord != NULL) {
+        worker->TransferPlainQnVectorsRecord();
+      }
+    }
+  }
+
+  if (GetShouldTimeProcessing()) {
+    /* a previous finalization report, if any, is replaced */
+    if (fTimingHistogramsList != NULL) delete fTimingHistogramsList;
+    fTimingHistogramsList = GetTimingReport();
+    if (fWorkers != NULL) {
+      for (Int_t ixWorker = 0; ixWorker < fWorkers->GetEntriesFast(); ixWorker++) {
+        TList *workerReport = ((QnCorrectionsManager *) fWorkers->At(ixWorker))->GetTimingReport();
+        MergeHistogramsLists(fTimingHistogramsList, workerReport);
+        delete workerReport;
+      }
+    }
+    PrintTimingReport();
+  }
+
   TList *processList = (TList *) fSupportHistogramsList->FindObject((const char *)fProcessListName);
   fSupportHistogramsList->Add(processList->Clone(szAllProcessesListName));
 }
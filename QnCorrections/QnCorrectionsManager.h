@@ -26,7 +26,9 @@
 /// the analysis phase.
 ///
 /// To improve performance a mapping between internal detector address
-/// and external detector id is maintained.
+/// and external detector id is maintained. Detectors, detector configurations
+/// and the framework histograms and Qn vectors lists are reached by name
+/// through hashed containers.
 ///
 /// When the framework is in the calibration phase there are no complete
 /// calibration information available to fully implement the desired
@@ -47,6 +49,88 @@
 /// different running instances. At merging time, only the contributions
 /// from instances of the same process must be merged.
 ///
+/// For multi-threaded event processing the manager, once configured, can
+/// be asked to create a number of worker instances. Each worker is a full
+/// copy of the configured framework with its own data variables bank,
+/// data vectors banks, Qn vectors and support and QA histograms but all
+/// of them share the read only input calibration histograms of the
+/// manager. Each worker is intended to be driven by a single thread, the
+/// same way as the manager itself is driven for single thread processing.
+/// At finalization time the workers support and QA histograms are merged,
+/// in worker order, into the manager ones. Multi-threaded usage of ROOT
+/// requires calling ROOT::EnableThreadSafety() before any worker is used.
+///
+/// When the memory taken by the support histograms copies is a concern,
+/// the workers can be asked to share the manager support histograms
+/// created for filling. The workers then accumulate their contents,
+/// under per bin locks, into the manager ones and only keep their own
+/// entries. Only the components, correlation components and channelized
+/// profiles are shared, the remaining ones are still merged.
+///
+/// Within each event, the detector configurations can be processed
+/// concurrently on the ROOT implicit multi-threading pool, if ROOT was
+/// built with it. At initialization time the manager derives the
+/// dependencies among detector configurations: the corrections of
+/// a configuration only involve its own Qn vectors, but the data
+/// collection of some correction steps, alignment and twist and
+/// rescale, reads the current Qn vector of other reference detector
+/// configurations. Configurations with no references get their
+/// corrections and data collection processed in a single task while
+/// those with references get their data collection processed once
+/// all the corrections have been processed.
+///
+/// The detector configurations cuts on variables which are constant within
+/// the event are evaluated only once per event and detector configuration.
+/// The event class variables are always considered event level variables.
+/// Other event level variables can be declared with SetEventLevelVariable.
+///
+/// To run several calibration passes within a single job, the input of
+/// each event, i.e. the event level variables values and the data vectors
+/// accepted by each detector configuration, can be recorded with BufferEvent
+/// instead of being processed. ProcessBufferedEvents then processes the
+/// buffered events as many times as passes are requested. After each pass
+/// the support histograms it produced become the calibration histograms
+/// of the next one, so that the correction steps get promoted from
+/// calibration to apply as soon as their parameters are available, and
+/// new support histograms are built. The QA histograms, the Qn vector
+/// tree and the plain Qn vectors record only keep the last pass. The
+/// event buffer could be stored in a local file and passed back to the
+/// manager with SetEventBuffer.
+///
+/// The Q vector correction steps only need the plain Qn vectors and the
+/// event class variables. When requested, the event level variables and
+/// the plain Qn and Q2n vectors of every detector configuration are
+/// recorded event by event in a compact tree. ReplayPlainQnVectors then
+/// processes the Q vector correction steps out of such a tree, without
+/// any data vector, for the remaining calibration passes. The passes
+/// are chained the same way the buffered events ones are but only the
+/// Q vector correction steps QA histograms are filled.
+///
+/// When requested, the corrected Qn vectors are output event by event
+/// into a TTree with a flat columnar layout: for each detector configuration
+/// and each of its Qn vectors, i.e. the latest corrected one, the plain one
+/// and the one from each applied correction step, there are branches with the
+/// fixed size arrays of the X and Y components of the active harmonics, the
+/// number of elements, the sum of weights and the quality flag. The tree
+/// is attached to the directory passed with SetQnVectorTreeDirectory, which
+/// then owns it, or kept in memory and owned by the manager otherwise. The
+/// workers trees are always kept in memory but, each time they reach
+/// WORKERTREETRANSFERSIZE entries, their entries are transferred, under
+/// a lock shared with the manager filling, to the manager tree and the
+/// worker trees are reset. The remaining ones are transferred, in worker
+/// order, at finalization time. The workers plain Qn vectors records
+/// are handled in the same way.
+///
+/// When requested, the processing is timed with the steady clock. The
+/// time spent and the number of calls are accumulated for the processing
+/// and the data collection of each correction step, for the Qn vectors
+/// building and the own QA histograms filling of each detector configuration
+/// and for the data vectors ingestion and the event clearing. The ingestion
+/// is timed once per event, from its first data vector to its processing,
+/// buffering or clearing, so it also includes the user code in between.
+/// At finalization time the workers ones are added up to the manager ones,
+/// they are made available as a list of histograms and a summary is printed.
+///
 /// \author Jaap Onderwaater <jacobus.onderwaater@cern.ch>, GSI
 /// \author Ilya Selyuzhenkov <ilya.selyuzhenkov@gmail.com>, GSI
 /// \author Víctor González <victor.gonzalez@cern.ch>, UCM
@@ -55,8 +139,18 @@
 
 #include <TObject.h>
 #include <TList.h>
+#include <THashList.h>
+#include <THashTable.h>
 #include <TTree.h>
 #include "QnCorrectionsDetector.h"
+#include "QnCorrectionsQnVectorRecord.h"
+
+/// The number of entries a worker keeps in its output trees before transferring them to the manager ones
+#define WORKERTREETRANSFERSIZE 1000
+
+class TDirectory;
+class QnCorrectionsEventBuffer;
+namespace ROOT { class TThreadExecutor; }
 
 class QnCorrectionsManager : public TObject {
 public:
@@ -80,6 +174,46 @@ public:
   /// Enables disables the output of Qn vector on a TTree structure
   /// \param enable kTRUE for enabling Qn vector output into a TTree
   void SetShouldFillQnVectorTree(Bool_t enable = kTRUE) { fFillQnVectorTree = enable; }
+  /// Sets the directory the Qn vector tree will be attached to
+  /// Must be called before framework initialization. The directory takes
+  /// the tree ownership.
+  /// \param directory the directory, usually the output file
+  void SetQnVectorTreeDirectory(TDirectory *directory) { fQnVectorTreeDirectory = directory; }
+  /// Sets the basket size of the Qn vector tree branches
+  /// Must be called before framework initialization.
+  /// \param size the basket size in bytes
+  void SetQnVectorTreeBasketSize(Int_t size) { fQnVectorTreeBasketSize = size; }
+  /// Sets the compression settings of the Qn vector tree branches
+  /// Must be called before framework initialization.
+  /// \param settings the ROOT compression settings, algorithm * 100 + level. -1 for the directory ones
+  void SetQnVectorTreeCompressionSettings(Int_t settings) { fQnVectorTreeCompressionSettings = settings; }
+  /// Enables disables the record of the plain Qn vectors for replaying Q vector level passes
+  /// \param enable kTRUE for enabling the plain Qn vectors record
+  void SetShouldRecordPlainQnVectors(Bool_t enable = kTRUE) { fRecordPlainQnVectors = enable; }
+  /// Sets the directory the plain Qn vectors record tree will be attached to
+  /// Must be called before framework initialization. The directory takes
+  /// the tree ownership.
+  /// \param directory the directory, usually a local file
+  void SetPlainQnVectorsRecordDirectory(TDirectory *directory) { fPlainQnVectorsRecordDirectory = directory; }
+  /// Enables disables the concurrent processing of the detector configurations within each event
+  /// Must be called before framework initialization. Requires ROOT built with
+  /// implicit multi-threading support and ROOT::EnableImplicitMT() called.
+  /// \param enable kTRUE for enabling the concurrent processing
+  void SetShouldProcessConfigurationsConcurrently(Bool_t enable = kTRUE) { fProcessConfigurationsConcurrently = enable; }
+  /// Sets the number of worker instances to create at framework initialization
+  /// \param nWorkers the number of workers. Zero for single thread processing
+  void SetNoOfWorkers(Int_t nWorkers) { fNoOfWorkers = nWorkers; }
+  /// Enables disables the sharing of the manager support histograms by the workers
+  /// Must be called before framework initialization.
+  /// \param enable kTRUE for the workers filling the manager support histograms
+  void SetShouldShareSupportHistograms(Bool_t enable = kTRUE) { fShareSupportHistograms = enable; }
+  /// Enables disables the timing of the framework processing
+  /// Must be called before framework initialization.
+  /// \param enable kTRUE for accumulating the processing time
+  void SetShouldTimeProcessing(Bool_t enable = kTRUE) { fTimeProcessing = enable; }
+  void SetEventBuffer(QnCorrectionsEventBuffer *buffer);
+
+  void SetEventLevelVariable(Int_t varId);
 
   void AddDetector(QnCorrectionsDetector *detector);
 
@@ -88,9 +222,23 @@ public:
   QnCorrectionsDetectorConfigurationBase *FindDetectorConfiguration(const char *name) const;
 
 
+  /// Gets the number of worker instances
+  /// \return the number of workers
+  Int_t GetNoOfWorkers() const { return fNoOfWorkers; }
+  /// Gets a worker instance
+  /// Only available after framework initialization
+  /// \param ixWorker the index of the worker
+  /// \return the worker framework manager
+  QnCorrectionsManager *GetWorker(Int_t ixWorker) const
+  { return (QnCorrectionsManager *) fWorkers->At(ixWorker); }
+
   /// Gets a pointer to the data variables bank
   /// \return the pointer to the data container
   Float_t *GetDataContainer() { return fDataContainer; }
+  /// Gets the flags for the variables constant within the event
+  /// Only available after framework initialization
+  /// \return the flags addressed by var Id
+  const Bool_t *GetEventLevelVariablesMap() const { return fEventLevelVariablesMap; }
 
   /// Get whether the output histograms should be filled
   /// \return kTRUE if the output histograms should be filled
@@ -104,6 +252,15 @@ public:
   /// Get whether the Qn vector tree should be populated
   /// \return kTRUE if the Qn vector should be written into a TTree
   Bool_t GetShouldFillQnVectorTree() const { return fFillQnVectorTree; }
+  /// Get whether the detector configurations are processed concurrently within each event
+  /// \return kTRUE if the detector configurations are processed concurrently
+  Bool_t GetShouldProcessConfigurationsConcurrently() const { return fProcessConfigurationsConcurrently; }
+  /// Gets if the workers share the manager support histograms
+  /// \return kTRUE if the workers fill the manager support histograms
+  Bool_t GetShouldShareSupportHistograms() const { return fShareSupportHistograms; }
+  /// Gets if the framework processing is timed
+  /// \return kTRUE if the processing time is accumulated
+  Bool_t GetShouldTimeProcessing() const { return fTimeProcessing; }
   /// Gets the output histograms list
   /// \return the list of histograms for building correction parameters
   TList *GetOutputHistogramsList() const { return fSupportHistogramsList; }
@@ -113,9 +270,24 @@ public:
   /// Gets the non validated entries QA histograms list
   /// \return the list of QA histograms
   TList *GetNveQAHistogramsList() const { return fNveQAHistogramsList; }
+  /// Gets the processing timing histograms list
+  /// Only available after framework finalization
+  /// The list is owned by the framework manager
+  /// \return the list of processing timing histograms, NULL if the processing was not timed
+  TList *GetTimingHistogramsList() const { return fTimingHistogramsList; }
   /// Gets the Qn vector tree
   /// \return the tree of histograms for building correction parameters
   TTree *GetQnVectorTree() const { return fQnVectorTree; }
+  /// Gets whether the plain Qn vectors are recorded
+  /// \return kTRUE if the plain Qn vectors are recorded
+  Bool_t GetShouldRecordPlainQnVectors() const { return fRecordPlainQnVectors; }
+  /// Gets the plain Qn vectors record tree
+  /// \return the record tree, NULL if the plain Qn vectors are not recorded
+  TTree *GetPlainQnVectorsRecordTree() const
+  { return (fPlainQnVectorsRecord != NULL) ? fPlainQnVectorsRecord->GetTree() : NULL; }
+  /// Gets the buffered events
+  /// \return the event buffer, NULL if no event was buffered
+  QnCorrectionsEventBuffer *GetEventBuffer() const { return fEventBuffer; }
   /// Gets the Qn vector tree
   /// \return the list of detector configurations Qn vectors
   TList *GetQnVectorList() const { return fQnVectorList; }
@@ -136,14 +308,58 @@ public:
 
 
   void PrintFrameworkConfiguration() const;
+  TList *GetMemoryReport() const;
+  void PrintMemoryReport() const;
+  void PrintTimingReport() const;
   void InitializeQnCorrectionsFramework();
   Int_t AddDataVector(Int_t detectorId, Double_t phi, Double_t weight = 1.0, Int_t channelId = -1);
+  Int_t AddDataVectors(Int_t detectorId, const Float_t *phi, const Float_t *weight, const Int_t *channelId, Int_t n, Int_t stride = 0);
+  Int_t AddChannelsAmplitudes(Int_t detectorId, const Float_t *amplitude);
   const char *GetAcceptedDataDetectorConfigurationName(Int_t detectorId, Int_t index) const;
   void ProcessEvent();
+  void ProcessCorrections();
+  void ProcessDataCollection();
   void ClearEvent();
+  void BufferEvent();
+  void ProcessBufferedEvents(Int_t nPasses = 1);
+  void ReplayPlainQnVectors(TTree *tree, Int_t nPasses = 1);
   void FinalizeQnCorrectionsFramework();
 
 private:
+  /// \typedef QnManagerTimingUnit
+  /// \brief The framework manager processing units which are timed
+  typedef enum {
+    TIMING_ingestion,            ///< the data vectors ingestion
+    TIMING_clearEvent,           ///< the event clearing
+    TIMING_NoOfUnits             ///< the number of timed units
+  } QnManagerTimingUnit;
+
+  void CreateWorkers();
+  void ShareSupportHistograms(QnCorrectionsManager *worker);
+  void MergeHistogramsLists(TList *target, TList *source) const;
+  void FlushHistograms();
+  void ResetHistogramsList(TList *list) const;
+  void BuildEventBufferLayout();
+  void UseSupportHistogramsAsCalibration();
+  void CreateQnVectorTree();
+  void FillQnVectorTree();
+  void UpdateQnVectorTreeBuffers();
+  void FillSharedQnVectorTree();
+  void TransferQnVectorTree();
+  void FillPlainQnVectorsRecord();
+  void FillSharedPlainQnVectorsRecord();
+  void TransferPlainQnVectorsRecord();
+  void BuildConfigurationsSchedule();
+  void PrimeEventClassVariables();
+  void ProcessEventConcurrently();
+  void ProcessCorrectionsConcurrently();
+  void ProcessDataCollectionConcurrently();
+  Long64_t StartTiming() const;
+  void StopTiming(QnManagerTimingUnit unit, Long64_t start);
+  void StartIngestionTiming();
+  void StopIngestionTiming();
+  TList *GetTimingReport() const;
+
   static const Int_t nMaxNoOfDetectors;              ///< the highest detector id currently supported by the framework
   static const Int_t nMaxNoOfDataVariables;          ///< the maximum number of variables currently supported by the framework
   static const char *szCalibrationHistogramsKeyName; ///< the name of the key under which calibration histograms lists are stored
@@ -151,9 +367,17 @@ private:
   static const char *szCalibrationNveQAHistogramsKeyName; ///< the name of the key under which non validated calibration entries QA histograms lists are stored
   static const char *szDummyProcessListName;         ///< accepted temporary name before getting the definitive one
   static const char *szAllProcessesListName;         ///< the name of the list that collects data from all concurrent processes
-  TList fDetectorsSet;                  ///< the list of detectors
+  static const char *szQnVectorTreeName;             ///< the name of the Qn vector tree
+  static const char *szTimingHistogramsKeyName;      ///< the name of the processing timing histograms list
+  static const char *szTimingUnitNames[TIMING_NoOfUnits]; ///< the names of the timed units
+  THashList fDetectorsSet;              ///< the list of detectors
+  THashTable fConfigurationsRegistry;   //!<! the detector configurations by name
   QnCorrectionsDetector **fDetectorsIdMap; //!<! map between external detector Id and internal detector
   Float_t *fDataContainer;              //!<! the data variables bank
+  Int_t fNoOfEventLevelVariables;       ///< the number of variables declared as event level ones
+  /// array, the Ids of the variables declared as event level ones
+  Int_t *fEventLevelVariables;          //[fNoOfEventLevelVariables]
+  Bool_t *fEventLevelVariablesMap;      //!<! flags, addressed by var Id, for the event level variables
   TList *fCalibrationHistogramsList;    ///< the list of the input calibration histograms
   TList *fSupportHistogramsList;        //!<! the list of the support histograms
   TList *fQAHistogramsList;             //!<! the list of QA histograms
@@ -164,8 +388,38 @@ private:
   Bool_t fFillQAHistograms;             ///< kTRUE if QA histograms must be filled
   Bool_t fFillNveQAHistograms;          ///< kTRUE if non validated entries QA histograms must be filled
   Bool_t fFillQnVectorTree;             ///< kTRUE if Qn vectors must be written in a TTree structure
+  Int_t fQnVectorTreeBasketSize;        ///< the basket size of the Qn vector tree branches
+  Int_t fQnVectorTreeCompressionSettings; ///< the compression settings of the Qn vector tree branches
+  TDirectory *fQnVectorTreeDirectory;   //!<! the directory the Qn vector tree is attached to
+  Int_t fQnVectorTreeNoOfQnVectors;     //!<! the number of Qn vectors output in the tree
+  QnCorrectionsQnVector **fQnVectorTreeQnVectors; //!<! the Qn vectors output in the tree
+  Int_t *fQnVectorTreeOffset;           //!<! the position of the first harmonic of each Qn vector in the harmonics array
+  Int_t *fQnVectorTreeHarmonics;        //!<! the active harmonics of each Qn vector
+  Float_t *fQnVectorTreeComponents;     //!<! the Qx, Qy branches buffer, twice the harmonics array size
+  Int_t *fQnVectorTreeN;                //!<! the number of elements branches buffer
+  Float_t *fQnVectorTreeSumW;           //!<! the sum of weights branches buffer
+  Bool_t *fQnVectorTreeGood;            //!<! the quality flag branches buffer
+  Bool_t fRecordPlainQnVectors;         ///< kTRUE if the plain Qn vectors must be recorded for replaying
+  TDirectory *fPlainQnVectorsRecordDirectory; //!<! the directory the plain Qn vectors record tree is attached to
+  QnCorrectionsQnVectorRecord *fPlainQnVectorsRecord; //!<! the plain Qn vectors record
+  Bool_t fProcessConfigurationsConcurrently; ///< kTRUE if the detector configurations are processed concurrently within each event
+  TObjArray *fScheduledConfigurations;  //!<! the detector configurations, the ones without references first
+  Int_t fNoOfIndependentConfigurations; //!<! the number of detector configurations without references
+  TObjArray *fEventClassVariables;      //!<! the event class variables involved in the detector configurations
+  ROOT::TThreadExecutor *fConfigurationsExecutor; //!<! the executor for the concurrent processing of detector configurations
   TString fProcessListName;             ///< the name of the list associated to the current process
   TObjArray *fProcessesNames;           ///< array with the list of processes names
+  Int_t fNoOfWorkers;                   //!<! the number of worker instances to create
+  TObjArray *fWorkers;                  //!<! the worker instances
+  Bool_t fShareSupportHistograms;       //!<! kTRUE if the workers fill the manager support histograms
+  QnCorrectionsManager *fMasterManager; //!<! the manager this instance is a worker of
+  QnCorrectionsEventBuffer *fEventBuffer; //!<! the buffered events input
+  TObjArray *fBufferedConfigurations;   //!<! the detector configurations in the event buffer order
+  Bool_t fTimeProcessing;               ///< kTRUE if the processing time must be accumulated
+  Long64_t fProcessingTime[TIMING_NoOfUnits];  //!<! the time spent in each timed unit, ns
+  Long64_t fProcessingCalls[TIMING_NoOfUnits]; //!<! the number of calls of each timed unit
+  Long64_t fIngestionStart;             //!<! the time stamp of the current event first data vector, zero if none
+  TList *fTimingHistogramsList;         //!<! the list of processing timing histograms
 
 private:
   /// Copy constructor
@@ -176,7 +430,7 @@ private:
   QnCorrectionsManager& operator= (const QnCorrectionsManager &);
 
 /// \cond CLASSIMP
-  ClassDef(QnCorrectionsManager, 5);
+  ClassDef(QnCorrectionsManager, 14);
 /// \endcond
 };
 
@@ -189,9 +443,56 @@ private:
 /// \param channelId the channel Id that originates the data vector
 /// \return the number of detector configurations that accepted and stored the data vector
 inline Int_t QnCorrectionsManager::AddDataVector(Int_t detectorId, Double_t phi, Double_t weight, Int_t channelId) {
+  StartIngestionTiming();
   return fDetectorsIdMap[detectorId]->AddDataVector(fDataContainer, phi, weight, channelId);
 }
 
+/// New set of data vectors for the framework
+/// The request is transmitted to the passed detector together with
+/// the current content of the variable bank. The detector configurations
+/// cuts are evaluated once for the whole set so, the variable bank content
+/// must be valid for all the data vectors in the set. This includes the
+/// variables of the data vector level cuts, e.g. the track kinematics or
+/// charge, which are not evaluated for each data vector. Data vectors
+/// that do not share those values must be passed one by one with
+/// AddDataVector.
+///
+/// The data vectors can be passed as contiguous arrays or directly from
+/// an array of user structures, e.g. for the tracks of a user track
+/// structure already selected by the user and grouped by charge
+///
+///     QnMan->GetDataContainer()[kCharge] = 1;
+///     QnMan->AddDataVectors(kTPC, &positiveTracks[0].phi, &positiveTracks[0].weight, NULL, nPositiveTracks, sizeof(MyTrack));
+///
+/// \param detectorId id of the involved detector
+/// \param phi array of azimuthal angles
+/// \param weight array of data vector weights. NULL for unit weights
+/// \param channelId array of channel Ids that originate the data vectors. Could be NULL for track detectors
+/// \param n the number of data vectors
+/// \param stride the distance in bytes between consecutive elements. Zero for contiguous arrays
+/// \return the overall number of data vectors stored by the detector configurations
+inline Int_t QnCorrectionsManager::AddDataVectors(Int_t detectorId,
+    const Float_t *phi, const Float_t *weight, const Int_t *channelId, Int_t n, Int_t stride) {
+  StartIngestionTiming();
+  return fDetectorsIdMap[detectorId]->AddDataVectors(fDataContainer, phi, weight, channelId, n, stride);
+}
+
+/// New set of amplitudes for all the channels of a detector
+/// The request is transmitted to the passed detector together with
+/// the current content of the variable bank. Only the channelized
+/// detector configurations which have been provided with the azimuthal
+/// angle of each channel store the amplitudes of their used channels, e.g.
+///
+///     QnMan->AddChannelsAmplitudes(kVZERO, multiplicity);
+///
+/// \param detectorId id of the involved detector
+/// \param amplitude array with the amplitude of each detector channel
+/// \return the overall number of data vectors stored by the detector configurations
+inline Int_t QnCorrectionsManager::AddChannelsAmplitudes(Int_t detectorId, const Float_t *amplitude) {
+  StartIngestionTiming();
+  return fDetectorsIdMap[detectorId]->AddChannelsAmplitudes(fDataContainer, amplitude);
+}
+
 /// Gets the name of the detector configuration at index that accepted last data vector
 /// \param detectorId id of the involved detector
 /// \param index the position in the list of accepted data vector configuration
@@ -208,11 +509,95 @@ inline const char *QnCorrectionsManager::GetAcceptedDataDetectorConfigurationNam
 /// Must be called only when the whole data vectors for the event
 /// have been incorporated to the framework.
 inline void QnCorrectionsManager::ProcessEvent() {
-  for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
-    ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->ProcessCorrections(fDataContainer);
+  StopIngestionTiming();
+  if (fConfigurationsExecutor != NULL) {
+    ProcessEventConcurrently();
   }
-  for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
-    ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->ProcessDataCollection(fDataContainer);
+  else {
+    ProcessCorrections();
+    ProcessDataCollection();
+  }
+}
+
+/// Apply the correction steps to the current event
+///
+/// The request is transmitted to the different detectors.
+/// The first half of ProcessEvent, made available for
+/// separately instrumenting both phases.
+/// The corrected Qn vectors are output to the Qn vector tree if requested.
+inline void QnCorrectionsManager::ProcessCorrections() {
+  StopIngestionTiming();
+  if (fConfigurationsExecutor != NULL) {
+    ProcessCorrectionsConcurrently();
+  }
+  else {
+    for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
+      ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->ProcessCorrections(fDataContainer);
+    }
+  }
+  if (fQnVectorTree != NULL) {
+    FillQnVectorTree();
+  }
+  if (fPlainQnVectorsRecord != NULL) {
+    FillPlainQnVectorsRecord();
+  }
+}
+
+/// Outputs the current event Qn vectors into the Qn vector tree
+///
+/// The branches buffers are updated from the Qn vectors and
+/// a new tree entry is filled. When workers are involved the
+/// manager tree is shared with them.
+inline void QnCorrectionsManager::FillQnVectorTree() {
+  if ((fWorkers != NULL) || (fMasterManager != NULL)) {
+    FillSharedQnVectorTree();
+    return;
+  }
+  UpdateQnVectorTreeBuffers();
+  fQnVectorTree->Fill();
+}
+
+/// Records the current event plain Qn vectors
+///
+/// When workers are involved the manager record is shared with them.
+inline void QnCorrectionsManager::FillPlainQnVectorsRecord() {
+  if ((fWorkers != NULL) || (fMasterManager != NULL)) {
+    FillSharedPlainQnVectorsRecord();
+    return;
+  }
+  fPlainQnVectorsRecord->Fill(fDataContainer);
+}
+
+/// Updates the Qn vector tree branches buffers from the Qn vectors
+inline void QnCorrectionsManager::UpdateQnVectorTreeBuffers() {
+  for (Int_t ixQnVector = 0; ixQnVector < fQnVectorTreeNoOfQnVectors; ixQnVector++) {
+    const QnCorrectionsQnVector *qn = fQnVectorTreeQnVectors[ixQnVector];
+    Int_t first = fQnVectorTreeOffset[ixQnVector];
+    Int_t nHarmonics = fQnVectorTreeOffset[ixQnVector + 1] - first;
+    Float_t *qx = fQnVectorTreeComponents + 2 * first;
+    Float_t *qy = qx + nHarmonics;
+    for (Int_t ixHarmonic = 0; ixHarmonic < nHarmonics; ixHarmonic++) {
+      qx[ixHarmonic] = qn->Qx(fQnVectorTreeHarmonics[first + ixHarmonic]);
+      qy[ixHarmonic] = qn->Qy(fQnVectorTreeHarmonics[first + ixHarmonic]);
+    }
+    fQnVectorTreeN[ixQnVector] = qn->GetN();
+    fQnVectorTreeSumW[ixQnVector] = qn->GetSumOfWeights();
+    fQnVectorTreeGood[ixQnVector] = qn->IsGoodQuality();
+  }
+}
+
+/// Collect the correction steps data for the current event
+///
+/// The request is transmitted to the different detectors.
+/// Must be called after ProcessCorrections for the same event.
+inline void QnCorrectionsManager::ProcessDataCollection() {
+  if (fConfigurationsExecutor != NULL) {
+    ProcessDataCollectionConcurrently();
+  }
+  else {
+    for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
+      ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->ProcessDataCollection(fDataContainer);
+    }
   }
 }
 
@@ -222,9 +607,43 @@ inline void QnCorrectionsManager::ProcessEvent() {
 ///
 /// Must be called only at the end of each event to start processing the next one
 inline void QnCorrectionsManager::ClearEvent() {
+  StopIngestionTiming();
+  Long64_t start = StartTiming();
   for (Int_t ixDetector = 0; ixDetector < fDetectorsSet.GetEntries(); ixDetector++) {
     ((QnCorrectionsDetector *) fDetectorsSet.At(ixDetector))->ClearDetector();
   }
+  StopTiming(TIMING_clearEvent, start);
+}
+
+/// Gets the start time stamp of a timed unit
+/// \return the current time stamp if the processing is being timed, zero otherwise
+inline Long64_t QnCorrectionsManager::StartTiming() const {
+  return fTimeProcessing ? QnCorrectionsCorrectionStepBase::GetTimeStamp() : 0;
+}
+
+/// Accumulates the time spent in a timed unit if the processing is being timed
+/// \param unit the timed unit
+/// \param start the time stamp got when the unit started
+inline void QnCorrectionsManager::StopTiming(QnManagerTimingUnit unit, Long64_t start) {
+  if (fTimeProcessing) {
+    fProcessingTime[unit] += QnCorrectionsCorrectionStepBase::GetTimeStamp() - start;
+    fProcessingCalls[unit]++;
+  }
+}
+
+/// Keeps the time stamp of the first data vector of the current event if the processing is being timed
+inline void QnCorrectionsManager::StartIngestionTiming() {
+  if (fTimeProcessing && (fIngestionStart == 0)) {
+    fIngestionStart = QnCorrectionsCorrectionStepBase::GetTimeStamp();
+  }
+}
+
+/// Accumulates the data vectors ingestion time of the current event, if any
+inline void QnCorrectionsManager::StopIngestionTiming() {
+  if (fIngestionStart != 0) {
+    StopTiming(TIMING_ingestion, fIngestionStart);
+    fIngestionStart = 0;
+  }
 }
 
 #endif // QNCORRECTIONS_MANAGER_H
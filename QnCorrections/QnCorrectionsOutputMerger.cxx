@@ -0,0 +1,533 @@
+/**************************************************************************************************
+ *                                                                                                *
+ * Package:       FlowVectorCorrections                                                           *
+ * Authors:       Jaap Onderwaater, GSI, jacobus.onderwaater@cern.ch                              *
+ *                Ilya Selyuzhenkov, GSI, ilya.selyuzhenkov@gmail.com                             *
+ *                Víctor González, UCM, victor.gonzalez@cern.ch                                   *
+ *                Contributors are mentioned in the code where appropriate.                       *
+ * Development:   2012-2016                                                                       *
+ *                                                                                                *
+ * This file is part of FlowVectorCorrections, a software package that corrects Q-vector          *
+ * measurements for effects of nonuniform detector acceptance. The corrections in this package    *
+ * are based on publication:                                                                      *
+ *                                                                                                *
+ *  [1] "Effects of non-uniform acceptance in anisotropic flow measurements"                      *
+ *  Ilya Selyuzhenkov and Sergei Voloshin                                                         *
+ *  Phys. Rev. C 77, 034904 (2008)                                                                *
+ *                                                                                                *
+ * The procedure proposed in [1] is extended with the following steps:                            *
+ * (*) alignment correction between subevents                                                     *
+ * (*) possibility to extract the twist and rescaling corrections                                 *
+ *      for the case of three detector subevents                                                  *
+ *      (currently limited to the case of two “hit-only” and one “tracking” detectors)            *
+ * (*) (optional) channel equalization                                                            *
+ * (*) flow vector width equalization                                                             *
+ *                                                                                                *
+ * FlowVectorCorrections is distributed under the terms of the GNU General Public License (GPL)   *
+ * (https://en.wikipedia.org/wiki/GNU_General_Public_License)                                     *
+ * either version 3 of the License, or (at your option) any later version.                        *
+ *                                                                                                *
+ **************************************************************************************************/
+/// \file QnCorrectionsOutputMerger.cxx
+/// \brief Implementation of the merger of the output of several framework jobs
+
+#include <stdio.h>
+#include <TFile.h>
+#include <TKey.h>
+#include <TDirectory.h>
+#include <TObjString.h>
+#include <THashList.h>
+#include <TH1.h>
+#include <THn.h>
+#include <TROOT.h>
+#include <RConfigure.h>
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#include <ROOT/TSeq.hxx>
+#endif // R__USE_IMT
+#include "QnCorrectionsOutputMerger.h"
+#include "QnCorrectionsCalibrationList.h"
+#include "QnCorrectionsLog.h"
+
+/// \cond CLASSIMP
+ClassImp(QnCorrectionsOutputMerger);
+/// \endcond
+
+const Int_t QnCorrectionsOutputMerger::nMaxUnitDepth = 2;
+const char *QnCorrectionsOutputMerger::szRecursiveUnit = "recursive";
+const char *QnCorrectionsOutputMerger::szLooseObjectsUnit = "loose";
+const char *QnCorrectionsOutputMerger::szSingleKeyUnit = "singlekey";
+
+/// Default constructor
+QnCorrectionsOutputMerger::QnCorrectionsOutputMerger() : TObject(), fInputFiles(), fUnits() {
+  fInputFiles.SetOwner(kTRUE);
+  fUnits.SetOwner(kTRUE);
+  fNoOfThreads = 0;
+  fExecutor = NULL;
+}
+
+/// Default destructor
+QnCorrectionsOutputMerger::~QnCorrectionsOutputMerger() {
+#ifdef R__USE_IMT
+  if (fExecutor != NULL) delete fExecutor;
+#endif // R__USE_IMT
+}
+
+/// Adds a job output file to the set of files to merge
+/// \param fileName the name of the file
+void QnCorrectionsOutputMerger::AddInputFile(const char *fileName) {
+  fInputFiles.Add(new TObjString(fileName));
+}
+
+/// Adds the job output files from a text file
+///
+/// The text file should contain a file name per line. Empty lines
+/// and lines starting with # are ignored.
+/// \param listFileName the name of the text file
+/// \return the number of files added
+Int_t QnCorrectionsOutputMerger::AddInputFilesFromList(const char *listFileName) {
+  FILE *listFile = fopen(listFileName, "r");
+  if (listFile == NULL) {
+    QnCorrectionsError(Form("Cannot open the list of files %s", listFileName));
+    return 0;
+  }
+
+  Int_t nAdded = 0;
+  char line[4096];
+  while (fgets(line, sizeof(line), listFile) != NULL) {
+    TString fileName = line;
+    fileName = fileName.Strip(TString::kTrailing, '\n');
+    fileName = fileName.Strip(TString::kBoth);
+    if ((fileName.Length() == 0) || fileName.BeginsWith("#")) continue;
+    AddInputFile(fileName.Data());
+    nAdded++;
+  }
+  fclose(listFile);
+  return nAdded;
+}
+
+/// Merges the input files into the output file
+///
+/// The merging units are collected from all the input files and each
+/// of them is merged over the whole set of input files and stored in the
+/// output file before going to the next one. Units not present in some
+/// of the input files are merged over the files which contain them.
+/// \param outputFileName the name of the output file
+/// \return kTRUE if everything went right
+Bool_t QnCorrectionsOutputMerger::Merge(const char *outputFileName) {
+  if (fInputFiles.GetEntriesFast() == 0) {
+    QnCorrectionsError("No input files to merge");
+    return kFALSE;
+  }
+
+  /* the merging units out of all the input files */
+  fUnits.Delete();
+  Int_t nExplored = 0;
+  for (Int_t ixFile = 0; ixFile < fInputFiles.GetEntriesFast(); ixFile++) {
+    TFile *inputFile = TFile::Open(fInputFiles.At(ixFile)->GetName(), "READ");
+    if ((inputFile == NULL) || inputFile->IsZombie()) {
+      QnCorrectionsWarning(Form("Cannot open the input file %s. Ignored", fInputFiles.At(ixFile)->GetName()));
+      if (inputFile != NULL) delete inputFile;
+      continue;
+    }
+    TIter nextKey(inputFile->GetListOfKeys());
+    TKey *key;
+    while ((key = (TKey *) nextKey()) != NULL) {
+      TString className = key->GetClassName();
+      if (className.EqualTo("TDirectoryFile")) {
+        CollectUnits(inputFile->GetDirectory(key->GetName()), key->GetName(), 0);
+      }
+      else if (className.EqualTo("TList") || className.EqualTo("THashList")) {
+        AddUnit(key->GetName(), szSingleKeyUnit);
+      }
+      else if (ixFile == 0) {
+        QnCorrectionsWarning(Form("Object %s of class %s is not a histograms list. Ignored", key->GetName(), className.Data()));
+      }
+    }
+    inputFile->Close();
+    delete inputFile;
+    nExplored++;
+  }
+  if (nExplored == 0) {
+    QnCorrectionsError("None of the input files could be opened");
+    return kFALSE;
+  }
+
+  TFile *outputFile = TFile::Open(outputFileName, "RECREATE");
+  if ((outputFile == NULL) || outputFile->IsZombie()) {
+    QnCorrectionsError(Form("Cannot create the output file %s", outputFileName));
+    if (outputFile != NULL) delete outputFile;
+    return kFALSE;
+  }
+
+  Int_t nThreads = 1;
+#ifdef R__USE_IMT
+  if (fNoOfThreads != 1) {
+    /* each thread reads from its own input files */
+    ROOT::EnableThreadSafety();
+    fExecutor = new ROOT::TThreadExecutor(fNoOfThreads);
+    nThreads = fExecutor->GetPoolSize();
+  }
+#else
+  if (fNoOfThreads != 1) {
+    QnCorrectionsWarning("ROOT built without implicit multi-threading support. Merging sequentially");
+  }
+#endif // R__USE_IMT
+
+  Bool_t retvalue = kTRUE;
+  TIter nextUnit(&fUnits);
+  TNamed *unit;
+  while ((unit = (TNamed *) nextUnit()) != NULL) {
+    QnCorrectionsInfo(Form("Merging %s", unit->GetName()));
+    TList *merged = MergeUnit(unit, nThreads);
+    if (merged != NULL) {
+      retvalue = WriteUnit(merged, unit, outputFile) && retvalue;
+      delete merged;
+    }
+    else {
+      QnCorrectionsWarning(Form("%s not found in any of the input files", unit->GetName()));
+    }
+  }
+
+  outputFile->Close();
+  delete outputFile;
+#ifdef R__USE_IMT
+  if (fExecutor != NULL) delete fExecutor;
+  fExecutor = NULL;
+#endif // R__USE_IMT
+  fUnits.Delete();
+  return retvalue;
+}
+
+/// Collects the merging units of an indexed layout directory
+///
+/// A directory without subdirectories or deep enough within the layout
+/// is a merging unit. Otherwise its subdirectories are explored and its
+/// objects, if any, form a merging unit on their own.
+/// \param directory the directory to explore
+/// \param path the path of the directory within the file
+/// \param depth the depth of the directory within the layout
+void QnCorrectionsOutputMerger::CollectUnits(TDirectory *directory, const char *path, Int_t depth) {
+  Bool_t hasSubdirectories = kFALSE;
+  Bool_t hasObjects = kFALSE;
+
+  TIter nextKey(directory->GetListOfKeys());
+  TKey *key;
+  while ((key = (TKey *) nextKey()) != NULL) {
+    if (TString(key->GetClassName()).EqualTo("TDirectoryFile"))
+      hasSubdirectories = kTRUE;
+    else
+      hasObjects = kTRUE;
+  }
+
+  if (!hasSubdirectories || !(depth < nMaxUnitDepth)) {
+    AddUnit(path, szRecursiveUnit);
+    return;
+  }
+  if (hasObjects) {
+    AddUnit(path, szLooseObjectsUnit);
+  }
+
+  THashList explored;
+  explored.SetOwner(kFALSE);
+  nextKey.Reset();
+  while ((key = (TKey *) nextKey()) != NULL) {
+    if (!TString(key->GetClassName()).EqualTo("TDirectoryFile")) continue;
+    /* only once per directory, there could be several cycles */
+    if (explored.FindObject(key->GetName()) != NULL) continue;
+    explored.Add(key);
+    CollectUnits(directory->GetDirectory(key->GetName()), TString::Format("%s/%s", path, key->GetName()).Data(), depth + 1);
+  }
+}
+
+/// Adds a merging unit if not already collected
+///
+/// The same directory could be a unit with all its content in one
+/// input file and have subdirectories, which are units on their own,
+/// in another one. In that case the unit is restricted to the directory
+/// objects so that the subdirectories content is not merged twice.
+/// \param name the unit name
+/// \param type the unit type
+void QnCorrectionsOutputMerger::AddUnit(const char *name, const char *type) {
+  TNamed *unit = (TNamed *) fUnits.FindObject(name);
+  if (unit == NULL) {
+    fUnits.Add(new TNamed(name, type));
+    return;
+  }
+  if (TString(unit->GetTitle()).EqualTo(type)) return;
+  if (TString(unit->GetTitle()).EqualTo(szRecursiveUnit) && TString(type).EqualTo(szLooseObjectsUnit)) {
+    unit->SetTitle(szLooseObjectsUnit);
+  }
+  else if (!(TString(unit->GetTitle()).EqualTo(szLooseObjectsUnit) && TString(type).EqualTo(szRecursiveUnit))) {
+    QnCorrectionsWarning(Form("%s has a different layout across the input files. Only the %s layout is merged", name, unit->GetTitle()));
+  }
+}
+
+/// Merges a unit over the whole set of input files
+///
+/// The input files are split in as many slices as threads. Each slice
+/// is merged on its own partial list and then the partial lists are
+/// merged pairwise until only one is left.
+/// \param unit the merging unit
+/// \param nThreads the number of threads available
+/// \return the merged unit list, NULL if not found in any input file
+TList *QnCorrectionsOutputMerger::MergeUnit(const TNamed *unit, Int_t nThreads) const {
+  Int_t nFiles = fInputFiles.GetEntriesFast();
+  Int_t nSlices = (nThreads < nFiles) ? nThreads : nFiles;
+  if (nSlices < 1) nSlices = 1;
+
+  TList **partial = new TList *[nSlices];
+  for (Int_t ixSlice = 0; ixSlice < nSlices; ixSlice++) {
+    partial[ixSlice] = NULL;
+  }
+
+#ifdef R__USE_IMT
+  if ((fExecutor != NULL) && (1 < nSlices)) {
+    fExecutor->Foreach([this, unit, partial, nSlices](Int_t ixSlice) {
+      MergeSlice(unit, partial, ixSlice, nSlices);
+    }, ROOT::TSeqI(nSlices));
+    for (Int_t stride = 1; stride < nSlices; stride *= 2) {
+      Int_t nPairs = (nSlices - stride + 2 * stride - 1) / (2 * stride);
+      fExecutor->Foreach([this, partial, stride](Int_t ixPair) {
+        MergePair(partial, 2 * stride * ixPair, 2 * stride * ixPair + stride);
+      }, ROOT::TSeqI(nPairs));
+    }
+  }
+  else
+#endif // R__USE_IMT
+  {
+    for (Int_t ixSlice = 0; ixSlice < nSlices; ixSlice++) {
+      MergeSlice(unit, partial, ixSlice, nSlices);
+    }
+    for (Int_t stride = 1; stride < nSlices; stride *= 2) {
+      for (Int_t ixTarget = 0; ixTarget + stride < nSlices; ixTarget += 2 * stride) {
+        MergePair(partial, ixTarget, ixTarget + stride);
+      }
+    }
+  }
+
+  TList *merged = partial[0];
+  delete [] partial;
+  return merged;
+}
+
+/// Merges a unit over a slice of the input files
+///
+/// The files are read sequentially and their unit content accumulated
+/// on the slice partial list.
+/// \param unit the merging unit
+/// \param partial the partial lists
+/// \param ixSlice the slice to merge
+/// \param nSlices the number of slices
+void QnCorrectionsOutputMerger::MergeSlice(const TNamed *unit, TList **partial, Int_t ixSlice, Int_t nSlices) const {
+  Int_t nFiles = fInputFiles.GetEntriesFast();
+  Int_t first = (Int_t) ((Long64_t) ixSlice * nFiles / nSlices);
+  Int_t last = (Int_t) ((Long64_t) (ixSlice + 1) * nFiles / nSlices);
+
+  for (Int_t ixFile = first; ixFile < last; ixFile++) {
+    TList *list = ReadUnit(fInputFiles.At(ixFile)->GetName(), unit);
+    if (list == NULL) continue;
+    if (partial[ixSlice] == NULL) {
+      partial[ixSlice] = list;
+    }
+    else {
+      MergeLists(partial[ixSlice], list);
+      delete list;
+    }
+  }
+}
+
+/// Merges a partial list into another one
+///
+/// The source partial list is deleted once merged.
+/// \param partial the partial lists
+/// \param ixTarget the partial list to merge into
+/// \param ixSource the partial list to merge
+void QnCorrectionsOutputMerger::MergePair(TList **partial, Int_t ixTarget, Int_t ixSource) const {
+  if (partial[ixSource] == NULL) return;
+  if (partial[ixTarget] == NULL) {
+    partial[ixTarget] = partial[ixSource];
+  }
+  else {
+    MergeLists(partial[ixTarget], partial[ixSource]);
+    delete partial[ixSource];
+  }
+  partial[ixSource] = NULL;
+}
+
+/// Reads a merging unit from an input file
+///
+/// The file is opened and closed on each call so that no more
+/// than a file per thread is open at any time.
+/// \param fileName the name of the input file
+/// \param unit the merging unit
+/// \return the unit list, NULL if not found. The list owns its content
+TList *QnCorrectionsOutputMerger::ReadUnit(const char *fileName, const TNamed *unit) const {
+  TFile *file = TFile::Open(fileName, "READ");
+  if ((file == NULL) || file->IsZombie()) {
+    QnCorrectionsWarning(TString::Format("Cannot open the input file %s. Ignored", fileName).Data());
+    if (file != NULL) delete file;
+    return NULL;
+  }
+
+  TList *list = NULL;
+  if (TString(unit->GetTitle()).EqualTo(szSingleKeyUnit)) {
+    TKey *key = file->GetKey(unit->GetName());
+    if (key != NULL) {
+      TObject *obj = key->ReadObj();
+      if ((obj != NULL) && obj->InheritsFrom("TList")) {
+        list = QnCorrectionsCalibrationList::BuildHashedList((TList *) obj);
+        DetachHistograms(list);
+      }
+      else if (obj != NULL) {
+        delete obj;
+      }
+    }
+  }
+  else {
+    TDirectory *directory = file->GetDirectory(unit->GetName());
+    if (directory != NULL) {
+      list = ReadList(directory, TString(unit->GetTitle()).EqualTo(szRecursiveUnit));
+    }
+  }
+  if (list == NULL) {
+    QnCorrectionsWarning(TString::Format("%s not found in the input file %s. Ignored", unit->GetName(), fileName).Data());
+  }
+
+  file->Close();
+  delete file;
+  return list;
+}
+
+/// Stores a merged unit into the output file
+///
+/// The single key units are stored as a single key. For the indexed
+/// layout the unit path is created if needed and the unit content is
+/// stored within it with the indexed layout.
+/// \param list the merged unit list
+/// \param unit the merging unit
+/// \param output the output file
+/// \return kTRUE if everything went right
+Bool_t QnCorrectionsOutputMerger::WriteUnit(TList *list, const TNamed *unit, TDirectory *output) const {
+  if (TString(unit->GetTitle()).EqualTo(szSingleKeyUnit)) {
+    output->cd();
+    return (0 < list->Write(unit->GetName(), TObject::kSingleKey));
+  }
+
+  TDirectory *directory = output;
+  TObjArray *levels = TString(unit->GetName()).Tokenize("/");
+  for (Int_t ixLevel = 0; ixLevel < levels->GetEntriesFast(); ixLevel++) {
+    const char *name = levels->At(ixLevel)->GetName();
+    TDirectory *subdirectory = directory->GetDirectory(name);
+    if (subdirectory == NULL) subdirectory = directory->mkdir(name);
+    directory = subdirectory;
+    if (directory == NULL) break;
+  }
+  delete levels;
+  if (directory == NULL) {
+    QnCorrectionsError(Form("Cannot create %s in the output file", unit->GetName()));
+    return kFALSE;
+  }
+
+  TIter next(list);
+  TObject *obj;
+  while ((obj = next()) != NULL) {
+    if (obj->InheritsFrom("TList")) {
+      if (!QnCorrectionsCalibrationList::WriteIndexed((TList *) obj, directory))
+        return kFALSE;
+    }
+    else {
+      directory->WriteTObject(obj, obj->GetName());
+    }
+  }
+  return kTRUE;
+}
+
+/// Merges the content of a histograms list into another one
+///
+/// Objects are matched by name. Sublists are merged recursively and
+/// histograms are added. Objects not present in the target list are
+/// moved to it from the source list.
+/// \param target the list to merge into
+/// \param source the list to merge
+void QnCorrectionsOutputMerger::MergeLists(TList *target, TList *source) const {
+  TList missing;
+  missing.SetOwner(kFALSE);
+
+  TIter nextSource(source);
+  TObject *sourceObject;
+  while ((sourceObject = nextSource()) != NULL) {
+    TObject *targetObject = target->FindObject(sourceObject->GetName());
+    if (targetObject == NULL) {
+      missing.Add(sourceObject);
+    }
+    else if (targetObject->InheritsFrom("TList") && sourceObject->InheritsFrom("TList")) {
+      MergeLists((TList *) targetObject, (TList *) sourceObject);
+    }
+    else if (targetObject->InheritsFrom("THnBase") && sourceObject->InheritsFrom("THnBase")) {
+      ((THnBase *) targetObject)->Add((THnBase *) sourceObject);
+    }
+    else if (targetObject->InheritsFrom("TH1") && sourceObject->InheritsFrom("TH1")) {
+      ((TH1 *) targetObject)->Add((TH1 *) sourceObject);
+    }
+    else {
+      QnCorrectionsWarning(TString::Format("Mismatch merging %s list at %s. Ignored",
+          target->GetName(), sourceObject->GetName()).Data());
+    }
+  }
+
+  /* the objects not present in the target are moved to it */
+  TIter nextMissing(&missing);
+  while ((sourceObject = nextMissing()) != NULL) {
+    source->Remove(sourceObject);
+    target->Add(sourceObject);
+  }
+}
+
+/// Reads the content of an indexed layout directory into a list
+///
+/// Only the highest cycle of each key is read.
+/// \param directory the directory to read
+/// \param recursive kTRUE if the subdirectories should be read as sublists
+/// \return the list with the directory content. The list owns its content
+TList *QnCorrectionsOutputMerger::ReadList(TDirectory *directory, Bool_t recursive) {
+  THashList *list = new THashList(TCollection::kInitHashTableCapacity, 2);
+  list->SetName(directory->GetName());
+  list->SetOwner(kTRUE);
+
+  TIter nextKey(directory->GetListOfKeys());
+  TKey *key;
+  while ((key = (TKey *) nextKey()) != NULL) {
+    if (list->FindObject(key->GetName()) != NULL) continue;
+    if (TString(key->GetClassName()).EqualTo("TDirectoryFile")) {
+      if (recursive) {
+        list->Add(ReadList(directory->GetDirectory(key->GetName()), kTRUE));
+      }
+    }
+    else {
+      TObject *obj = key->ReadObj();
+      if (obj != NULL) {
+        /* histograms must not be owned by the file directory */
+        if (obj->InheritsFrom("TH1")) ((TH1 *) obj)->SetDirectory(NULL);
+        list->Add(obj);
+      }
+    }
+  }
+  return list;
+}
+
+/// Detaches the histograms of a list read at once from their file
+///
+/// The list and its sublists take the ownership of their content.
+/// \param list the list to detach
+void QnCorrectionsOutputMerger::DetachHistograms(TList *list) {
+  list->SetOwner(kTRUE);
+  TIter next(list);
+  TObject *obj;
+  while ((obj = next()) != NULL) {
+    if (obj->InheritsFrom("TList"))
+      DetachHistograms((TList *) obj);
+    else if (obj->InheritsFrom("TH1"))
+      ((TH1 *) obj)->SetDirectory(NULL);
+  }
+}
@@ -0,0 +1,110 @@
+#ifndef QNCORRECTIONS_OUTPUTMERGER_H
+#define QNCORRECTIONS_OUTPUTMERGER_H
+
+/***************************************************************************
+ * Package:       FlowVectorCorrections                                    *
+ * Authors:       Jaap Onderwaater, GSI, jacobus.onderwaater@cern.ch       *
+ *                Ilya Selyuzhenkov, GSI, ilya.selyuzhenkov@gmail.com      *
+ *                Víctor González, UCM, victor.gonzalez@cern.ch            *
+ *                Contributors are mentioned in the code where appropriate.*
+ * Development:   2012-2016                                                *
+ * See cxx source for GPL licence et. al.                                  *
+ ***************************************************************************/
+
+/// \file QnCorrectionsOutputMerger.h
+/// \brief Merger of the output of several framework jobs
+
+#include <TObject.h>
+#include <TObjArray.h>
+#include <TList.h>
+
+class TDirectory;
+namespace ROOT { class TThreadExecutor; }
+
+/// \class QnCorrectionsOutputMerger
+/// \brief Merges the support and QA histograms output of several jobs
+///
+/// The framework output is structured as lists of histograms lists:
+/// the support histograms list contains a list per process which in turn
+/// contains a list per detector configuration while the QA histograms
+/// lists contain a list per detector configuration. The merger takes
+/// advantage of that layout to merge one detector configuration list at
+/// a time so that the whole output of all jobs is never in memory at once.
+///
+/// Each merging unit is merged with a parallel reduction: each thread
+/// goes sequentially through a slice of the job files accumulating the
+/// unit content on its own partial list and the partial lists are then
+/// merged pairwise, in parallel, until only one is left. Each thread keeps
+/// then at most two copies of the unit in memory. The merged unit is stored
+/// in the output file before going to the next one.
+///
+/// Both the indexed layout, as stored by QnCorrectionsCalibrationList::WriteIndexed,
+/// and the single key layout, each top list stored as a single key,
+/// are supported. For the indexed layout the merging unit is each
+/// detector configuration list while for the single key layout is each
+/// top list. The output file keeps the layout of the input files.
+///
+/// The merging units are collected from all the input files so, units
+/// not present in the first input are incorporated as well. Objects are
+/// matched by name so, lists with different content order are properly
+/// merged and objects not present in the first input are incorporated.
+///
+/// The parallel merging requires ROOT built with implicit multi-threading
+/// support. Otherwise the merging is sequential.
+///
+/// \author Jaap Onderwaater <jacobus.onderwaater@cern.ch>, GSI
+/// \author Ilya Selyuzhenkov <ilya.selyuzhenkov@gmail.com>, GSI
+/// \author Víctor González <victor.gonzalez@cern.ch>, UCM
+/// \date Oct 16, 2026
+
+class QnCorrectionsOutputMerger : public TObject {
+public:
+  QnCorrectionsOutputMerger();
+  virtual ~QnCorrectionsOutputMerger();
+
+  void AddInputFile(const char *fileName);
+  Int_t AddInputFilesFromList(const char *listFileName);
+  /// Sets the number of threads to use for merging
+  /// \param nThreads the number of threads. Zero for as many as cores
+  void SetNoOfThreads(Int_t nThreads) { fNoOfThreads = nThreads; }
+  /// Gets the number of input files
+  /// \return the number of input files
+  Int_t GetNoOfInputFiles() const { return fInputFiles.GetEntriesFast(); }
+
+  Bool_t Merge(const char *outputFileName);
+
+  void MergeLists(TList *target, TList *source) const;
+  static TList *ReadList(TDirectory *directory, Bool_t recursive = kTRUE);
+
+private:
+  void CollectUnits(TDirectory *directory, const char *path, Int_t depth);
+  void AddUnit(const char *name, const char *type);
+  TList *ReadUnit(const char *fileName, const TNamed *unit) const;
+  TList *MergeUnit(const TNamed *unit, Int_t nThreads) const;
+  void MergeSlice(const TNamed *unit, TList **partial, Int_t ixSlice, Int_t nSlices) const;
+  void MergePair(TList **partial, Int_t ixTarget, Int_t ixSource) const;
+  Bool_t WriteUnit(TList *list, const TNamed *unit, TDirectory *output) const;
+  static void DetachHistograms(TList *list);
+
+  static const Int_t nMaxUnitDepth;         ///< the depth of the indexed layout directories taken as merging units
+  static const char *szRecursiveUnit;       ///< the unit is a directory with all its content
+  static const char *szLooseObjectsUnit;    ///< the unit are the objects, not the subdirectories, of a directory
+  static const char *szSingleKeyUnit;       ///< the unit is a list stored as a single key
+  TObjArray fInputFiles;                    ///< the input files names
+  Int_t fNoOfThreads;                       ///< the number of threads to use for merging
+  TList fUnits;                             //!<! the merging units of the current merging process
+  ROOT::TThreadExecutor *fExecutor;         //!<! the executor for the parallel merging
+
+  /// Copy constructor
+  /// Not allowed. Forced private.
+  QnCorrectionsOutputMerger(const QnCorrectionsOutputMerger &);
+  /// Assignment operator
+  /// Not allowed. Forced private.
+  QnCorrectionsOutputMerger& operator= (const QnCorrectionsOutputMerger &);
+
+/// \cond CLASSIMP
+  ClassDef(QnCorrectionsOutputMerger, 1);
+/// \endcond
+};
+
+#endif // QNCORRECTIONS_OUTPUTMERGER_H
@@ -116,6 +116,8 @@ Bool_t QnCorrectionsProfile::AttachHistograms(TList *histogramList) {
 
   fEntries = (THnI *) histogramList->FindObject((const char*) entriesHistoName);
   if (fEntries != NULL && fEntries->GetEntries() != 0) {
+    /* the attached binning could differ from the event class variables one */
+    CheckEventClassAxes(fEntries);
     fValues = (THnF *) histogramList->FindObject((const char *)histoName);
     if (fValues == NULL)
       return kFALSE;
@@ -135,7 +137,7 @@ Bool_t QnCorrectionsProfile::AttachHistograms(TList *histogramList) {
 /// \return the associated bin to the current variables content
 Long64_t QnCorrectionsProfile::GetBin(const Float_t *variableContainer) {
   FillBinAxesValues(variableContainer);
-  return fEntries->GetBin(fBinAxesValues);
+  return FindBin(fEntries);
 }
 
 /// Check the validity of the content of the passed bin
@@ -220,8 +222,8 @@ void QnCorrectionsProfile::Fill(const Float_t *variableContainer, Float_t weight
   Double_t nEntries = fValues->GetEntries();
 
   FillBinAxesValues(variableContainer);
-  fValues->Fill(fBinAxesValues, weight);
+  fValues->FillBin(FindBin(fValues), weight);
   fValues->SetEntries(nEntries + 1);
-  fEntries->Fill(fBinAxesValues, 1.0);
+  fEntries->FillBin(FindBin(fEntries), 1.0);
 }
 
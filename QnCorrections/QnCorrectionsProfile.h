@@ -62,6 +62,10 @@ public:
   /// wrong call for this class invoke base class behavior
   virtual void Fill(const Float_t *variableContainer, Int_t nChannel, Float_t weight)
   { QnCorrectionsHistogramBase::Fill(variableContainer, nChannel, weight); }
+
+  /// Gets the memory taken by the profile histograms
+  /// \return the memory in bytes
+  virtual Long64_t GetMemorySize() const { return GetStorageSize(fValues) + GetStorageSize(fEntries); }
 private:
   THnF *fValues;   //!<! Cumulates values for each of the event classes
   THnI *fEntries;  //!<! Cumulates the number on each of the event classes
@@ -27,6 +27,7 @@ QnCorrectionsProfile3DCorrelations::QnCorrectionsProfile3DCorrelations() :
   fYYValues = NULL;
   fEntries = NULL;
   fHarmonicMultiplier = 1;
+  fNoOfHarmonicSlots = 0;
 }
 
 /// Normal constructor
@@ -62,6 +63,7 @@ QnCorrectionsProfile3DCorrelations::QnCorrectionsProfile3DCorrelations(const cha
   fYYValues = NULL;
   fEntries = NULL;
   fHarmonicMultiplier = 1;
+  fNoOfHarmonicSlots = 0;
 }
 
 /// Default destructor
@@ -160,6 +162,7 @@ Bool_t QnCorrectionsProfile3DCorrelations::CreateCorrelationComponentsProfileHis
   fXYValues = new THnF **[CORRELATIONSNOOFQNVECTORS];
   fYXValues = new THnF **[CORRELATIONSNOOFQNVECTORS];
   fYYValues = new THnF **[CORRELATIONSNOOFQNVECTORS];
+  fNoOfHarmonicSlots = nNumberOfSlots;
   for (Int_t ixComb = 0; ixComb < CORRELATIONSNOOFQNVECTORS; ixComb++) {
     fXXValues[ixComb] = new THnF *[nNumberOfSlots];
     fXYValues[ixComb] = new THnF *[nNumberOfSlots];
@@ -349,11 +352,14 @@ Bool_t QnCorrectionsProfile3DCorrelations::AttachHistograms(TList *histogramList
   UInt_t harmonicFilledMask = 0x0000;
   fEntries = (THnI *) histogramList->FindObject((const char*) entriesHistoName);
   if (fEntries != NULL && fEntries->GetEntries() != 0) {
+    /* the attached binning could differ from the event class variables one */
+    CheckEventClassAxes(fEntries);
     /* allocate enough space for the supported harmonic numbers */
     fXXValues = new THnF **[CORRELATIONSNOOFQNVECTORS];
     fXYValues = new THnF **[CORRELATIONSNOOFQNVECTORS];
     fYXValues = new THnF **[CORRELATIONSNOOFQNVECTORS];
     fYYValues = new THnF **[CORRELATIONSNOOFQNVECTORS];
+    fNoOfHarmonicSlots = nMaxHarmonicNumberSupported + 1;
     for (Int_t ixComb = 0; ixComb < CORRELATIONSNOOFQNVECTORS; ixComb++) {
       fXXValues[ixComb] = new THnF *[nMaxHarmonicNumberSupported + 1];
       fXYValues[ixComb] = new THnF *[nMaxHarmonicNumberSupported + 1];
@@ -407,7 +413,7 @@ Bool_t QnCorrectionsProfile3DCorrelations::AttachHistograms(TList *histogramList
 /// \return the associated bin to the current variables content
 Long64_t QnCorrectionsProfile3DCorrelations::GetBin(const Float_t *variableContainer) {
   FillBinAxesValues(variableContainer);
-  return fEntries->GetBin(fBinAxesValues);
+  return FindBin(fEntries);
 }
 
 /// Check the validity of the content of the passed bin
@@ -816,6 +822,7 @@ void QnCorrectionsProfile3DCorrelations::Fill(const QnCorrectionsQnVector *QnA,
 
   /* let's get the axis information */
   FillBinAxesValues(variableContainer);
+  Long64_t bin = FindBin(fEntries);
 
   /* consider all combinations */
   const QnCorrectionsQnVector *combQn[CORRELATIONSNOOFQNVECTORS] = {QnA,QnB,QnC};
@@ -834,10 +841,10 @@ void QnCorrectionsProfile3DCorrelations::Fill(const QnCorrectionsQnVector *QnA,
       Double_t nYXEntries = fYXValues[ixComb][nCurrentHarmonic]->GetEntries();
       Double_t nYYEntries = fYYValues[ixComb][nCurrentHarmonic]->GetEntries();
 
-      fXXValues[ixComb][nCurrentHarmonic]->Fill(fBinAxesValues, combQn[ixComb]->Qx(nCurrentHarmonic) * combQn[(ixComb+1)%CORRELATIONSNOOFQNVECTORS]->Qx(nCurrentHarmonic));
-      fXYValues[ixComb][nCurrentHarmonic]->Fill(fBinAxesValues, combQn[ixComb]->Qx(nCurrentHarmonic) * combQn[(ixComb+1)%CORRELATIONSNOOFQNVECTORS]->Qy(nCurrentHarmonic));
-      fYXValues[ixComb][nCurrentHarmonic]->Fill(fBinAxesValues, combQn[ixComb]->Qy(nCurrentHarmonic) * combQn[(ixComb+1)%CORRELATIONSNOOFQNVECTORS]->Qx(nCurrentHarmonic));
-      fYYValues[ixComb][nCurrentHarmonic]->Fill(fBinAxesValues, combQn[ixComb]->Qy(nCurrentHarmonic) * combQn[(ixComb+1)%CORRELATIONSNOOFQNVECTORS]->Qy(nCurrentHarmonic));
+      fXXValues[ixComb][nCurrentHarmonic]->FillBin(bin, combQn[ixComb]->Qx(nCurrentHarmonic) * combQn[(ixComb+1)%CORRELATIONSNOOFQNVECTORS]->Qx(nCurrentHarmonic));
+      fXYValues[ixComb][nCurrentHarmonic]->FillBin(bin, combQn[ixComb]->Qx(nCurrentHarmonic) * combQn[(ixComb+1)%CORRELATIONSNOOFQNVECTORS]->Qy(nCurrentHarmonic));
+      fYXValues[ixComb][nCurrentHarmonic]->FillBin(bin, combQn[ixComb]->Qy(nCurrentHarmonic) * combQn[(ixComb+1)%CORRELATIONSNOOFQNVECTORS]->Qx(nCurrentHarmonic));
+      fYYValues[ixComb][nCurrentHarmonic]->FillBin(bin, combQn[ixComb]->Qy(nCurrentHarmonic) * combQn[(ixComb+1)%CORRELATIONSNOOFQNVECTORS]->Qy(nCurrentHarmonic));
 
       fXXValues[ixComb][nCurrentHarmonic]->SetEntries(nXXEntries + 1);
       fXYValues[ixComb][nCurrentHarmonic]->SetEntries(nXYEntries + 1);
@@ -849,5 +856,23 @@ void QnCorrectionsProfile3DCorrelations::Fill(const QnCorrectionsQnVector *QnA,
   }
 
   /* update the profile entries */
-  fEntries->Fill(fBinAxesValues, 1.0);
+  fEntries->FillBin(bin, 1.0);
+}
+
+/// Gets the memory taken by the profile histograms
+///
+/// The harmonic slot zero is never used.
+/// \return the memory in bytes
+Long64_t QnCorrectionsProfile3DCorrelations::GetMemorySize() const {
+  Long64_t size = GetStorageSize(fEntries);
+
+  if (fXXValues != NULL) {
+    for (Int_t ixComb = 0; ixComb < CORRELATIONSNOOFQNVECTORS; ixComb++) {
+      for (Int_t slot = 1; slot < fNoOfHarmonicSlots; slot++) {
+        size += GetStorageSize(fXXValues[ixComb][slot]) + GetStorageSize(fXYValues[ixComb][slot])
+            + GetStorageSize(fYXValues[ixComb][slot]) + GetStorageSize(fYYValues[ixComb][slot]);
+      }
+    }
+  }
+  return size;
 }
@@ -138,6 +138,7 @@ public:
   virtual void Fill(const Float_t *variableContainer, Int_t nChannel, Float_t weight)
   { QnCorrectionsHistogramBase::Fill(variableContainer, nChannel, weight); }
 
+  virtual Long64_t GetMemorySize() const;
 
 private:
   THnF ***fXXValues;            //!<! XX component histogram for each requested harmonic
@@ -145,6 +146,7 @@ private:
   THnF ***fYXValues;            //!<! YX component histogram for each requested harmonic
   THnF ***fYYValues;            //!<! YY component histogram for each requested harmonic
   THnI  *fEntries;             //!<! Cumulates the number on each of the event classes
+  Int_t fNoOfHarmonicSlots;     //!<! the number of slots of the harmonic histograms arrays
   TString fNameA;               ///< the name of the A detector
   TString fNameB;               ///< the name of the B detector
   TString fNameC;               ///< the name of the C detector
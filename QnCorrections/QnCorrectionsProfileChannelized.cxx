@@ -22,6 +22,7 @@ QnCorrectionsProfileChannelized::QnCorrectionsProfileChannelized() :
   fNoOfChannels = 0;
   fActualNoOfChannels = 0;
   fChannelMap = NULL;
+  fSharedProfile = NULL;
 }
 
 /// Normal constructor
@@ -53,6 +54,7 @@ QnCorrectionsProfileChannelized::QnCorrectionsProfileChannelized(const char *nam
   fNoOfChannels = nNoOfChannels;
   fActualNoOfChannels = 0;
   fChannelMap = NULL;
+  fSharedProfile = NULL;
 }
 
 /// Default destructor
@@ -186,7 +188,7 @@ Long64_t QnCorrectionsProfileChannelized::GetBin(const Float_t *variableContaine
 
   FillBinAxesValues(variableContainer, fChannelMap[nChannel]);
   /* store the channel number */
-  return fEntries->GetBin(fBinAxesValues);
+  return FindBin(fEntries);
 }
 
 /// Check the validity of the content of the passed bin
@@ -269,13 +271,42 @@ Float_t QnCorrectionsProfileChannelized::GetBinError(Long64_t bin) {
 /// \param nChannel the interested external channel number
 /// \param weight the increment in the bin content
 void QnCorrectionsProfileChannelized::Fill(const Float_t *variableContainer, Int_t nChannel, Float_t weight) {
+  FillBinAxesValues(variableContainer, fChannelMap[nChannel]);
+  if (fSharedProfile != NULL) {
+    FillSharedBin(fSharedProfile->fValues, fValues, FindBin(fValues), weight);
+    FillSharedBin(fSharedProfile->fEntries, fEntries, FindBin(fEntries), 1.0);
+    return;
+  }
+
   /* keep the total entries in fValues updated */
   Double_t nEntries = fValues->GetEntries();
 
-  FillBinAxesValues(variableContainer, fChannelMap[nChannel]);
   /* and now update the bin */
-  fValues->Fill(fBinAxesValues, weight);
+  fValues->FillBin(FindBin(fValues), weight);
   fValues->SetEntries(nEntries + 1);
-  fEntries->Fill(fBinAxesValues, 1.0);
+  fEntries->FillBin(FindBin(fEntries), 1.0);
+}
+
+/// Shares the histograms of another profile
+///
+/// Both profiles should have been created for filling with the same
+/// event class variables and channels. The fills are from now on
+/// accumulated into the histograms of the passed profile while the
+/// own ones only keep the entries.
+/// \param master the profile whose histograms will be shared
+/// \return kTRUE if the histograms are now shared
+Bool_t QnCorrectionsProfileChannelized::ShareHistograms(QnCorrectionsProfileChannelized *master) {
+  if (master == NULL || master->fSharedProfile != NULL) return kFALSE;
+  if (master->fEntries == NULL || fEntries == NULL) return kFALSE;
+  if ((master->fEntries->GetNbins() != fEntries->GetNbins()) || (master->fActualNoOfChannels != fActualNoOfChannels)) {
+    QnCorrectionsError(Form("The histograms of %s cannot be shared due to their layout", GetName()));
+    return kFALSE;
+  }
+
+  /* the shared storage should be in place before concurrent fills */
+  PrepareSharedHistogram(master->fValues);
+  PrepareSharedHistogram(master->fEntries);
+  fSharedProfile = master;
+  return kTRUE;
 }
 
@@ -28,6 +28,11 @@
 /// by the detector configuration that is associated to the histogram
 /// and as such by the own histogram.
 ///
+/// An instance created for filling can share the histograms of another
+/// one, created for filling for the same channels. The bin contents are
+/// then accumulated, under the bins locks, into the shared histograms
+/// while the own, otherwise empty, histograms keep the own entries.
+///
 /// GetBinContent (once the intended bin is obtained by mean
 /// of GetBin) returns in the profile way
 /// \f[
@@ -62,6 +67,7 @@ public:
   virtual ~QnCorrectionsProfileChannelized();
 
   Bool_t CreateProfileHistograms(TList *histogramList, const Bool_t *bUsedChannel, const Int_t *nChannelGroup);
+  Bool_t ShareHistograms(QnCorrectionsProfileChannelized *master);
 
   virtual Long64_t GetBin(const Float_t *variableContainer, Int_t nChannel);
   /// wrong call for this class invoke base class behavior
@@ -75,6 +81,12 @@ public:
   /// wrong call for this class invoke base class behavior
   virtual void Fill(const Float_t *variableContainer,Float_t weight)
   { QnCorrectionsHistogramBase::Fill(variableContainer, weight); }
+
+  /// Gets the memory taken by the profile histograms
+  /// A profile filling the histograms of another one does not take its own
+  /// \return the memory in bytes
+  virtual Long64_t GetMemorySize() const
+  { return (fSharedProfile != NULL) ? 0 : GetStorageSize(fValues) + GetStorageSize(fEntries); }
 private:
   THnF *fValues;              //!<! Cumulates values for each of the event classes
   THnI *fEntries;             //!<! Cumulates the number on each of the event classes
@@ -83,10 +95,11 @@ private:
   Int_t fNoOfChannels;        //!<! The number of channels associated to the whole detector
   Int_t fActualNoOfChannels;  //!<! The actual number of channels handled by the histogram
   Int_t *fChannelMap;         //!<! array, the map from histo to detector channel number
+  QnCorrectionsProfileChannelized *fSharedProfile; //!<! the profile whose histograms are shared, NULL if not sharing
 
 
   /// \cond CLASSIMP
-  ClassDef(QnCorrectionsProfileChannelized, 1);
+  ClassDef(QnCorrectionsProfileChannelized, 2);
   /// \endcond
 };
 
@@ -64,6 +64,11 @@ public:
   virtual Float_t GetBinError(Long64_t bin);
   virtual Float_t GetGrpBinError(Long64_t bin);
 
+  /// Gets the memory taken by the derived values, group values and validation histograms
+  /// \return the memory in bytes
+  virtual Long64_t GetMemorySize() const
+  { return GetStorageSize(fValues) + GetStorageSize(fGroupValues) + GetStorageSize(fValidated); }
+
 private:
   THnF *fValues;              //!<! the values and errors on each event class and channel
   THnF *fGroupValues;         //!<! the values and errors on each event class and group
@@ -1,6 +1,7 @@
 /// \file QnCorrectionsProfileComponents.cxx
 /// \brief Implementation of the multidimensional component based set of profiles
 
+#include <string.h>
 #include "TList.h"
 
 #include "QnCorrectionsEventClassVariablesSet.h"
@@ -21,6 +22,15 @@ QnCorrectionsProfileComponents::QnCorrectionsProfileComponents() :
   fYharmonicFillMask = 0x0000;
   fFullFilled = 0x0000;
   fEntries = NULL;
+  fHarmonicIndex = NULL;
+  fNoOfHarmonics = 0;
+  fAccumulatorStride = 0;
+  fNoOfBins = 0;
+  fAccumulator = NULL;
+  fXFills = NULL;
+  fYFills = NULL;
+  fAccumulatedEntries = 0;
+  fSharedProfile = NULL;
 }
 
 /// Normal constructor
@@ -50,18 +60,52 @@ QnCorrectionsProfileComponents::QnCorrectionsProfileComponents(const char *name,
   fYharmonicFillMask = 0x0000;
   fFullFilled = 0x0000;
   fEntries = NULL;
+  fHarmonicIndex = NULL;
+  fNoOfHarmonics = 0;
+  fAccumulatorStride = 0;
+  fNoOfBins = 0;
+  fAccumulator = NULL;
+  fXFills = NULL;
+  fYFills = NULL;
+  fAccumulatedEntries = 0;
+  fSharedProfile = NULL;
 }
 
 /// Default destructor
 ///
-/// Returns the only taken memory, the harmonic histograms storage,
-/// the own histograms and other members are not own at destruction time
+/// Returns the only taken memory, the harmonic histograms storage
+/// and the accumulator, the own histograms and other members are not
+/// own at destruction time
 QnCorrectionsProfileComponents::~QnCorrectionsProfileComponents() {
 
   if (fXValues != NULL)
     delete [] fXValues;
   if (fYValues != NULL)
     delete [] fYValues;
+  ReleaseAccumulator();
+}
+
+/// Returns the memory taken by the accumulator
+void QnCorrectionsProfileComponents::ReleaseAccumulator() {
+
+  if (fHarmonicIndex != NULL)
+    delete [] fHarmonicIndex;
+  /* a shared accumulator is not own */
+  if (fAccumulator != NULL && fSharedProfile == NULL)
+    delete [] fAccumulator;
+  if (fXFills != NULL)
+    delete [] fXFills;
+  if (fYFills != NULL)
+    delete [] fYFills;
+  fHarmonicIndex = NULL;
+  fNoOfHarmonics = 0;
+  fAccumulatorStride = 0;
+  fNoOfBins = 0;
+  fAccumulator = NULL;
+  fXFills = NULL;
+  fYFills = NULL;
+  fAccumulatedEntries = 0;
+  fSharedProfile = NULL;
 }
 
 /// Creates the X, Y components support histograms for the profile function
@@ -80,6 +124,10 @@ QnCorrectionsProfileComponents::~QnCorrectionsProfileComponents() {
 /// 2, 4, 6 and 8 will require nNoOfHarmonics = 4 and harmonicMap = [2, 4, 6, 8].
 /// The fully filled condition is computed and stored
 ///
+/// The flat accumulator is allocated for the whole set of event class
+/// bins and harmonics. The histograms bins storage is not allocated
+/// until the accumulator contents are transferred to them.
+///
 /// The whole set of histograms are added to the passed histogram list
 ///
 /// \param histogramList list where the histograms have to be added
@@ -125,10 +173,14 @@ Bool_t QnCorrectionsProfileComponents::CreateComponentsProfileHistograms(TList *
   /* now allocate the slots for the values histograms */
   fXValues = new THnF *[nNumberOfSlots];
   fYValues = new THnF *[nNumberOfSlots];
+  /* and for the accumulator harmonic indexes */
+  ReleaseAccumulator();
+  fHarmonicIndex = new Int_t[nNumberOfSlots];
   /* and initiallize them */
   for (Int_t i = 0; i < nNumberOfSlots; i++) {
     fXValues[i] = NULL;
     fYValues[i] = NULL;
+    fHarmonicIndex[i] = -1;
   }
 
   /* now prepare the construction of the histograms */
@@ -180,6 +232,9 @@ Bool_t QnCorrectionsProfileComponents::CreateComponentsProfileHistograms(TList *
 
     /* and update the fully filled condition */
     fFullFilled |= harmonicNumberMask[currentHarmonic];
+
+    /* and the harmonic place in the accumulator */
+    fHarmonicIndex[currentHarmonic] = i;
   }
 
   /* create the entries multidimensional histogram */
@@ -194,6 +249,20 @@ Bool_t QnCorrectionsProfileComponents::CreateComponentsProfileHistograms(TList *
   /* and finally add the entries histogram to the list */
   histogramList->Add(fEntries);
 
+  /* now the accumulator: entries plus the harmonics items for each bin */
+  fNoOfHarmonics = nNoOfHarmonics;
+  fAccumulatorStride = 1 + kNOOFITEMS * nNoOfHarmonics;
+  fNoOfBins = fEntries->GetNbins();
+  fAccumulator = new Double_t[fNoOfBins * fAccumulatorStride];
+  memset(fAccumulator, 0, fNoOfBins * fAccumulatorStride * sizeof(Double_t));
+  fXFills = new Long64_t[nNoOfHarmonics];
+  fYFills = new Long64_t[nNoOfHarmonics];
+  for (Int_t i = 0; i < nNoOfHarmonics; i++) {
+    fXFills[i] = 0;
+    fYFills[i] = 0;
+  }
+  fAccumulatedEntries = 0;
+
   delete [] minvals;
   delete [] maxvals;
   delete [] nbins;
@@ -222,6 +291,8 @@ Bool_t QnCorrectionsProfileComponents::AttachHistograms(TList *histogramList) {
   entriesHistoName += szEntriesHistoSuffix;
 
   /* initialize. Remember we don't own the histograms */
+  /* attached histograms are not accumulated */
+  ReleaseAccumulator();
   fEntries = NULL;
   if (fXValues != NULL) {
     delete [] fXValues;
@@ -237,6 +308,8 @@ Bool_t QnCorrectionsProfileComponents::AttachHistograms(TList *histogramList) {
 
   fEntries = (THnI *) histogramList->FindObject((const char*) entriesHistoName);
   if (fEntries != NULL && fEntries->GetEntries() != 0) {
+    /* the attached binning could differ from the event class variables one */
+    CheckEventClassAxes(fEntries);
     /* allocate enough space for the supported harmonic numbers */
     fXValues = new THnF *[nMaxHarmonicNumberSupported + 1];
     fYValues = new THnF *[nMaxHarmonicNumberSupported + 1];
@@ -273,7 +346,7 @@ Bool_t QnCorrectionsProfileComponents::AttachHistograms(TList *histogramList) {
 /// \return the associated bin to the current variables content
 Long64_t QnCorrectionsProfileComponents::GetBin(const Float_t *variableContainer) {
   FillBinAxesValues(variableContainer);
-  return fEntries->GetBin(fBinAxesValues);
+  return FindBin(fEntries);
 }
 
 /// Check the validity of the content of the passed bin
@@ -284,7 +357,7 @@ Long64_t QnCorrectionsProfileComponents::GetBin(const Float_t *variableContainer
 /// \param bin the bin to check its content validity
 /// \return kTRUE if the content is valid kFALSE otherwise
 Bool_t QnCorrectionsProfileComponents::BinContentValidated(Long64_t bin) {
-  Int_t nEntries = Int_t(fEntries->GetBinContent(bin));
+  Int_t nEntries = Int_t(fEntries->GetBinContent(bin) + GetAccumulatedEntries(bin));
 
   if (nEntries < fMinNoOfEntriesToValidate) {
     return kFALSE;
@@ -315,8 +388,8 @@ Float_t QnCorrectionsProfileComponents::GetXBinContent(Int_t harmonic, Long64_t
     return 0.0;
   }
   else {
-    Int_t nEntries = Int_t(fEntries->GetBinContent(bin));
-    return fXValues[harmonic]->GetBinContent(bin) / Float_t(nEntries);
+    Int_t nEntries = Int_t(fEntries->GetBinContent(bin) + GetAccumulatedEntries(bin));
+    return (fXValues[harmonic]->GetBinContent(bin) + GetAccumulatedValue(harmonic, kXSUM, bin)) / Float_t(nEntries);
   }
 }
 
@@ -341,8 +414,8 @@ Float_t QnCorrectionsProfileComponents::GetYBinContent(Int_t harmonic, Long64_t
     return 0.0;
   }
   else {
-    Int_t nEntries = Int_t(fEntries->GetBinContent(bin));
-    return fYValues[harmonic]->GetBinContent(bin) / Float_t(nEntries);
+    Int_t nEntries = Int_t(fEntries->GetBinContent(bin) + GetAccumulatedEntries(bin));
+    return (fYValues[harmonic]->GetBinContent(bin) + GetAccumulatedValue(harmonic, kYSUM, bin)) / Float_t(nEntries);
   }
 }
 
@@ -367,9 +440,9 @@ Float_t QnCorrectionsProfileComponents::GetXBinError(Int_t harmonic, Long64_t bi
     return 0.0;
   }
   else {
-    Int_t nEntries = Int_t(fEntries->GetBinContent(bin));
-    Float_t values = fXValues[harmonic]->GetBinContent(bin);
-    Float_t error2 = fXValues[harmonic]->GetBinError2(bin);
+    Int_t nEntries = Int_t(fEntries->GetBinContent(bin) + GetAccumulatedEntries(bin));
+    Float_t values = fXValues[harmonic]->GetBinContent(bin) + GetAccumulatedValue(harmonic, kXSUM, bin);
+    Float_t error2 = fXValues[harmonic]->GetBinError2(bin) + GetAccumulatedValue(harmonic, kXSUM2, bin);
 
     Double_t average = values / nEntries;
     Double_t serror = TMath::Sqrt(TMath::Abs(error2 / nEntries - average * average));
@@ -409,9 +482,9 @@ Float_t QnCorrectionsProfileComponents::GetYBinError(Int_t harmonic, Long64_t bi
     return 0.0;
   }
   else {
-    Int_t nEntries = Int_t(fEntries->GetBinContent(bin));
-    Float_t values = fYValues[harmonic]->GetBinContent(bin);
-    Float_t error2 = fYValues[harmonic]->GetBinError2(bin);
+    Int_t nEntries = Int_t(fEntries->GetBinContent(bin) + GetAccumulatedEntries(bin));
+    Float_t values = fYValues[harmonic]->GetBinContent(bin) + GetAccumulatedValue(harmonic, kYSUM, bin);
+    Float_t error2 = fYValues[harmonic]->GetBinError2(bin) + GetAccumulatedValue(harmonic, kYSUM2, bin);
 
     Double_t average = values / nEntries;
     Double_t serror = TMath::Sqrt(TMath::Abs(error2 / nEntries - average * average));
@@ -453,13 +526,24 @@ void QnCorrectionsProfileComponents::FillX(Int_t harmonic, const Float_t *variab
   }
 
   /* now it's safe to continue */
-
-  /* keep total entries in fValues updated */
-  Double_t nEntries = fXValues[harmonic]->GetEntries();
-
   FillBinAxesValues(variableContainer);
-  fXValues[harmonic]->Fill(fBinAxesValues, weight);
-  fXValues[harmonic]->SetEntries(nEntries + 1);
+  Long64_t bin = FindBin(fEntries);
+
+  if (fAccumulator != NULL) {
+    Double_t *values = fAccumulator + bin * fAccumulatorStride + 1 + fHarmonicIndex[harmonic] * kNOOFITEMS;
+    if (fSharedProfile != NULL) LockSharedBin(fAccumulator, bin);
+    values[kXSUM] += weight;
+    values[kXSUM2] += weight * weight;
+    if (fSharedProfile != NULL) UnlockSharedBin(fAccumulator, bin);
+    fXFills[fHarmonicIndex[harmonic]]++;
+  }
+  else {
+    /* keep total entries in fValues updated */
+    Double_t nEntries = fXValues[harmonic]->GetEntries();
+
+    fXValues[harmonic]->FillBin(bin, weight);
+    fXValues[harmonic]->SetEntries(nEntries + 1);
+  }
 
   /* update harmonic fill mask */
   fXharmonicFillMask |= harmonicNumberMask[harmonic];
@@ -468,7 +552,15 @@ void QnCorrectionsProfileComponents::FillX(Int_t harmonic, const Float_t *variab
   if (fXharmonicFillMask != fFullFilled) return;
   if (fYharmonicFillMask != fFullFilled) return;
   /* update entries and reset the masks */
-  fEntries->Fill(fBinAxesValues, 1.0);
+  if (fAccumulator != NULL) {
+    if (fSharedProfile != NULL) LockSharedBin(fAccumulator, bin);
+    fAccumulator[bin * fAccumulatorStride] += 1.0;
+    if (fSharedProfile != NULL) UnlockSharedBin(fAccumulator, bin);
+    fAccumulatedEntries++;
+  }
+  else {
+    fEntries->FillBin(bin, 1.0);
+  }
   fXharmonicFillMask = 0x0000;
   fYharmonicFillMask = 0x0000;
 }
@@ -496,13 +588,24 @@ void QnCorrectionsProfileComponents::FillY(Int_t harmonic, const Float_t *variab
   }
 
   /* now it's safe to continue */
-
-  /* keep total entries in fValues updated */
-  Double_t nEntries = fYValues[harmonic]->GetEntries();
-
   FillBinAxesValues(variableContainer);
-  fYValues[harmonic]->Fill(fBinAxesValues, weight);
-  fYValues[harmonic]->SetEntries(nEntries + 1);
+  Long64_t bin = FindBin(fEntries);
+
+  if (fAccumulator != NULL) {
+    Double_t *values = fAccumulator + bin * fAccumulatorStride + 1 + fHarmonicIndex[harmonic] * kNOOFITEMS;
+    if (fSharedProfile != NULL) LockSharedBin(fAccumulator, bin);
+    values[kYSUM] += weight;
+    values[kYSUM2] += weight * weight;
+    if (fSharedProfile != NULL) UnlockSharedBin(fAccumulator, bin);
+    fYFills[fHarmonicIndex[harmonic]]++;
+  }
+  else {
+    /* keep total entries in fValues updated */
+    Double_t nEntries = fYValues[harmonic]->GetEntries();
+
+    fYValues[harmonic]->FillBin(bin, weight);
+    fYValues[harmonic]->SetEntries(nEntries + 1);
+  }
 
   /* update harmonic fill mask */
   fYharmonicFillMask |= harmonicNumberMask[harmonic];
@@ -511,9 +614,132 @@ void QnCorrectionsProfileComponents::FillY(Int_t harmonic, const Float_t *variab
   if (fYharmonicFillMask != fFullFilled) return;
   if (fXharmonicFillMask != fFullFilled) return;
   /* update entries and reset the masks */
-  fEntries->Fill(fBinAxesValues, 1.0);
+  if (fAccumulator != NULL) {
+    if (fSharedProfile != NULL) LockSharedBin(fAccumulator, bin);
+    fAccumulator[bin * fAccumulatorStride] += 1.0;
+    if (fSharedProfile != NULL) UnlockSharedBin(fAccumulator, bin);
+    fAccumulatedEntries++;
+  }
+  else {
+    fEntries->FillBin(bin, 1.0);
+  }
   fXharmonicFillMask = 0x0000;
   fYharmonicFillMask = 0x0000;
 }
 
+/// Shares the accumulator of another profile
+///
+/// Both profiles should have been created for filling with the same
+/// event class variables and harmonics. The own accumulator, once
+/// flushed, is released and the fills are from now on accumulated into
+/// the one of the passed profile.
+/// \param master the profile whose accumulator will be shared
+/// \return kTRUE if the accumulator is now shared
+Bool_t QnCorrectionsProfileComponents::ShareHistograms(QnCorrectionsProfileComponents *master) {
+  if (master == NULL || master->fAccumulator == NULL || fAccumulator == NULL) return kFALSE;
+  if (master->fSharedProfile != NULL) return kFALSE;
+  if ((master->fNoOfBins != fNoOfBins) || (master->fAccumulatorStride != fAccumulatorStride)) {
+    QnCorrectionsError(Form("The accumulator of %s cannot be shared due to its layout", GetName()));
+    return kFALSE;
+  }
+
+  /* flush whatever was accumulated before releasing the own accumulator */
+  FlushHistograms();
+  if (fSharedProfile == NULL)
+    delete [] fAccumulator;
+  fAccumulator = master->fAccumulator;
+  fSharedProfile = master;
+  return kTRUE;
+}
+
+/// Transfers the accumulated contents to the support histograms
+///
+/// The not yet transferred sums, squared sums and entries are added
+/// to the THnF and THnI histograms which then are ready for being
+/// written or merged. The first transfer with contents materializes
+/// the histograms bins storage. The accumulator is reset afterwards so,
+/// the histograms can be flushed as many times as needed.
+void QnCorrectionsProfileComponents::FlushHistograms() {
+
+  if (fAccumulator == NULL) return;
+
+  /* the shared accumulator contents are transferred by its owner */
+  if (fSharedProfile != NULL) {
+    Int_t nFlushed = 0;
+    for (Int_t harmonic = 0; nFlushed < fNoOfHarmonics; harmonic++) {
+      Int_t ixHarmonic = fHarmonicIndex[harmonic];
+      if (ixHarmonic < 0) continue;
+
+      fXValues[harmonic]->SetEntries(fXValues[harmonic]->GetEntries() + fXFills[ixHarmonic]);
+      fYValues[harmonic]->SetEntries(fYValues[harmonic]->GetEntries() + fYFills[ixHarmonic]);
+      fXFills[ixHarmonic] = 0;
+      fYFills[ixHarmonic] = 0;
+      nFlushed++;
+    }
+    fEntries->SetEntries(fEntries->GetEntries() + fAccumulatedEntries);
+    fAccumulatedEntries = 0;
+    return;
+  }
+
+  Int_t nFlushed = 0;
+  for (Int_t harmonic = 0; nFlushed < fNoOfHarmonics; harmonic++) {
+    Int_t ixHarmonic = fHarmonicIndex[harmonic];
+    if (ixHarmonic < 0) continue;
+
+    for (Long64_t bin = 0; bin < fNoOfBins; bin++) {
+      Double_t *values = fAccumulator + bin * fAccumulatorStride + 1 + ixHarmonic * kNOOFITEMS;
+      /* a null squared sum means nothing was accumulated */
+      if (values[kXSUM2] != 0.0) {
+        fXValues[harmonic]->AddBinContent(bin, values[kXSUM]);
+        fXValues[harmonic]->AddBinError2(bin, values[kXSUM2]);
+      }
+      if (values[kYSUM2] != 0.0) {
+        fYValues[harmonic]->AddBinContent(bin, values[kYSUM]);
+        fYValues[harmonic]->AddBinError2(bin, values[kYSUM2]);
+      }
+    }
+    fXValues[harmonic]->SetEntries(fXValues[harmonic]->GetEntries() + fXFills[ixHarmonic]);
+    fYValues[harmonic]->SetEntries(fYValues[harmonic]->GetEntries() + fYFills[ixHarmonic]);
+    fXFills[ixHarmonic] = 0;
+    fYFills[ixHarmonic] = 0;
+    nFlushed++;
+  }
+
+  for (Long64_t bin = 0; bin < fNoOfBins; bin++) {
+    Double_t entries = fAccumulator[bin * fAccumulatorStride];
+    if (entries != 0.0) {
+      fEntries->AddBinContent(bin, entries);
+    }
+  }
+  fEntries->SetEntries(fEntries->GetEntries() + fAccumulatedEntries);
+  fAccumulatedEntries = 0;
+
+  memset(fAccumulator, 0, fNoOfBins * fAccumulatorStride * sizeof(Double_t));
+}
 
+/// Gets the memory taken by the profile histograms and the accumulator
+///
+/// A profile accumulating into the accumulator of another one does
+/// not take its own, its histograms are never filled. When accumulating,
+/// the histograms bins storage is only accounted once materialized, i.e.
+/// once the histograms got entries from the accumulator.
+/// \return the memory in bytes
+Long64_t QnCorrectionsProfileComponents::GetMemorySize() const {
+  if (fSharedProfile != NULL) return 0;
+
+  Long64_t size = fNoOfBins * fAccumulatorStride * sizeof(Double_t);
+  if (fAccumulator == NULL || fEntries->GetEntries() != 0) {
+    size += GetStorageSize(fEntries);
+  }
+  for (Int_t harmonic = 1; harmonic <= nMaxHarmonicNumberSupported; harmonic++) {
+    if ((fFullFilled & harmonicNumberMask[harmonic]) != 0) {
+      if (fAccumulator == NULL || fXValues[harmonic]->GetEntries() != 0) {
+        size += GetStorageSize(fXValues[harmonic]);
+      }
+      if (fAccumulator == NULL || fYValues[harmonic]->GetEntries() != 0) {
+        size += GetStorageSize(fYValues[harmonic]);
+      }
+    }
+  }
+  return size;
+}
@@ -35,6 +35,26 @@
 /// component before the whole set is filled you will get an execution
 /// error because you are doing something that shall be corrected
 ///
+/// When the histograms are created, not attached, the fills are
+/// accumulated in a flat buffer that keeps, for each event class bin,
+/// the entries followed by the sums and squared sums of both
+/// components for the whole set of harmonics. The accumulated contents
+/// are only transferred to the THnF and THnI histograms, which keep
+/// the persistent format, under FlushHistograms request. The histograms
+/// are only read, never written, before that request and ROOT only
+/// allocates the bins storage of a THn at its first write so, while
+/// the events are processed, only the accumulator takes memory for the
+/// bins contents. The histograms bins storage is materialized at flush
+/// time, usually just before the histograms are written or merged.
+///
+/// An instance created for filling can share the accumulator of
+/// another one, created for filling as well, so that both accumulate
+/// into a single buffer. The fills then update the shared buffer under
+/// the bins locks and only the instance owning it transfers its
+/// contents to its histograms. The sharing instance keeps its own
+/// entries and, under FlushHistograms request, only transfers them
+/// to its, otherwise empty, histograms.
+///
 /// \author Jaap Onderwaater <jacobus.onderwaater@cern.ch>, GSI
 /// \author Ilya Selyuzhenkov <ilya.selyuzhenkov@gmail.com>, GSI
 /// \author Víctor González <victor.gonzalez@cern.ch>, UCM
@@ -67,16 +87,60 @@ public:
   virtual void FillX(Int_t harmonic, const Float_t *variableContainer, Float_t weight);
   virtual void FillY(Int_t harmonic, const Float_t *variableContainer, Float_t weight);
 
+  Bool_t ShareHistograms(QnCorrectionsProfileComponents *master);
+  void FlushHistograms();
+
+  virtual Long64_t GetMemorySize() const;
+
 private:
+  /// The items accumulated for each harmonic
+  typedef enum {
+    kXSUM = 0,                ///< the X component sum
+    kXSUM2,                   ///< the X component squared sum
+    kYSUM,                    ///< the Y component sum
+    kYSUM2,                   ///< the Y component squared sum
+    kNOOFITEMS                ///< the number of items per harmonic
+  } QnCorrectionAccumulatorItem;
+  Double_t GetAccumulatedEntries(Long64_t bin) const;
+  Double_t GetAccumulatedValue(Int_t harmonic, Int_t item, Long64_t bin) const;
+  void ReleaseAccumulator();
+
   THnF **fXValues;            //!<! X component histogram for each requested harmonic
   THnF **fYValues;            //!<! Y component histogram for each requested harmonic
   UInt_t fXharmonicFillMask;  //!<! keeps track of harmonic X component filled values
   UInt_t fYharmonicFillMask;  //!<! keeps track of harmonic Y component filled values
   UInt_t fFullFilled;         //!<! mask for the fully filled condition
   THnI  *fEntries;            //!<! Cumulates the number on each of the event classes
+  Int_t *fHarmonicIndex;      //!<! the accumulator harmonic index for each external harmonic, -1 if not requested
+  Int_t fNoOfHarmonics;       //!<! the number of accumulated harmonics
+  Int_t fAccumulatorStride;   //!<! the number of accumulated values per event class bin
+  Long64_t fNoOfBins;         //!<! the number of event class bins including under and overflow
+  Double_t *fAccumulator;     //!<! the flat accumulator with the not yet transferred contents
+  Long64_t *fXFills;          //!<! the not yet transferred X component fills for each accumulated harmonic
+  Long64_t *fYFills;          //!<! the not yet transferred Y component fills for each accumulated harmonic
+  Long64_t fAccumulatedEntries; //!<! the not yet transferred entries
+  QnCorrectionsProfileComponents *fSharedProfile; //!<! the profile whose accumulator is shared, NULL if not sharing
   /// \cond CLASSIMP
-  ClassDef(QnCorrectionsProfileComponents, 1);
+  ClassDef(QnCorrectionsProfileComponents, 3);
   /// \endcond
 };
 
+/// Gets the not yet transferred entries for the passed bin
+/// \param bin the interested bin number
+/// \return the accumulated entries
+inline Double_t QnCorrectionsProfileComponents::GetAccumulatedEntries(Long64_t bin) const {
+  if (fAccumulator == NULL) return 0.0;
+  return fAccumulator[bin * fAccumulatorStride];
+}
+
+/// Gets the not yet transferred value of an item for the passed harmonic and bin
+/// \param harmonic the interested external harmonic number
+/// \param item the interested accumulated item
+/// \param bin the interested bin number
+/// \return the accumulated value
+inline Double_t QnCorrectionsProfileComponents::GetAccumulatedValue(Int_t harmonic, Int_t item, Long64_t bin) const {
+  if (fAccumulator == NULL) return 0.0;
+  return fAccumulator[bin * fAccumulatorStride + 1 + fHarmonicIndex[harmonic] * kNOOFITEMS + item];
+}
+
 #endif
@@ -22,6 +22,7 @@ QnCorrectionsProfileCorrelationComponents::QnCorrectionsProfileCorrelationCompon
   fXXXYYXYYFillMask = 0x0000;
   fFullFilled = 0x0000;
   fEntries = NULL;
+  fSharedProfile = NULL;
 }
 
 /// Normal constructor
@@ -52,6 +53,7 @@ QnCorrectionsProfileCorrelationComponents::QnCorrectionsProfileCorrelationCompon
   fXXXYYXYYFillMask = 0x0000;
   fFullFilled = 0x0000;
   fEntries = NULL;
+  fSharedProfile = NULL;
 }
 
 /// Default destructor
@@ -175,6 +177,32 @@ Bool_t QnCorrectionsProfileCorrelationComponents::CreateCorrelationComponentsPro
   return kTRUE;
 }
 
+/// Shares the histograms of another profile
+///
+/// Both profiles should have been created for filling with the same
+/// event class variables. The fills are from now on accumulated into
+/// the histograms of the passed profile while the own ones only keep
+/// the entries.
+/// \param master the profile whose histograms will be shared
+/// \return kTRUE if the histograms are now shared
+Bool_t QnCorrectionsProfileCorrelationComponents::ShareHistograms(QnCorrectionsProfileCorrelationComponents *master) {
+  if (master == NULL || master->fSharedProfile != NULL) return kFALSE;
+  if (master->fEntries == NULL || fEntries == NULL) return kFALSE;
+  if (master->fEntries->GetNbins() != fEntries->GetNbins()) {
+    QnCorrectionsError(Form("The histograms of %s cannot be shared due to their layout", GetName()));
+    return kFALSE;
+  }
+
+  /* the shared storage should be in place before concurrent fills */
+  PrepareSharedHistogram(master->fXXValues);
+  PrepareSharedHistogram(master->fXYValues);
+  PrepareSharedHistogram(master->fYXValues);
+  PrepareSharedHistogram(master->fYYValues);
+  PrepareSharedHistogram(master->fEntries);
+  fSharedProfile = master;
+  return kTRUE;
+}
+
 /// Attaches existing histograms as the support histograms for XX, XY, YX, YY
 /// correlation component of the profile function for different harmonics
 ///
@@ -200,6 +228,8 @@ Bool_t QnCorrectionsProfileCorrelationComponents::AttachHistograms(TList *histog
   entriesHistoName += szEntriesHistoSuffix;
 
   /* initialize. Remember we don't own the histograms */
+  /* attached histograms are not shared */
+  fSharedProfile = NULL;
   fEntries = NULL;
   fXXValues = NULL;
   fXYValues = NULL;
@@ -211,6 +241,8 @@ Bool_t QnCorrectionsProfileCorrelationComponents::AttachHistograms(TList *histog
 
   fEntries = (THnI *) histogramList->FindObject((const char*) entriesHistoName);
   if (fEntries != NULL && fEntries->GetEntries() != 0) {
+    /* the attached binning could differ from the event class variables one */
+    CheckEventClassAxes(fEntries);
     /* search the values multidimensional histograms */
     fXXValues = (THnF *) histogramList->FindObject((const char *) histoXXName);
     fXYValues = (THnF *) histogramList->FindObject((const char *) histoXYName);
@@ -240,7 +272,7 @@ Bool_t QnCorrectionsProfileCorrelationComponents::AttachHistograms(TList *histog
 /// \return the associated bin to the current variables content
 Long64_t QnCorrectionsProfileCorrelationComponents::GetBin(const Float_t *variableContainer) {
   FillBinAxesValues(variableContainer);
-  return fEntries->GetBin(fBinAxesValues);
+  return FindBin(fEntries);
 }
 
 /// Check the validity of the content of the passed bin
@@ -488,12 +520,17 @@ void QnCorrectionsProfileCorrelationComponents::FillXX(const Float_t *variableCo
 
   /* now it's safe to continue */
 
-  /* keep total entries in fValues updated */
-  Double_t nEntries = fXXValues->GetEntries();
-
   FillBinAxesValues(variableContainer);
-  fXXValues->Fill(fBinAxesValues, weight);
-  fXXValues->SetEntries(nEntries + 1);
+  if (fSharedProfile != NULL) {
+    FillSharedBin(fSharedProfile->fXXValues, fXXValues, FindBin(fXXValues), weight);
+  }
+  else {
+    /* keep total entries in fValues updated */
+    Double_t nEntries = fXXValues->GetEntries();
+
+    fXXValues->FillBin(FindBin(fXXValues), weight);
+    fXXValues->SetEntries(nEntries + 1);
+  }
 
   /* update fill mask */
   fXXXYYXYYFillMask |= correlationXXmask;
@@ -501,7 +538,10 @@ void QnCorrectionsProfileCorrelationComponents::FillXX(const Float_t *variableCo
   /* now check if time for updating entries histogram */
   if (fXXXYYXYYFillMask != fFullFilled) return;
   /* update entries and reset the masks */
-  fEntries->Fill(fBinAxesValues, 1.0);
+  if (fSharedProfile != NULL)
+    FillSharedBin(fSharedProfile->fEntries, fEntries, FindBin(fEntries), 1.0);
+  else
+    fEntries->FillBin(FindBin(fEntries), 1.0);
   fXXXYYXYYFillMask = 0x0000;
 }
 
@@ -524,12 +564,17 @@ void QnCorrectionsProfileCorrelationComponents::FillXY(const Float_t *variableCo
 
   /* now it's safe to continue */
 
-  /* keep total entries in fValues updated */
-  Double_t nEntries = fXYValues->GetEntries();
-
   FillBinAxesValues(variableContainer);
-  fXYValues->Fill(fBinAxesValues, weight);
-  fXYValues->SetEntries(nEntries + 1);
+  if (fSharedProfile != NULL) {
+    FillSharedBin(fSharedProfile->fXYValues, fXYValues, FindBin(fXYValues), weight);
+  }
+  else {
+    /* keep total entries in fValues updated */
+    Double_t nEntries = fXYValues->GetEntries();
+
+    fXYValues->FillBin(FindBin(fXYValues), weight);
+    fXYValues->SetEntries(nEntries + 1);
+  }
 
   /* update fill mask */
   fXXXYYXYYFillMask |= correlationXYmask;
@@ -537,7 +582,10 @@ void QnCorrectionsProfileCorrelationComponents::FillXY(const Float_t *variableCo
   /* now check if time for updating entries histogram */
   if (fXXXYYXYYFillMask != fFullFilled) return;
   /* update entries and reset the masks */
-  fEntries->Fill(fBinAxesValues, 1.0);
+  if (fSharedProfile != NULL)
+    FillSharedBin(fSharedProfile->fEntries, fEntries, FindBin(fEntries), 1.0);
+  else
+    fEntries->FillBin(FindBin(fEntries), 1.0);
   fXXXYYXYYFillMask = 0x0000;
 }
 
@@ -560,12 +608,17 @@ void QnCorrectionsProfileCorrelationComponents::FillYX(const Float_t *variableCo
 
   /* now it's safe to continue */
 
-  /* keep total entries in fValues updated */
-  Double_t nEntries = fYXValues->GetEntries();
-
   FillBinAxesValues(variableContainer);
-  fYXValues->Fill(fBinAxesValues, weight);
-  fYXValues->SetEntries(nEntries + 1);
+  if (fSharedProfile != NULL) {
+    FillSharedBin(fSharedProfile->fYXValues, fYXValues, FindBin(fYXValues), weight);
+  }
+  else {
+    /* keep total entries in fValues updated */
+    Double_t nEntries = fYXValues->GetEntries();
+
+    fYXValues->FillBin(FindBin(fYXValues), weight);
+    fYXValues->SetEntries(nEntries + 1);
+  }
 
   /* update fill mask */
   fXXXYYXYYFillMask |= correlationYXmask;
@@ -573,7 +626,10 @@ void QnCorrectionsProfileCorrelationComponents::FillYX(const Float_t *variableCo
   /* now check if time for updating entries histogram */
   if (fXXXYYXYYFillMask != fFullFilled) return;
   /* update entries and reset the masks */
-  fEntries->Fill(fBinAxesValues, 1.0);
+  if (fSharedProfile != NULL)
+    FillSharedBin(fSharedProfile->fEntries, fEntries, FindBin(fEntries), 1.0);
+  else
+    fEntries->FillBin(FindBin(fEntries), 1.0);
   fXXXYYXYYFillMask = 0x0000;
 }
 
@@ -596,12 +652,17 @@ void QnCorrectionsProfileCorrelationComponents::FillYY(const Float_t *variableCo
 
   /* now it's safe to continue */
 
-  /* keep total entries in fValues updated */
-  Double_t nEntries = fYYValues->GetEntries();
-
   FillBinAxesValues(variableContainer);
-  fYYValues->Fill(fBinAxesValues, weight);
-  fYYValues->SetEntries(nEntries + 1);
+  if (fSharedProfile != NULL) {
+    FillSharedBin(fSharedProfile->fYYValues, fYYValues, FindBin(fYYValues), weight);
+  }
+  else {
+    /* keep total entries in fValues updated */
+    Double_t nEntries = fYYValues->GetEntries();
+
+    fYYValues->FillBin(FindBin(fYYValues), weight);
+    fYYValues->SetEntries(nEntries + 1);
+  }
 
   /* update harmonic fill mask */
   fXXXYYXYYFillMask |= correlationYYmask;
@@ -609,7 +670,10 @@ void QnCorrectionsProfileCorrelationComponents::FillYY(const Float_t *variableCo
   /* now check if time for updating entries histogram */
   if (fXXXYYXYYFillMask != fFullFilled) return;
   /* update entries and reset the masks */
-  fEntries->Fill(fBinAxesValues, 1.0);
+  if (fSharedProfile != NULL)
+    FillSharedBin(fSharedProfile->fEntries, fEntries, FindBin(fEntries), 1.0);
+  else
+    fEntries->FillBin(FindBin(fEntries), 1.0);
   fXXXYYXYYFillMask = 0x0000;
 }
 
@@ -18,6 +18,11 @@
 /// Of course,  the base name and base title for the different
 /// histograms has also to be provided.
 ///
+/// An instance created for filling can share the histograms of another
+/// one, created for filling as well. The bin contents are then
+/// accumulated, under the bins locks, into the shared histograms while
+/// the own, otherwise empty, histograms keep the own entries.
+///
 /// \author Jaap Onderwaater <jacobus.onderwaater@cern.ch>, GSI
 /// \author Ilya Selyuzhenkov <ilya.selyuzhenkov@gmail.com>, GSI
 /// \author Víctor González <victor.gonzalez@cern.ch>, UCM
@@ -33,6 +38,7 @@ public:
   virtual ~QnCorrectionsProfileCorrelationComponents();
 
   Bool_t CreateCorrelationComponentsProfileHistograms(TList *histogramList);
+  Bool_t ShareHistograms(QnCorrectionsProfileCorrelationComponents *master);
   virtual Bool_t AttachHistograms(TList *histogramList);
   /// wrong call for this class invoke base class behavior
   virtual Bool_t AttachHistograms(TList *histogramList, const Bool_t *bUsedChannel, const Int_t *nChannelGroup)
@@ -96,6 +102,13 @@ public:
   virtual void FillYY(Int_t harmonic, const Float_t *variableContainer, Float_t weight)
   { return QnCorrectionsHistogramBase::FillYY(harmonic, variableContainer, weight); }
 
+  /// Gets the memory taken by the profile histograms
+  /// A profile filling the histograms of another one does not take its own
+  /// \return the memory in bytes
+  virtual Long64_t GetMemorySize() const
+  { return (fSharedProfile != NULL) ? 0 : GetStorageSize(fXXValues) + GetStorageSize(fXYValues)
+      + GetStorageSize(fYXValues) + GetStorageSize(fYYValues) + GetStorageSize(fEntries); }
+
 private:
   THnF *fXXValues;            //!<! XX component histogram
   THnF *fXYValues;            //!<! XY component histogram
@@ -104,8 +117,9 @@ private:
   UInt_t fXXXYYXYYFillMask;   //!<! keeps track of component filled values
   UInt_t fFullFilled;          //!<! mask for the fully filled condition
   THnI  *fEntries;             //!<! Cumulates the number on each of the event classes
+  QnCorrectionsProfileCorrelationComponents *fSharedProfile; //!<! the profile whose histograms are shared, NULL if not sharing
   /// \cond CLASSIMP
-  ClassDef(QnCorrectionsProfileCorrelationComponents, 1);
+  ClassDef(QnCorrectionsProfileCorrelationComponents, 2);
   /// \endcond
 };
 
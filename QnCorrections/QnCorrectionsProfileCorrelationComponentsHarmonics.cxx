@@ -294,6 +294,8 @@ Bool_t QnCorrectionsProfileCorrelationComponentsHarmonics::AttachHistograms(TLis
 
   fEntries = (THnI *) histogramList->FindObject((const char*) entriesHistoName);
   if (fEntries != NULL && fEntries->GetEntries() != 0) {
+    /* the attached binning could differ from the event class variables one */
+    CheckEventClassAxes(fEntries);
     /* allocate enough space for the supported harmonic numbers */
     fXXValues = new THnF *[nMaxHarmonicNumberSupported + 1];
     fXYValues = new THnF *[nMaxHarmonicNumberSupported + 1];
@@ -335,7 +337,7 @@ Bool_t QnCorrectionsProfileCorrelationComponentsHarmonics::AttachHistograms(TLis
 /// \return the associated bin to the current variables content
 Long64_t QnCorrectionsProfileCorrelationComponentsHarmonics::GetBin(const Float_t *variableContainer) {
   FillBinAxesValues(variableContainer);
-  return fEntries->GetBin(fBinAxesValues);
+  return FindBin(fEntries);
 }
 
 /// Check the validity of the content of the passed bin
@@ -656,7 +658,7 @@ void QnCorrectionsProfileCorrelationComponentsHarmonics::FillXX(Int_t harmonic,
   Double_t nEntries = fXXValues[harmonic]->GetEntries();
 
   FillBinAxesValues(variableContainer);
-  fXXValues[harmonic]->Fill(fBinAxesValues, weight);
+  fXXValues[harmonic]->FillBin(FindBin(fXXValues[harmonic]), weight);
   fXXValues[harmonic]->SetEntries(nEntries + 1);
 
   /* update harmonic fill mask */
@@ -668,7 +670,7 @@ void QnCorrectionsProfileCorrelationComponentsHarmonics::FillXX(Int_t harmonic,
   if (fYXharmonicFillMask != fFullFilled) return;
   if (fYYharmonicFillMask != fFullFilled) return;
   /* update entries and reset the masks */
-  fEntries->Fill(fBinAxesValues, 1.0);
+  fEntries->FillBin(FindBin(fEntries), 1.0);
   fXXharmonicFillMask = 0x0000;
   fXYharmonicFillMask = 0x0000;
   fYXharmonicFillMask = 0x0000;
@@ -703,7 +705,7 @@ void QnCorrectionsProfileCorrelationComponentsHarmonics::FillXY(Int_t harmonic,
   Double_t nEntries = fXYValues[harmonic]->GetEntries();
 
   FillBinAxesValues(variableContainer);
-  fXYValues[harmonic]->Fill(fBinAxesValues, weight);
+  fXYValues[harmonic]->FillBin(FindBin(fXYValues[harmonic]), weight);
   fXYValues[harmonic]->SetEntries(nEntries + 1);
 
   /* update harmonic fill mask */
@@ -715,7 +717,7 @@ void QnCorrectionsProfileCorrelationComponentsHarmonics::FillXY(Int_t harmonic,
   if (fYXharmonicFillMask != fFullFilled) return;
   if (fYYharmonicFillMask != fFullFilled) return;
   /* update entries and reset the masks */
-  fEntries->Fill(fBinAxesValues, 1.0);
+  fEntries->FillBin(FindBin(fEntries), 1.0);
   fXXharmonicFillMask = 0x0000;
   fXYharmonicFillMask = 0x0000;
   fYXharmonicFillMask = 0x0000;
@@ -750,7 +752,7 @@ void QnCorrectionsProfileCorrelationComponentsHarmonics::FillYX(Int_t harmonic,
   Double_t nEntries = fYXValues[harmonic]->GetEntries();
 
   FillBinAxesValues(variableContainer);
-  fYXValues[harmonic]->Fill(fBinAxesValues, weight);
+  fYXValues[harmonic]->FillBin(FindBin(fYXValues[harmonic]), weight);
   fYXValues[harmonic]->SetEntries(nEntries + 1);
 
   /* update harmonic fill mask */
@@ -762,7 +764,7 @@ void QnCorrectionsProfileCorrelationComponentsHarmonics::FillYX(Int_t harmonic,
   if (fYXharmonicFillMask != fFullFilled) return;
   if (fYYharmonicFillMask != fFullFilled) return;
   /* update entries and reset the masks */
-  fEntries->Fill(fBinAxesValues, 1.0);
+  fEntries->FillBin(FindBin(fEntries), 1.0);
   fXXharmonicFillMask = 0x0000;
   fXYharmonicFillMask = 0x0000;
   fYXharmonicFillMask = 0x0000;
@@ -797,7 +799,7 @@ void QnCorrectionsProfileCorrelationComponentsHarmonics::FillYY(Int_t harmonic,
   Double_t nEntries = fYYValues[harmonic]->GetEntries();
 
   FillBinAxesValues(variableContainer);
-  fYYValues[harmonic]->Fill(fBinAxesValues, weight);
+  fYYValues[harmonic]->FillBin(FindBin(fYYValues[harmonic]), weight);
   fYYValues[harmonic]->SetEntries(nEntries + 1);
 
   /* update harmonic fill mask */
@@ -809,10 +811,23 @@ void QnCorrectionsProfileCorrelationComponentsHarmonics::FillYY(Int_t harmonic,
   if (fYXharmonicFillMask != fFullFilled) return;
   if (fYYharmonicFillMask != fFullFilled) return;
   /* update entries and reset the masks */
-  fEntries->Fill(fBinAxesValues, 1.0);
+  fEntries->FillBin(FindBin(fEntries), 1.0);
   fXXharmonicFillMask = 0x0000;
   fXYharmonicFillMask = 0x0000;
   fYXharmonicFillMask = 0x0000;
   fYYharmonicFillMask = 0x0000;
 }
 
+/// Gets the memory taken by the profile histograms
+/// \return the memory in bytes
+Long64_t QnCorrectionsProfileCorrelationComponentsHarmonics::GetMemorySize() const {
+  Long64_t size = GetStorageSize(fEntries);
+
+  for (Int_t harmonic = 1; harmonic <= nMaxHarmonicNumberSupported; harmonic++) {
+    if ((fFullFilled & harmonicNumberMask[harmonic]) != 0) {
+      size += GetStorageSize(fXXValues[harmonic]) + GetStorageSize(fXYValues[harmonic])
+          + GetStorageSize(fYXValues[harmonic]) + GetStorageSize(fYYValues[harmonic]);
+    }
+  }
+  return size;
+}
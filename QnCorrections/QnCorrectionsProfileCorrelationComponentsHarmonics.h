@@ -106,7 +106,7 @@ public:
   virtual void FillYY(const Float_t *variableContainer, Float_t weight)
   { return QnCorrectionsHistogramBase::FillYY(variableContainer, weight); }
 
-
+  virtual Long64_t GetMemorySize() const;
 
 private:
   THnF **fXXValues;            //!<! XX component histogram for each requested harmonic
@@ -35,6 +35,7 @@
 #include <Riostream.h>
 
 #include "QnCorrectionsQnVector.h"
+#include "QnCorrectionsQnVectorValue.h"
 #include "QnCorrectionsLog.h"
 
 using std::cout;
@@ -50,10 +51,13 @@ const UInt_t   QnCorrectionsQnVector::harmonicNumberMask[] =
  0x0100,0x0200,0x0400,0x0800,0x1000,0x2000,0x4000,0x8000};
 
 /// Default constructor
+///
+/// No harmonic is active so, only the harmonic zero components are
+/// initialized. The others are initialized when activated.
 QnCorrectionsQnVector::QnCorrectionsQnVector() : TNamed() {
-  memset(fQnX, 0, (MAXHARMONICNUMBERSUPPORTED + 1)*sizeof(Float_t));
-  memset(fQnY, 0, (MAXHARMONICNUMBERSUPPORTED + 1)*sizeof(Float_t));
   fHighestHarmonic = 0;
+  fQnX[0] = 0.0;
+  fQnY[0] = 0.0;
   fHarmonicMask = 0x0000;
   fGoodQuality = kFALSE;
   fN = 0;
@@ -81,9 +85,6 @@ QnCorrectionsQnVector::QnCorrectionsQnVector() : TNamed() {
 QnCorrectionsQnVector::QnCorrectionsQnVector(const char *name, Int_t nNoOfHarmonics, Int_t *harmonicMap) :
     TNamed(name,name) {
 
-  memset(fQnX, 0, (MAXHARMONICNUMBERSUPPORTED + 1)*sizeof(Float_t));
-  memset(fQnY, 0, (MAXHARMONICNUMBERSUPPORTED + 1)*sizeof(Float_t));
-
   /* check whether within the supported harmonic range */
   fHighestHarmonic = nNoOfHarmonics;
   if (harmonicMap != NULL) {
@@ -93,6 +94,9 @@ QnCorrectionsQnVector::QnCorrectionsQnVector(const char *name, Int_t nNoOfHarmon
     QnCorrectionsFatal(Form("You requested support for harmonic %d but the highest harmonic supported by the framework is currently %d",
         fHighestHarmonic, MAXHARMONICNUMBERSUPPORTED));
   }
+  /* only the components up to the highest harmonic are handled */
+  memset(fQnX, 0, (fHighestHarmonic + 1)*sizeof(Float_t));
+  memset(fQnY, 0, (fHighestHarmonic + 1)*sizeof(Float_t));
   fHarmonicMask = 0x0000;
   Int_t currentHarmonic = 0;
   for (Int_t h = 0; h < nNoOfHarmonics; h++) {
@@ -129,9 +133,6 @@ QnCorrectionsQnVector::QnCorrectionsQnVector(const char *name, Int_t nNoOfHarmon
 QnCorrectionsQnVector::QnCorrectionsQnVector(const char *name, Int_t nDivisor, Int_t nNoOfHarmonics, Int_t *harmonicMap) :
   TNamed(name,name) {
 
-  memset(fQnX, 0, (MAXHARMONICNUMBERSUPPORTED + 1)*sizeof(Float_t));
-  memset(fQnY, 0, (MAXHARMONICNUMBERSUPPORTED + 1)*sizeof(Float_t));
-
   /* check whether within the supported harmonic range */
   fHighestHarmonic = Int_t (harmonicMap[nNoOfHarmonics - 1] / nDivisor);
 
@@ -139,6 +140,9 @@ QnCorrectionsQnVector::QnCorrectionsQnVector(const char *name, Int_t nDivisor, I
     QnCorrectionsFatal(Form("You requested support for harmonic %d but the highest harmonic supported by the framework is currently %d",
         fHighestHarmonic, MAXHARMONICNUMBERSUPPORTED));
   }
+  /* only the components up to the highest harmonic are handled */
+  memset(fQnX, 0, (fHighestHarmonic + 1)*sizeof(Float_t));
+  memset(fQnY, 0, (fHighestHarmonic + 1)*sizeof(Float_t));
 
   fHarmonicMask = 0x0000;
   Int_t nCurrentHarmonic;
@@ -155,13 +159,15 @@ QnCorrectionsQnVector::QnCorrectionsQnVector(const char *name, Int_t nDivisor, I
 }
 
 /// Copy constructor
+///
+/// Only the components up to the highest harmonic are copied
 /// \param Qn the Q vector object to copy after construction
 QnCorrectionsQnVector::QnCorrectionsQnVector(const QnCorrectionsQnVector &Qn) :
     TNamed(Qn) {
 
-  memcpy(fQnX, Qn.fQnX, (MAXHARMONICNUMBERSUPPORTED + 1)*sizeof(Float_t));
-  memcpy(fQnY, Qn.fQnY, (MAXHARMONICNUMBERSUPPORTED + 1)*sizeof(Float_t));
   fHighestHarmonic = Qn.fHighestHarmonic;
+  memcpy(fQnX, Qn.fQnX, (fHighestHarmonic + 1)*sizeof(Float_t));
+  memcpy(fQnY, Qn.fQnY, (fHighestHarmonic + 1)*sizeof(Float_t));
   fHarmonicMask = Qn.fHarmonicMask;
   fGoodQuality = Qn.fGoodQuality;
   fN = Qn.fN;
@@ -178,9 +184,9 @@ QnCorrectionsQnVector::QnCorrectionsQnVector(const QnCorrectionsQnVector &Qn) :
 QnCorrectionsQnVector::QnCorrectionsQnVector(Int_t nDivisor, const QnCorrectionsQnVector &Q)  :
     TNamed(Q) {
 
-  memset(fQnX, 0, (MAXHARMONICNUMBERSUPPORTED + 1)*sizeof(Float_t));
-  memset(fQnY, 0, (MAXHARMONICNUMBERSUPPORTED + 1)*sizeof(Float_t));
   fHighestHarmonic = Int_t (Q.fHighestHarmonic / nDivisor);
+  memset(fQnX, 0, (fHighestHarmonic + 1)*sizeof(Float_t));
+  memset(fQnY, 0, (fHighestHarmonic + 1)*sizeof(Float_t));
 
   fHarmonicMask = 0x0000;
   Int_t nCurrentHarmonic;
@@ -224,11 +230,11 @@ void QnCorrectionsQnVector::ActivateHarmonic(Int_t harmonic) {
   }
   /* checks whether already active */
   if (fHighestHarmonic < harmonic) {
-    /* not, include it */
+    /* not, include it initializing the components up to it */
+    memset(fQnX + fHighestHarmonic + 1, 0, (harmonic - fHighestHarmonic)*sizeof(Float_t));
+    memset(fQnY + fHighestHarmonic + 1, 0, (harmonic - fHighestHarmonic)*sizeof(Float_t));
     fHighestHarmonic = harmonic;
     fHarmonicMask |= harmonicNumberMask[harmonic];
-    fQnX[harmonic] = 0.0;
-    fQnY[harmonic] = 0.0;
   }
   else {
     if ((fHarmonicMask & harmonicNumberMask[harmonic]) == harmonicNumberMask[harmonic]) {
@@ -275,7 +281,8 @@ void QnCorrectionsQnVector::GetHarmonicsMap(Int_t *harmonicMapStore) const {
 ///
 /// The passed Q vector is copied within the current object.
 /// The harmonic structures are compared. A run time error is
-/// raised if they do not match.
+/// raised if they do not match. As the structures match, only
+/// the components up to the highest harmonic are copied.
 /// \param Qn pointer to the Q vector to be copied
 /// \param changename kTRUE if the name of the Qn vector must also be changed
 void QnCorrectionsQnVector::Set(QnCorrectionsQnVector* Qn, Bool_t changename) {
@@ -286,8 +293,8 @@ void QnCorrectionsQnVector::Set(QnCorrectionsQnVector* Qn, Bool_t changename) {
         "vector but the harmonic structures do not match");
     return;
   }
-  memcpy(fQnX, Qn->fQnX, (MAXHARMONICNUMBERSUPPORTED + 1)*sizeof(Float_t));
-  memcpy(fQnY, Qn->fQnY, (MAXHARMONICNUMBERSUPPORTED + 1)*sizeof(Float_t));
+  memcpy(fQnX, Qn->fQnX, (fHighestHarmonic + 1)*sizeof(Float_t));
+  memcpy(fQnY, Qn->fQnY, (fHighestHarmonic + 1)*sizeof(Float_t));
   fGoodQuality = Qn->fGoodQuality;
   fN = Qn->fN;
   fSumW = Qn->fSumW;
@@ -297,6 +304,29 @@ void QnCorrectionsQnVector::Set(QnCorrectionsQnVector* Qn, Bool_t changename) {
   }
 }
 
+/// Publishes the values of a Q vector being built
+///
+/// The harmonic structures are compared. A run time error is
+/// raised if they do not match. Only the components of the
+/// active harmonics are written.
+/// \param Qn the Q vector values to publish
+void QnCorrectionsQnVector::Set(const QnCorrectionsQnVectorValue &Qn) {
+  if ((fHighestHarmonic != Qn.fHighestHarmonic) ||
+      (fHarmonicMask != Qn.fHarmonicMask) ||
+      (fHarmonicMultiplier != Qn.fHarmonicMultiplier)) {
+    QnCorrectionsFatal("You requested set a Q vector with the values of a Q " \
+        "vector being built but the harmonic structures do not match");
+    return;
+  }
+  for (Int_t slot = 0; slot < Qn.fNoOfHarmonics; slot++) {
+    fQnX[Qn.fHarmonic[slot]] = Qn.fQnX[slot];
+    fQnY[Qn.fHarmonic[slot]] = Qn.fQnY[slot];
+  }
+  fGoodQuality = Qn.fGoodQuality;
+  fN = Qn.fN;
+  fSumW = Qn.fSumW;
+}
+
 /// Normalize the Q vector to unit length
 ///
 void QnCorrectionsQnVector::Normalize() {
@@ -311,9 +341,13 @@ void QnCorrectionsQnVector::Normalize() {
 }
 
 /// Resets the Q vector values without touching the structure
+///
+/// Only the components up to the highest harmonic are handled, the
+/// ones beyond it are not used and they are initialized when a
+/// higher harmonic is activated.
 void QnCorrectionsQnVector::Reset() {
-  memset(fQnX, 0, (MAXHARMONICNUMBERSUPPORTED + 1)*sizeof(Float_t));
-  memset(fQnY, 0, (MAXHARMONICNUMBERSUPPORTED + 1)*sizeof(Float_t));
+  memset(fQnX, 0, (fHighestHarmonic + 1)*sizeof(Float_t));
+  memset(fQnY, 0, (fHighestHarmonic + 1)*sizeof(Float_t));
   fGoodQuality = kFALSE;
   fN = 0;
   fSumW = 0.0;
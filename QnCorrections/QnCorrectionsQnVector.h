@@ -20,6 +20,11 @@
 /// The maximum external harmonic number the framework currently support for Q vectors
 #define MAXHARMONICNUMBERSUPPORTED 15
 
+/// The number of data vectors handled together by the batched Q vector building
+#define QNVECTORBUILDBATCHSIZE 256
+
+struct QnCorrectionsQnVectorValue;
+
 /// \class QnCorrectionsQnVector
 /// \brief Class that models and encapsulates a Q vector set
 ///
@@ -36,6 +41,7 @@
 /// \date Jun 21, 2016
 class QnCorrectionsQnVector : public TNamed {
 
+  friend struct QnCorrectionsQnVectorValue;
 public:
   /// \enum QnVectorNormalizationMethod
   /// \brief The class of the id of the supported Q vector normalization methods
@@ -80,12 +86,19 @@ public:
   /// Set the good quality flag
   /// \param good kTRUE  if the quality is good
   virtual void SetGood(Bool_t good) { fGoodQuality = good; }
+  /// Set the number of elements used for building the Qn vector
+  /// \param n the number of elements
+  virtual void SetN(Int_t n) { fN = n; }
+  /// Set the sum of weights of the elements used for building the Qn vector
+  /// \param sumw the sum of weights
+  virtual void SetSumOfWeights(Float_t sumw) { fSumW = sumw; }
   /// Set the harmonic multiplier
   /// With it different from one Qn behaves as Qmxn.
   /// \param m the hamonic multiplier
   virtual void SetHarmonicMultiplier(Int_t m) { fHarmonicMultiplier = m; }
 
   void Set(QnCorrectionsQnVector* Qn, Bool_t changename);
+  void Set(const QnCorrectionsQnVectorValue &Qn);
 
   void Normalize();
   /// Provides the length of the Q vector for the considered harmonic
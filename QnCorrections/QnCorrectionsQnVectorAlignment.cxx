@@ -156,6 +156,8 @@ Bool_t QnCorrectionsQnVectorAlignment::CreateSupportHistograms(TList *list) {
   fInputHistograms = new QnCorrectionsProfileCorrelationComponents((const char *) histoNameAndTitle, (const char *) histoNameAndTitle,
       fDetectorConfiguration->GetEventClassVariablesSet());
   fInputHistograms->SetNoOfEntriesThreshold(fMinNoOfEntriesToValidate);
+  /* they are rebuilt, between passes, when the events are processed several times */
+  if (fCalibrationHistograms != NULL) delete fCalibrationHistograms;
   fCalibrationHistograms = new QnCorrectionsProfileCorrelationComponents((const char *) histoNameAndTitle, (const char *) histoNameAndTitle,
       fDetectorConfiguration->GetEventClassVariablesSet());
 
@@ -357,6 +359,31 @@ void QnCorrectionsQnVectorAlignment::ClearCorrectionStep() {
   fCorrectedQnVector->Reset();
 }
 
+/// Transfers the accumulated contents to the QA histograms
+void QnCorrectionsQnVectorAlignment::FlushHistograms() {
+
+  if (fQAQnAverageHistogram != NULL)
+    fQAQnAverageHistogram->FlushHistograms();
+}
+
+/// Shares the support histograms of the same correction step of another framework instance
+/// \param master the correction step whose support histograms will be shared
+void QnCorrectionsQnVectorAlignment::ShareSupportHistograms(QnCorrectionsCorrectionStepBase *master) {
+
+  if (fCalibrationHistograms != NULL)
+    fCalibrationHistograms->ShareHistograms(static_cast<QnCorrectionsQnVectorAlignment *>(master)->fCalibrationHistograms);
+}
+
+/// Include the detector configurations the correction step reads from
+///
+/// The reference detector configuration for alignment
+/// \param list list where the detector configurations should be incorporated
+void QnCorrectionsQnVectorAlignment::FillReferenceConfigurationsList(TList *list) const {
+
+  if (fDetectorConfigurationForAlignment != NULL)
+    list->Add(fDetectorConfigurationForAlignment);
+}
+
 /// Reports if the correction step is being applied
 /// Returns TRUE if in the proper state for applying the correction step
 /// \return TRUE if the correction step is being applied
@@ -409,3 +436,21 @@ Bool_t QnCorrectionsQnVectorAlignment::ReportUsage(TList *calibrationList, TList
   return kTRUE;
 }
 
+/// Report on the memory taken by the correction step
+///
+/// A list with the step name and the memory taken by its
+/// calibration inputs, support, QA and non validated entries QA
+/// histograms is incorporated to the passed list.
+/// \param list list where the correction step memory list should be incorporated
+void QnCorrectionsQnVectorAlignment::ReportOnMemory(TList *list) const {
+  TList *stepList = new TList();
+  stepList->SetOwner(kTRUE);
+  stepList->SetName(GetName());
+
+  AddMemoryUsage(stepList, szCalibrationInputsMemoryName, fInputHistograms);
+  AddMemoryUsage(stepList, szSupportHistogramsMemoryName, fCalibrationHistograms);
+  AddMemoryUsage(stepList, szQAHistogramsMemoryName, fQAQnAverageHistogram);
+  AddMemoryUsage(stepList, szNveQAHistogramsMemoryName, fQANotValidatedBin);
+  list->Add(stepList);
+}
+
@@ -119,8 +119,12 @@ public:
   virtual Bool_t ProcessCorrections(const Float_t *variableContainer);
   virtual Bool_t ProcessDataCollection(const Float_t *variableContainer);
   virtual void ClearCorrectionStep();
+  virtual void FlushHistograms();
+  virtual void ShareSupportHistograms(QnCorrectionsCorrectionStepBase *master);
+  virtual void FillReferenceConfigurationsList(TList *list) const;
   virtual Bool_t IsBeingApplied() const;
   virtual Bool_t ReportUsage(TList *calibrationList, TList *applyList);
+  virtual void ReportOnMemory(TList *list) const;
 
 private:
   static const Int_t fDefaultMinNoOfEntries;         ///< the minimum number of entries for bin content validation
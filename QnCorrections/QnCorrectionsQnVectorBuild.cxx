@@ -132,6 +132,74 @@ void QnCorrectionsQnVectorBuild::Add(QnCorrectionsQnVectorBuild* Qn) {
   fN += Qn->GetN();
 }
 
+/// Adds a batch of contributions to the build Q vector
+///
+/// Equivalent to calling Add(phi, weight) for each of the passed
+/// contributions but, instead of one cosine and one sine evaluation per
+/// harmonic and contribution, only the first harmonic is evaluated and
+/// the higher ones are obtained by the angle addition recurrence
+/// \f[
+///    \cos((h+1)\varphi) = \cos(h\varphi)\cos\varphi - \sin(h\varphi)\sin\varphi, \quad
+///    \sin((h+1)\varphi) = \sin(h\varphi)\cos\varphi + \cos(h\varphi)\sin\varphi
+/// \f]
+/// The contributions are handled in batches of QNVECTORBUILDBATCHSIZE
+/// entries so that the inner loops run over contiguous arrays without
+/// dependencies between iterations which allows their vectorization.
+/// A check for weight significant value is made. Not passing it ignores the contribution.
+/// \param phi array with the azimuthal angle of the contributions
+/// \param weight array with the weight of the contributions
+/// \param n the number of contributions
+void QnCorrectionsQnVectorBuild::Add(const Float_t *phi, const Float_t *weight, Int_t n) {
+  Double_t cosPhi[QNVECTORBUILDBATCHSIZE];
+  Double_t sinPhi[QNVECTORBUILDBATCHSIZE];
+  Double_t cosHPhi[QNVECTORBUILDBATCHSIZE];
+  Double_t sinHPhi[QNVECTORBUILDBATCHSIZE];
+  Double_t w[QNVECTORBUILDBATCHSIZE];
+
+  for (Int_t ixFirst = 0; ixFirst < n; ixFirst += QNVECTORBUILDBATCHSIZE) {
+    Int_t ixLast = TMath::Min(n, ixFirst + QNVECTORBUILDBATCHSIZE);
+
+    /* first the significant contributions with their first harmonic */
+    Int_t nAccepted = 0;
+    Double_t sumW = 0.0;
+    for (Int_t ixData = ixFirst; ixData < ixLast; ixData++) {
+      if (weight[ixData] < fMinimumSignificantValue) continue;
+      Double_t angle = fHarmonicMultiplier * phi[ixData];
+      w[nAccepted] = weight[ixData];
+      cosPhi[nAccepted] = TMath::Cos(angle);
+      sinPhi[nAccepted] = TMath::Sin(angle);
+      cosHPhi[nAccepted] = cosPhi[nAccepted];
+      sinHPhi[nAccepted] = sinPhi[nAccepted];
+      sumW += weight[ixData];
+      nAccepted++;
+    }
+
+    /* now sweep the harmonics */
+    for (Int_t h = 1; h < fHighestHarmonic + 1; h++) {
+      if (1 < h) {
+        for (Int_t i = 0; i < nAccepted; i++) {
+          Double_t c = cosHPhi[i] * cosPhi[i] - sinHPhi[i] * sinPhi[i];
+          Double_t s = sinHPhi[i] * cosPhi[i] + cosHPhi[i] * sinPhi[i];
+          cosHPhi[i] = c;
+          sinHPhi[i] = s;
+        }
+      }
+      if ((fHarmonicMask & harmonicNumberMask[h]) == harmonicNumberMask[h]) {
+        Double_t qx = 0.0;
+        Double_t qy = 0.0;
+        for (Int_t i = 0; i < nAccepted; i++) {
+          qx += w[i] * cosHPhi[i];
+          qy += w[i] * sinHPhi[i];
+        }
+        fQnX[h] += qx;
+        fQnY[h] += qy;
+      }
+    }
+    fSumW += sumW;
+    fN += nAccepted;
+  }
+}
+
 /// Normalizes the build Q vector for the whole harmonics set
 ///
 /// Normalizes the build Q vector as \f$ Qn = \frac{Qn}{M} \f$.
@@ -42,6 +42,7 @@ public:
 
   void Add(QnCorrectionsQnVectorBuild* qvec);
   void Add(Double_t phi, Double_t weight = 1.0);
+  void Add(const Float_t *phi, const Float_t *weight, Int_t n);
 
   /// Check the quality of the constructed Qn vector
   /// Current criteria is number of contributors should be at least one.
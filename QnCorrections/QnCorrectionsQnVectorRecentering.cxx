@@ -60,6 +60,9 @@ QnCorrectionsQnVectorRecentering::QnCorrectionsQnVectorRecentering() :
   fQAQnAverageHistogram = NULL;
   fApplyWidthEqualization = kFALSE;
   fMinNoOfEntriesToValidate = fDefaultMinNoOfEntries;
+  fApplyOnline = kFALSE;
+  fOnlineWarmUpEntries = 0;
+  fNoOfOnlineEntries = 0;
 }
 
 /// Default destructor
@@ -109,8 +112,13 @@ Bool_t QnCorrectionsQnVectorRecentering::CreateSupportHistograms(TList *list) {
   fInputHistograms = new QnCorrectionsProfileComponents((const char *) histoNameAndTitle, (const char *) histoNameAndTitle,
       fDetectorConfiguration->GetEventClassVariablesSet(), "s");
   fInputHistograms->SetNoOfEntriesThreshold(fMinNoOfEntriesToValidate);
+  /* they are rebuilt, between passes, when the events are processed several times */
+  if (fCalibrationHistograms != NULL) delete fCalibrationHistograms;
   fCalibrationHistograms = new QnCorrectionsProfileComponents((const char *) histoNameAndTitle, (const char *) histoNameAndTitle,
       fDetectorConfiguration->GetEventClassVariablesSet(), "s");
+  /* the calibration histograms provide the running averages when applying online */
+  fCalibrationHistograms->SetNoOfEntriesThreshold(fMinNoOfEntriesToValidate);
+  fNoOfOnlineEntries = 0;
 
   /* get information about the configured harmonics to pass it for histogram creation */
   Int_t nNoOfHarmonics = fDetectorConfiguration->GetNoOfHarmonics();
@@ -170,15 +178,69 @@ Bool_t QnCorrectionsQnVectorRecentering::CreateNveQAHistograms(TList *list) {
   return kTRUE;
 }
 
+/// Applies the correction out of the passed histograms
+///
+/// The current Qn vector is corrected if it is good enough and the
+/// histograms bin content for the current event class is validated.
+/// Otherwise it is left untouched.
+/// \param histograms the histograms with the correction information
+/// \param variableContainer the current variables content addressed by var Id
+/// \param bEnabled kFALSE if the correction shall not be yet applied
+void QnCorrectionsQnVectorRecentering::ApplyCorrection(QnCorrectionsProfileComponents *histograms,
+    const Float_t *variableContainer, Bool_t bEnabled) {
+  Int_t harmonic;
+
+  if (fDetectorConfiguration->GetCurrentQnVector()->IsGoodQuality()) {
+    /* we get the properties of the current Qn vector but its name */
+    fCorrectedQnVector->Set(fDetectorConfiguration->GetCurrentQnVector(),kFALSE);
+    harmonic = fDetectorConfiguration->GetCurrentQnVector()->GetFirstHarmonic();
+
+    /* let's check the correction histograms */
+    Long64_t bin = histograms->GetBin(variableContainer);
+    if (bEnabled && histograms->BinContentValidated(bin)) {
+      /* correction information validated */
+      while (harmonic != -1) {
+        Float_t widthX = 1.0;
+        Float_t widthY = 1.0;
+        if (fApplyWidthEqualization) {
+          widthX = histograms->GetXBinError(harmonic, bin);
+          widthY = histograms->GetYBinError(harmonic, bin);
+        }
+        fCorrectedQnVector->SetQx(harmonic, (fDetectorConfiguration->GetCurrentQnVector()->Qx(harmonic)
+            - histograms->GetXBinContent(harmonic, bin))
+            / widthX);
+        fCorrectedQnVector->SetQy(harmonic, (fDetectorConfiguration->GetCurrentQnVector()->Qy(harmonic)
+            - histograms->GetYBinContent(harmonic, bin))
+            / widthY);
+        harmonic = fDetectorConfiguration->GetCurrentQnVector()->GetNextHarmonic(harmonic);
+      }
+    } /* correction information not validated, we leave the Q vector untouched */
+    else {
+      if (fQANotValidatedBin != NULL) fQANotValidatedBin->Fill(variableContainer, 1.0);
+    }
+  }
+  else {
+    /* not done! input vector with bad quality */
+    fCorrectedQnVector->SetGood(kFALSE);
+  }
+  /* and update the current Qn vector */
+  fDetectorConfiguration->UpdateCurrentQnVector(fCorrectedQnVector);
+}
+
 /// Processes the correction step
 ///
 /// Pure virtual function
 /// \return kTRUE if the correction step was applied
 Bool_t QnCorrectionsQnVectorRecentering::ProcessCorrections(const Float_t *variableContainer) {
-  Int_t harmonic;
   switch (fState) {
   case QCORRSTEP_calibration:
     /* collect the data needed to further produce correction parameters if the current Qn vector is good enough */
+    if (fApplyOnline) {
+      /* but apply the correction from the data collected up to now */
+      QnCorrectionsInfo(TString::Format("Recentering process in detector %s: applying correction online.", fDetectorConfiguration->GetName()).Data());
+      ApplyCorrection(fCalibrationHistograms, variableContainer, (fOnlineWarmUpEntries <= fNoOfOnlineEntries));
+      return kTRUE;
+    }
     /* we have not perform any correction yet */
     return kFALSE;
     break;
@@ -187,41 +249,7 @@ Bool_t QnCorrectionsQnVectorRecentering::ProcessCorrections(const Float_t *varia
     /* and proceed to ... */
   case QCORRSTEP_apply: /* apply the correction if the current Qn vector is good enough */
     QnCorrectionsInfo(TString::Format("Recentering process in detector %s: applying correction.", fDetectorConfiguration->GetName()).Data());
-    if (fDetectorConfiguration->GetCurrentQnVector()->IsGoodQuality()) {
-      /* we get the properties of the current Qn vector but its name */
-      fCorrectedQnVector->Set(fDetectorConfiguration->GetCurrentQnVector(),kFALSE);
-      harmonic = fDetectorConfiguration->GetCurrentQnVector()->GetFirstHarmonic();
-
-      /* let's check the correction histograms */
-      Long64_t bin = fInputHistograms->GetBin(variableContainer);
-      if (fInputHistograms->BinContentValidated(bin)) {
-        /* correction information validated */
-        while (harmonic != -1) {
-          Float_t widthX = 1.0;
-          Float_t widthY = 1.0;
-          if (fApplyWidthEqualization) {
-            widthX = fInputHistograms->GetXBinError(harmonic, bin);
-            widthY = fInputHistograms->GetYBinError(harmonic, bin);
-          }
-          fCorrectedQnVector->SetQx(harmonic, (fDetectorConfiguration->GetCurrentQnVector()->Qx(harmonic)
-              - fInputHistograms->GetXBinContent(harmonic, bin))
-              / widthX);
-          fCorrectedQnVector->SetQy(harmonic, (fDetectorConfiguration->GetCurrentQnVector()->Qy(harmonic)
-              - fInputHistograms->GetYBinContent(harmonic, bin))
-              / widthY);
-          harmonic = fDetectorConfiguration->GetCurrentQnVector()->GetNextHarmonic(harmonic);
-        }
-      } /* correction information not validated, we leave the Q vector untouched */
-      else {
-        if (fQANotValidatedBin != NULL) fQANotValidatedBin->Fill(variableContainer, 1.0);
-      }
-    }
-    else {
-      /* not done! input vector with bad quality */
-      fCorrectedQnVector->SetGood(kFALSE);
-    }
-    /* and update the current Qn vector */
-    fDetectorConfiguration->UpdateCurrentQnVector(fCorrectedQnVector);
+    ApplyCorrection(fInputHistograms, variableContainer, kTRUE);
     break;
   default:
     /* we are in passive state waiting for proper conditions, no corrections applied */
@@ -248,9 +276,11 @@ Bool_t QnCorrectionsQnVectorRecentering::ProcessDataCollection(const Float_t *va
         fCalibrationHistograms->FillY(harmonic,variableContainer,fInputQnVector->Qy(harmonic));
         harmonic = fInputQnVector->GetNextHarmonic(harmonic);
       }
+      fNoOfOnlineEntries++;
     }
-    /* we have not perform any correction yet */
-    return kFALSE;
+    /* we have not perform any correction yet unless applying it online */
+    if (!fApplyOnline) return kFALSE;
+    FillQAHistograms(variableContainer);
     break;
   case QCORRSTEP_applyCollect:
     QnCorrectionsInfo(TString::Format("Recentering process in detector %s: collecting data.", fDetectorConfiguration->GetName()).Data());
@@ -266,14 +296,7 @@ Bool_t QnCorrectionsQnVectorRecentering::ProcessDataCollection(const Float_t *va
     /* and proceed to ... */
   case QCORRSTEP_apply: /* apply the correction if the current Qn vector is good enough */
     /* provide QA info if required */
-    if (fQAQnAverageHistogram != NULL) {
-      harmonic = fCorrectedQnVector->GetFirstHarmonic();
-      while (harmonic != -1) {
-        fQAQnAverageHistogram->FillX(harmonic, variableContainer, fCorrectedQnVector->Qx(harmonic));
-        fQAQnAverageHistogram->FillY(harmonic, variableContainer, fCorrectedQnVector->Qy(harmonic));
-        harmonic = fCorrectedQnVector->GetNextHarmonic(harmonic);
-      }
-    }
+    FillQAHistograms(variableContainer);
     break;
   default:
     /* we are in passive state waiting for proper conditions, no corrections applied */
@@ -283,12 +306,55 @@ Bool_t QnCorrectionsQnVectorRecentering::ProcessDataCollection(const Float_t *va
   return kTRUE;
 }
 
+/// Fills the QA histograms with the corrected Qn vector if required
+/// \param variableContainer the current variables content addressed by var Id
+void QnCorrectionsQnVectorRecentering::FillQAHistograms(const Float_t *variableContainer) {
+  Int_t harmonic;
+
+  if (fQAQnAverageHistogram != NULL) {
+    harmonic = fCorrectedQnVector->GetFirstHarmonic();
+    while (harmonic != -1) {
+      fQAQnAverageHistogram->FillX(harmonic, variableContainer, fCorrectedQnVector->Qx(harmonic));
+      fQAQnAverageHistogram->FillY(harmonic, variableContainer, fCorrectedQnVector->Qy(harmonic));
+      harmonic = fCorrectedQnVector->GetNextHarmonic(harmonic);
+    }
+  }
+}
+
 /// Clean the correction to accept a new event
 void QnCorrectionsQnVectorRecentering::ClearCorrectionStep() {
 
   fCorrectedQnVector->Reset();
 }
 
+/// Transfers the accumulated contents to the support and QA histograms
+void QnCorrectionsQnVectorRecentering::FlushHistograms() {
+
+  if (fCalibrationHistograms != NULL)
+    fCalibrationHistograms->FlushHistograms();
+  if (fQAQnAverageHistogram != NULL)
+    fQAQnAverageHistogram->FlushHistograms();
+}
+
+/// Shares the support histograms of the same correction step of another framework instance
+///
+/// When applied online the running averages are read while being
+/// collected and the shared ones are updated by other framework
+/// instances without synchronization with those reads so, in that
+/// case, the support histograms are not shared and each instance
+/// corrects out of its own running averages.
+/// \param master the correction step whose support histograms will be shared
+void QnCorrectionsQnVectorRecentering::ShareSupportHistograms(QnCorrectionsCorrectionStepBase *master) {
+
+  if (fApplyOnline) {
+    QnCorrectionsWarning(Form("Recentering in detector %s is applied online, its support histograms will not be shared",
+        fDetectorConfiguration->GetName()));
+    return;
+  }
+  if (fCalibrationHistograms != NULL)
+    fCalibrationHistograms->ShareHistograms(static_cast<QnCorrectionsQnVectorRecentering *>(master)->fCalibrationHistograms);
+}
+
 /// Reports if the correction step is being applied
 /// Returns TRUE if in the proper state for applying the correction step
 /// \return TRUE if the correction step is being applied
@@ -296,8 +362,8 @@ Bool_t QnCorrectionsQnVectorRecentering::IsBeingApplied() const {
   switch (fState) {
   case QCORRSTEP_calibration:
     /* we are collecting */
-    /* but not applying */
-    return kFALSE;
+    /* but not applying unless online */
+    return fApplyOnline;
     break;
   case QCORRSTEP_applyCollect:
     /* we are collecting */
@@ -324,8 +390,9 @@ Bool_t QnCorrectionsQnVectorRecentering::ReportUsage(TList *calibrationList, TLi
   case QCORRSTEP_calibration:
     /* we are collecting */
     calibrationList->Add(new TObjString(szCorrectionName));
-    /* but not applying */
-    return kFALSE;
+    /* but not applying unless online */
+    if (!fApplyOnline) return kFALSE;
+    applyList->Add(new TObjString(szCorrectionName));
     break;
   case QCORRSTEP_applyCollect:
     /* we are collecting */
@@ -341,3 +408,21 @@ Bool_t QnCorrectionsQnVectorRecentering::ReportUsage(TList *calibrationList, TLi
   return kTRUE;
 }
 
+/// Report on the memory taken by the correction step
+///
+/// A list with the step name and the memory taken by its
+/// calibration inputs, support, QA and non validated entries QA
+/// histograms is incorporated to the passed list.
+/// \param list list where the correction step memory list should be incorporated
+void QnCorrectionsQnVectorRecentering::ReportOnMemory(TList *list) const {
+  TList *stepList = new TList();
+  stepList->SetOwner(kTRUE);
+  stepList->SetName(GetName());
+
+  AddMemoryUsage(stepList, szCalibrationInputsMemoryName, fInputHistograms);
+  AddMemoryUsage(stepList, szSupportHistogramsMemoryName, fCalibrationHistograms);
+  AddMemoryUsage(stepList, szQAHistogramsMemoryName, fQAQnAverageHistogram);
+  AddMemoryUsage(stepList, szNveQAHistogramsMemoryName, fQANotValidatedBin);
+  list->Add(stepList);
+}
+
@@ -48,6 +48,15 @@
 /// in the calibration one, collecting data for producing, once merged in a
 /// further phase, the correction histograms.
 ///
+/// Optionally, in the calibration status the correction can be applied online
+/// out of the running averages, and widths, of the data being collected. The
+/// correction is then applied for the event classes which already collected
+/// the minimum number of entries for validation, and optionally once a
+/// warm-up number of Q vectors have been collected. Each Q vector is
+/// corrected with the averages of the previous ones in its event class.
+/// When applied online the support histograms are never shared with
+/// other framework instances.
+///
 /// Correction and data collecting during calibration is performed for all harmonics
 /// defined within the involved detector configuration
 
@@ -95,6 +104,15 @@
 /// in the calibration one, collecting data for producing, once merged in a
 /// further phase, the correction histograms.
 ///
+/// Optionally, in the calibration status the correction can be applied online
+/// out of the running averages, and widths, of the data being collected. The
+/// correction is then applied for the event classes which already collected
+/// the minimum number of entries for validation, and optionally once a
+/// warm-up number of Q vectors have been collected. Each Q vector is
+/// corrected with the averages of the previous ones in its event class.
+/// When applied online the support histograms are never shared with
+/// other framework instances.
+///
 /// Correction and data collecting during calibration is performed for all harmonics
 /// defined within the involved detector configuration
 
@@ -112,6 +130,11 @@ public:
   /// Set the minimum number of entries for calibration histogram bin content validation
   /// \param nNoOfEntries the number of entries threshold
   void SetNoOfEntriesThreshold(Int_t nNoOfEntries) { fMinNoOfEntriesToValidate = nNoOfEntries; }
+  /// Controls if, while calibrating, the correction shall be applied online from the running averages
+  /// \param apply kTRUE for applying the correction online
+  /// \param nWarmUpEntries the number of Q vectors to collect before starting applying it
+  void SetApplyOnline(Bool_t apply, Int_t nWarmUpEntries = 0)
+  { fApplyOnline = apply; fOnlineWarmUpEntries = nWarmUpEntries; }
 
   /// Informs when the detector configuration has been attached to the framework manager
   /// Basically this allows interaction between the different framework sections at configuration time
@@ -133,10 +156,16 @@ public:
   virtual Bool_t ProcessCorrections(const Float_t *variableContainer);
   virtual Bool_t ProcessDataCollection(const Float_t *variableContainer);
   virtual void ClearCorrectionStep();
+  virtual void FlushHistograms();
+  virtual void ShareSupportHistograms(QnCorrectionsCorrectionStepBase *master);
   virtual Bool_t IsBeingApplied() const;
   virtual Bool_t ReportUsage(TList *calibrationList, TList *applyList);
+  virtual void ReportOnMemory(TList *list) const;
 
 private:
+  void ApplyCorrection(QnCorrectionsProfileComponents *histograms, const Float_t *variableContainer, Bool_t bEnabled);
+  void FillQAHistograms(const Float_t *variableContainer);
+
   static const Int_t fDefaultMinNoOfEntries;         ///< the minimum number of entries for bin content validation
   static const char *szCorrectionName;               ///< the name of the correction step
   static const char *szKey;                          ///< the key of the correction step for ordering purpose
@@ -151,9 +180,12 @@ private:
 
   Bool_t fApplyWidthEqualization;              ///< apply the width equalization step
   Int_t fMinNoOfEntriesToValidate;              ///< number of entries for bin content validation threshold
+  Bool_t fApplyOnline;                         ///< apply the correction online, while calibrating, from the running averages
+  Int_t fOnlineWarmUpEntries;                  ///< number of Q vectors to collect before applying the correction online
+  Long64_t fNoOfOnlineEntries;                 //!<! number of Q vectors collected while applying the correction online
 
 /// \cond CLASSIMP
-  ClassDef(QnCorrectionsQnVectorRecentering, 3);
+  ClassDef(QnCorrectionsQnVectorRecentering, 4);
 /// \endcond
 };
 
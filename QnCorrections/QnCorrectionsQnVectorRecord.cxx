@@ -0,0 +1,318 @@
+/**************************************************************************************************
+ *                                                                                                *
+ * Package:       FlowVectorCorrections                                                           *
+ * Authors:       Jaap Onderwaater, GSI, jacobus.onderwaater@cern.ch                              *
+ *                Ilya Selyuzhenkov, GSI, ilya.selyuzhenkov@gmail.com                             *
+ *                Víctor González, UCM, victor.gonzalez@cern.ch                                   *
+ *                Contributors are mentioned in the code where appropriate.                       *
+ * Development:   2012-2016                                                                       *
+ *                                                                                                *
+ * This file is part of FlowVectorCorrections, a software package that corrects Q-vector          *
+ * measurements for effects of nonuniform detector acceptance. The corrections in this package    *
+ * are based on publication:                                                                      *
+ *                                                                                                *
+ *  [1] "Effects of non-uniform acceptance in anisotropic flow measurements"                      *
+ *  Ilya Selyuzhenkov and Sergei Voloshin                                                         *
+ *  Phys. Rev. C 77, 034904 (2008)                                                                *
+ *                                                                                                *
+ * The procedure proposed in [1] is extended with the following steps:                            *
+ * (*) alignment correction between subevents                                                     *
+ * (*) possibility to extract the twist and rescaling corrections                                 *
+ *      for the case of three detector subevents                                                  *
+ *      (currently limited to the case of two “hit-only” and one “tracking” detectors)            *
+ * (*) (optional) channel equalization                                                            *
+ * (*) flow vector width equalization                                                             *
+ *                                                                                                *
+ * FlowVectorCorrections is distributed under the terms of the GNU General Public License (GPL)   *
+ * (https://en.wikipedia.org/wiki/GNU_General_Public_License)                                     *
+ * either version 3 of the License, or (at your option) any later version.                        *
+ *                                                                                                *
+ **************************************************************************************************/
+
+/// \file QnCorrectionsQnVectorRecord.cxx
+/// \brief Implementation of the plain Qn vectors record
+
+#include <string.h>
+#include <TTree.h>
+#include <TBranch.h>
+#include <TDirectory.h>
+#include "QnCorrectionsDetectorConfigurationBase.h"
+#include "QnCorrectionsQnVectorRecord.h"
+#include "QnCorrectionsLog.h"
+
+/// \cond CLASSIMP
+ClassImp(QnCorrectionsQnVectorRecord);
+/// \endcond
+
+const char *QnCorrectionsQnVectorRecord::szRecordTreeName = "QnVectorRecordTree";
+const char *QnCorrectionsQnVectorRecord::szVariablesBranchName = "EventVariables";
+
+/// Default constructor
+QnCorrectionsQnVectorRecord::QnCorrectionsQnVectorRecord() : TObject(), fConfigurations() {
+  fConfigurations.SetOwner(kFALSE);
+  fTree = NULL;
+  fOwnTree = kFALSE;
+  fNoOfVariables = 0;
+  fVariableId = NULL;
+  fVariables = NULL;
+  fNoOfQnVectors = 0;
+  fQnVectors = NULL;
+  fOffset = NULL;
+  fHarmonics = NULL;
+  fComponents = NULL;
+  fN = NULL;
+  fSumW = NULL;
+  fGood = NULL;
+}
+
+/// Default destructor
+/// A tree attached to a directory is owned by it
+QnCorrectionsQnVectorRecord::~QnCorrectionsQnVectorRecord() {
+  if (fOwnTree && fTree != NULL) delete fTree;
+  ReleaseLayout();
+}
+
+/// Creates the record tree
+///
+/// The variables flagged in the passed map and the plain Qn and Q2n
+/// vectors of the passed detector configurations will be recorded.
+/// \param directory the directory the tree will be attached to, NULL for keeping it in memory
+/// \param variablesMap flags, addressed by var Id, for the variables to record
+/// \param nVariables the size of the variables map
+/// \param configurations the detector configurations
+/// \return kTRUE if everything went OK
+Bool_t QnCorrectionsQnVectorRecord::CreateTree(TDirectory *directory, const Bool_t *variablesMap, Int_t nVariables,
+    TCollection *configurations) {
+  BuildLayout(variablesMap, nVariables, configurations);
+
+  fTree = new TTree(szRecordTreeName, "Plain Qn vectors record");
+  fTree->SetDirectory(directory);
+  fOwnTree = (directory == NULL);
+  return ConnectBranches(kTRUE);
+}
+
+/// Attaches a previously recorded tree for restoring its entries
+///
+/// The variables map and the detector configurations should be the
+/// ones the tree was recorded with.
+/// \param tree the record tree
+/// \param variablesMap flags, addressed by var Id, for the recorded variables
+/// \param nVariables the size of the variables map
+/// \param configurations the detector configurations
+/// \return kTRUE if the tree layout matches the expected one
+Bool_t QnCorrectionsQnVectorRecord::AttachTree(TTree *tree, const Bool_t *variablesMap, Int_t nVariables,
+    TCollection *configurations) {
+  BuildLayout(variablesMap, nVariables, configurations);
+
+  fTree = tree;
+  fOwnTree = kFALSE;
+  return ConnectBranches(kFALSE);
+}
+
+/// Builds the record layout and its branches buffers
+/// \param variablesMap flags, addressed by var Id, for the variables to record
+/// \param nVariables the size of the variables map
+/// \param configurations the detector configurations
+void QnCorrectionsQnVectorRecord::BuildLayout(const Bool_t *variablesMap, Int_t nVariables, TCollection *configurations) {
+  ReleaseLayout();
+
+  /* the variables */
+  for (Int_t ixVariable = 0; ixVariable < nVariables; ixVariable++) {
+    if (variablesMap[ixVariable]) fNoOfVariables++;
+  }
+  fVariableId = new Int_t[fNoOfVariables];
+  fVariables = new Float_t[fNoOfVariables];
+  fNoOfVariables = 0;
+  for (Int_t ixVariable = 0; ixVariable < nVariables; ixVariable++) {
+    if (variablesMap[ixVariable]) fVariableId[fNoOfVariables++] = ixVariable;
+  }
+
+  /* the plain Qn and Q2n vectors of each detector configuration */
+  TIter next(configurations);
+  TObject *configuration;
+  while ((configuration = next()) != NULL) {
+    fConfigurations.Add(configuration);
+  }
+  fNoOfQnVectors = 2 * fConfigurations.GetEntriesFast();
+  fQnVectors = new QnCorrectionsQnVector *[fNoOfQnVectors];
+  fOffset = new Int_t[fNoOfQnVectors + 1];
+  Int_t nHarmonics = 0;
+  for (Int_t ixConfiguration = 0; ixConfiguration < fConfigurations.GetEntriesFast(); ixConfiguration++) {
+    QnCorrectionsDetectorConfigurationBase *detectorConfiguration =
+        (QnCorrectionsDetectorConfigurationBase *) fConfigurations.At(ixConfiguration);
+    fQnVectors[2 * ixConfiguration] = detectorConfiguration->GetPlainQnVector();
+    fQnVectors[2 * ixConfiguration + 1] = detectorConfiguration->GetPlainQ2nVector();
+  }
+  for (Int_t ixQnVector = 0; ixQnVector < fNoOfQnVectors; ixQnVector++) {
+    nHarmonics += fQnVectors[ixQnVector]->GetNoOfHarmonics();
+  }
+  fHarmonics = new Int_t[nHarmonics];
+  fComponents = new Float_t[2 * nHarmonics];
+  fN = new Int_t[fNoOfQnVectors];
+  fSumW = new Float_t[fNoOfQnVectors];
+  fGood = new Bool_t[fNoOfQnVectors];
+
+  Int_t ixHarmonic = 0;
+  for (Int_t ixQnVector = 0; ixQnVector < fNoOfQnVectors; ixQnVector++) {
+    QnCorrectionsQnVector *qn = fQnVectors[ixQnVector];
+    fOffset[ixQnVector] = ixHarmonic;
+    for (Int_t harmonic = qn->GetFirstHarmonic(); harmonic != -1; harmonic = qn->GetNextHarmonic(harmonic)) {
+      fHarmonics[ixHarmonic++] = harmonic;
+    }
+  }
+  fOffset[fNoOfQnVectors] = ixHarmonic;
+}
+
+/// Releases the record layout and its branches buffers
+void QnCorrectionsQnVectorRecord::ReleaseLayout() {
+  fConfigurations.Clear();
+  fNoOfVariables = 0;
+  fNoOfQnVectors = 0;
+  if (fVariableId != NULL) delete [] fVariableId;
+  if (fVariables != NULL) delete [] fVariables;
+  if (fQnVectors != NULL) delete [] fQnVectors;
+  if (fOffset != NULL) delete [] fOffset;
+  if (fHarmonics != NULL) delete [] fHarmonics;
+  if (fComponents != NULL) delete [] fComponents;
+  if (fN != NULL) delete [] fN;
+  if (fSumW != NULL) delete [] fSumW;
+  if (fGood != NULL) delete [] fGood;
+  fVariableId = NULL;
+  fVariables = NULL;
+  fQnVectors = NULL;
+  fOffset = NULL;
+  fHarmonics = NULL;
+  fComponents = NULL;
+  fN = NULL;
+  fSumW = NULL;
+  fGood = NULL;
+}
+
+/// Creates or attaches the record tree branches
+/// \param create kTRUE for creating the branches, kFALSE for attaching to the existing ones
+/// \return kTRUE if everything went OK
+Bool_t QnCorrectionsQnVectorRecord::ConnectBranches(Bool_t create) {
+  Bool_t retValue = kTRUE;
+
+  if (fNoOfVariables != 0) {
+    retValue = ConnectBranch(szVariablesBranchName, fVariables, Form("Values[%d]/F", fNoOfVariables), create);
+  }
+  for (Int_t ixQnVector = 0; ixQnVector < fNoOfQnVectors; ixQnVector++) {
+    TString name = TString(fConfigurations.At(ixQnVector / 2)->GetName()) + (((ixQnVector % 2) == 0) ? "_Qn" : "_Q2n");
+    Int_t nQnHarmonics = fOffset[ixQnVector + 1] - fOffset[ixQnVector];
+    Float_t *qx = fComponents + 2 * fOffset[ixQnVector];
+
+    if (nQnHarmonics != 0) {
+      retValue = retValue && ConnectBranch(name + "_Qx", qx, Form("Qx[%d]/F", nQnHarmonics), create);
+      retValue = retValue && ConnectBranch(name + "_Qy", qx + nQnHarmonics, Form("Qy[%d]/F", nQnHarmonics), create);
+    }
+    retValue = retValue && ConnectBranch(name + "_N", &fN[ixQnVector], "N/I", create);
+    retValue = retValue && ConnectBranch(name + "_SumW", &fSumW[ixQnVector], "SumW/F", create);
+    retValue = retValue && ConnectBranch(name + "_Good", &fGood[ixQnVector], "Good/O", create);
+  }
+  return retValue;
+}
+
+/// Creates or attaches a record tree branch
+/// \param name the branch name
+/// \param address the branch buffer
+/// \param leaflist the branch leaf list
+/// \param create kTRUE for creating the branch, kFALSE for attaching to the existing one
+/// \return kTRUE if everything went OK
+Bool_t QnCorrectionsQnVectorRecord::ConnectBranch(const char *name, void *address, const char *leaflist, Bool_t create) {
+  if (create) {
+    fTree->Branch(name, address, leaflist);
+  }
+  else {
+    if (fTree->GetBranch(name) == NULL) {
+      QnCorrectionsError(Form("The Qn vectors record tree lacks the %s branch. " \
+          "It was recorded with a different framework configuration.", name));
+      return kFALSE;
+    }
+    fTree->SetBranchAddress(name, address);
+  }
+  return kTRUE;
+}
+
+/// Records the current event
+///
+/// The variables values and the current plain Qn vectors of the
+/// detector configurations are stored in a new tree entry.
+/// \param variableContainer pointer to the variable content bank
+void QnCorrectionsQnVectorRecord::Fill(const Float_t *variableContainer) {
+  for (Int_t ixVariable = 0; ixVariable < fNoOfVariables; ixVariable++) {
+    fVariables[ixVariable] = variableContainer[fVariableId[ixVariable]];
+  }
+  for (Int_t ixQnVector = 0; ixQnVector < fNoOfQnVectors; ixQnVector++) {
+    const QnCorrectionsQnVector *qn = fQnVectors[ixQnVector];
+    Int_t first = fOffset[ixQnVector];
+    Int_t nHarmonics = fOffset[ixQnVector + 1] - first;
+    Float_t *qx = fComponents + 2 * first;
+    Float_t *qy = qx + nHarmonics;
+    for (Int_t ixHarmonic = 0; ixHarmonic < nHarmonics; ixHarmonic++) {
+      qx[ixHarmonic] = qn->Qx(fHarmonics[first + ixHarmonic]);
+      qy[ixHarmonic] = qn->Qy(fHarmonics[first + ixHarmonic]);
+    }
+    fN[ixQnVector] = qn->GetN();
+    fSumW[ixQnVector] = qn->GetSumOfWeights();
+    fGood[ixQnVector] = qn->IsGoodQuality();
+  }
+  fTree->Fill();
+}
+
+/// Transfers the recorded events to another record
+///
+/// Each entry is read back into the branches buffers, copied into
+/// the target ones and filled in the target tree. The own tree is
+/// then reset. Both records must have the same layout.
+/// \param target the record receiving the entries
+/// \return kTRUE if the entries were transferred
+Bool_t QnCorrectionsQnVectorRecord::TransferEntries(QnCorrectionsQnVectorRecord *target) {
+  Int_t nHarmonics = fOffset[fNoOfQnVectors];
+
+  if ((target->fNoOfVariables != fNoOfVariables) ||
+      (target->fNoOfQnVectors != fNoOfQnVectors) ||
+      (target->fOffset[target->fNoOfQnVectors] != nHarmonics)) {
+    return kFALSE;
+  }
+  for (Long64_t entry = 0; entry < fTree->GetEntries(); entry++) {
+    fTree->GetEntry(entry);
+    memcpy(target->fVariables, fVariables, fNoOfVariables * sizeof(Float_t));
+    memcpy(target->fComponents, fComponents, 2 * nHarmonics * sizeof(Float_t));
+    memcpy(target->fN, fN, fNoOfQnVectors * sizeof(Int_t));
+    memcpy(target->fSumW, fSumW, fNoOfQnVectors * sizeof(Float_t));
+    memcpy(target->fGood, fGood, fNoOfQnVectors * sizeof(Bool_t));
+    target->fTree->Fill();
+  }
+  fTree->Reset();
+  return kTRUE;
+}
+
+/// Restores a recorded event
+///
+/// The variables values are stored back in the variables bank and the
+/// plain Qn vectors of the detector configurations are set from the
+/// tree entry.
+/// \param entry the tree entry
+/// \param variableContainer pointer to the variable content bank
+void QnCorrectionsQnVectorRecord::GetEntry(Long64_t entry, Float_t *variableContainer) {
+  fTree->GetEntry(entry);
+
+  for (Int_t ixVariable = 0; ixVariable < fNoOfVariables; ixVariable++) {
+    variableContainer[fVariableId[ixVariable]] = fVariables[ixVariable];
+  }
+  for (Int_t ixQnVector = 0; ixQnVector < fNoOfQnVectors; ixQnVector++) {
+    QnCorrectionsQnVector *qn = fQnVectors[ixQnVector];
+    Int_t first = fOffset[ixQnVector];
+    Int_t nHarmonics = fOffset[ixQnVector + 1] - first;
+    const Float_t *qx = fComponents + 2 * first;
+    const Float_t *qy = qx + nHarmonics;
+    for (Int_t ixHarmonic = 0; ixHarmonic < nHarmonics; ixHarmonic++) {
+      qn->SetQx(fHarmonics[first + ixHarmonic], qx[ixHarmonic]);
+      qn->SetQy(fHarmonics[first + ixHarmonic], qy[ixHarmonic]);
+    }
+    qn->SetN(fN[ixQnVector]);
+    qn->SetSumOfWeights(fSumW[ixQnVector]);
+    qn->SetGood(fGood[ixQnVector]);
+  }
+}
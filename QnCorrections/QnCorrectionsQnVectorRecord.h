@@ -0,0 +1,105 @@
+#ifndef QNCORRECTIONS_QNVECTORRECORD_H
+#define QNCORRECTIONS_QNVECTORRECORD_H
+
+/***************************************************************************
+ * Package:       FlowVectorCorrections                                    *
+ * Authors:       Jaap Onderwaater, GSI, jacobus.onderwaater@cern.ch       *
+ *                Ilya Selyuzhenkov, GSI, ilya.selyuzhenkov@gmail.com      *
+ *                Víctor González, UCM, victor.gonzalez@cern.ch            *
+ *                Contributors are mentioned in the code where appropriate.*
+ * Development:   2012-2016                                                *
+ * See cxx source for GPL licence et. al.                                  *
+ ***************************************************************************/
+
+/// \file QnCorrectionsQnVectorRecord.h
+/// \brief Record of plain Qn vectors for replaying Q vector level passes
+
+#include <TObject.h>
+#include <TObjArray.h>
+
+class TTree;
+class TDirectory;
+class TCollection;
+class QnCorrectionsQnVector;
+
+/// \class QnCorrectionsQnVectorRecord
+/// \brief Event by event record of the plain Qn vectors of the detector configurations
+///
+/// The Q vector correction steps only consume Qn vectors and the event
+/// class variables. The record keeps, in a tree, what they need for each
+/// event: the values of the event level variables and, for each detector
+/// configuration, its plain Qn and Q2n vectors, i.e. the ones built
+/// after the input data corrections. The branches follow the Qn vector
+/// tree flat layout: fixed size arrays with the X and Y components of the
+/// active harmonics, the number of elements, the sum of weights and the
+/// quality flag.
+///
+/// The same class restores a recorded event: the variables are stored
+/// back in the variables bank and the plain Qn vectors of the detector
+/// configurations are set from the tree entry so that the Q vector
+/// correction steps can be processed without any data vector.
+///
+/// The detector configurations are addressed by name, the recorded tree
+/// is only usable with a framework with the same detector configurations
+/// and harmonics.
+///
+/// \author Jaap Onderwaater <jacobus.onderwaater@cern.ch>, GSI
+/// \author Ilya Selyuzhenkov <ilya.selyuzhenkov@gmail.com>, GSI
+/// \author Víctor González <victor.gonzalez@cern.ch>, UCM
+/// \date Oct 16, 2026
+
+class QnCorrectionsQnVectorRecord : public TObject {
+public:
+  QnCorrectionsQnVectorRecord();
+  virtual ~QnCorrectionsQnVectorRecord();
+
+  Bool_t CreateTree(TDirectory *directory, const Bool_t *variablesMap, Int_t nVariables, TCollection *configurations);
+  Bool_t AttachTree(TTree *tree, const Bool_t *variablesMap, Int_t nVariables, TCollection *configurations);
+
+  /// Gets the record tree
+  /// \return the record tree
+  TTree *GetTree() const { return fTree; }
+  /// Gets the detector configurations involved in the record
+  /// \return the array of detector configurations
+  const TObjArray *GetConfigurations() const { return &fConfigurations; }
+
+  void Fill(const Float_t *variableContainer);
+  void GetEntry(Long64_t entry, Float_t *variableContainer);
+  Bool_t TransferEntries(QnCorrectionsQnVectorRecord *target);
+
+private:
+  void BuildLayout(const Bool_t *variablesMap, Int_t nVariables, TCollection *configurations);
+  void ReleaseLayout();
+  Bool_t ConnectBranches(Bool_t create);
+  Bool_t ConnectBranch(const char *name, void *address, const char *leaflist, Bool_t create);
+
+  static const char *szRecordTreeName;      ///< the name of the record tree
+  static const char *szVariablesBranchName; ///< the name of the event level variables branch
+  TTree *fTree;                           //!<! the record tree
+  Bool_t fOwnTree;                        //!<! kTRUE if the tree is owned by the record
+  TObjArray fConfigurations;              //!<! the recorded detector configurations
+  Int_t fNoOfVariables;                   //!<! the number of recorded variables
+  Int_t *fVariableId;                     //!<! the Id of each recorded variable
+  Float_t *fVariables;                    //!<! the variables branch buffer
+  Int_t fNoOfQnVectors;                   //!<! the number of recorded Qn vectors
+  QnCorrectionsQnVector **fQnVectors;     //!<! the recorded Qn vectors, plain Qn and Q2n of each configuration
+  Int_t *fOffset;                         //!<! the position of the first harmonic of each Qn vector in the harmonics array
+  Int_t *fHarmonics;                      //!<! the active harmonics of each Qn vector
+  Float_t *fComponents;                   //!<! the Qx, Qy branches buffer, twice the harmonics array size
+  Int_t *fN;                              //!<! the number of elements branches buffer
+  Float_t *fSumW;                         //!<! the sum of weights branches buffer
+  Bool_t *fGood;                          //!<! the quality flag branches buffer
+
+  /// Copy constructor
+  /// Not allowed. Forced private.
+  QnCorrectionsQnVectorRecord(const QnCorrectionsQnVectorRecord &);
+  /// Assignment operator
+  /// Not allowed. Forced private.
+  QnCorrectionsQnVectorRecord& operator= (const QnCorrectionsQnVectorRecord &);
+
+/// \cond CLASSIMP
+  ClassDef(QnCorrectionsQnVectorRecord, 1);
+/// \endcond
+};
+
+#endif // QNCORRECTIONS_QNVECTORRECORD_H
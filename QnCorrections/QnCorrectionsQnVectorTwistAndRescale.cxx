@@ -221,15 +221,17 @@ Bool_t QnCorrectionsQnVectorTwistAndRescale::CreateSupportHistograms(TList *list
       fDetectorConfiguration->GetName());
 
   Int_t *harmonicsMap;
+
+  /* the calibration histograms are rebuilt, between passes, when the events are processed several times */
+  if (fDoubleHarmonicInputHistograms != NULL) delete fDoubleHarmonicInputHistograms;
+  if (fDoubleHarmonicCalibrationHistograms != NULL) delete fDoubleHarmonicCalibrationHistograms;
+  if (fCorrelationsInputHistograms != NULL) delete fCorrelationsInputHistograms;
+  if (fCorrelationsCalibrationHistograms != NULL) delete fCorrelationsCalibrationHistograms;
   fDoubleHarmonicInputHistograms = NULL;
   fDoubleHarmonicCalibrationHistograms = NULL;
   fCorrelationsInputHistograms = NULL;
   fCorrelationsCalibrationHistograms = NULL;
 
-
-  if (fDoubleHarmonicInputHistograms != NULL) delete fDoubleHarmonicInputHistograms;
-  if (fCorrelationsInputHistograms != NULL) delete fCorrelationsInputHistograms;
-
   switch (fTwistAndRescaleMethod) {
   case TWRESCALE_doubleHarmonic:
     fDoubleHarmonicInputHistograms = new QnCorrectionsProfileComponents((const char *) histoDoubleHarmonicNameAndTitle, (const char *) histoDoubleHarmonicNameAndTitle,
@@ -691,6 +693,40 @@ void QnCorrectionsQnVectorTwistAndRescale::ClearCorrectionStep() {
   fCorrectedQnVector->Reset();
 }
 
+/// Transfers the accumulated contents to the support and QA histograms
+void QnCorrectionsQnVectorTwistAndRescale::FlushHistograms() {
+
+  if (fDoubleHarmonicCalibrationHistograms != NULL)
+    fDoubleHarmonicCalibrationHistograms->FlushHistograms();
+  if (fQATwistQnAverageHistogram != NULL)
+    fQATwistQnAverageHistogram->FlushHistograms();
+  if (fQARescaleQnAverageHistogram != NULL)
+    fQARescaleQnAverageHistogram->FlushHistograms();
+}
+
+/// Shares the support histograms of the same correction step of another framework instance
+///
+/// Only the double harmonic method calibration histograms are shared.
+/// \param master the correction step whose support histograms will be shared
+void QnCorrectionsQnVectorTwistAndRescale::ShareSupportHistograms(QnCorrectionsCorrectionStepBase *master) {
+
+  if (fDoubleHarmonicCalibrationHistograms != NULL)
+    fDoubleHarmonicCalibrationHistograms->ShareHistograms(
+        static_cast<QnCorrectionsQnVectorTwistAndRescale *>(master)->fDoubleHarmonicCalibrationHistograms);
+}
+
+/// Include the detector configurations the correction step reads from
+///
+/// The B and C detector configurations when the correlations method is used
+/// \param list list where the detector configurations should be incorporated
+void QnCorrectionsQnVectorTwistAndRescale::FillReferenceConfigurationsList(TList *list) const {
+
+  if (fBDetectorConfiguration != NULL)
+    list->Add(fBDetectorConfiguration);
+  if (fCDetectorConfiguration != NULL)
+    list->Add(fCDetectorConfiguration);
+}
+
 /// Include the corrected Qn vectors into the passed list
 ///
 /// Adds the Qn vector to the passed list
@@ -773,3 +809,24 @@ Bool_t QnCorrectionsQnVectorTwistAndRescale::ReportUsage(TList *calibrationList,
   return kFALSE;
 }
 
+/// Report on the memory taken by the correction step
+///
+/// A list with the step name and the memory taken by its
+/// calibration inputs, support, QA and non validated entries QA
+/// histograms is incorporated to the passed list.
+/// \param list list where the correction step memory list should be incorporated
+void QnCorrectionsQnVectorTwistAndRescale::ReportOnMemory(TList *list) const {
+  TList *stepList = new TList();
+  stepList->SetOwner(kTRUE);
+  stepList->SetName(GetName());
+
+  AddMemoryUsage(stepList, szCalibrationInputsMemoryName, fDoubleHarmonicInputHistograms);
+  AddMemoryUsage(stepList, szCalibrationInputsMemoryName, fCorrelationsInputHistograms);
+  AddMemoryUsage(stepList, szSupportHistogramsMemoryName, fDoubleHarmonicCalibrationHistograms);
+  AddMemoryUsage(stepList, szSupportHistogramsMemoryName, fCorrelationsCalibrationHistograms);
+  AddMemoryUsage(stepList, szQAHistogramsMemoryName, fQATwistQnAverageHistogram);
+  AddMemoryUsage(stepList, szQAHistogramsMemoryName, fQARescaleQnAverageHistogram);
+  AddMemoryUsage(stepList, szNveQAHistogramsMemoryName, fQANotValidatedBin);
+  list->Add(stepList);
+}
+
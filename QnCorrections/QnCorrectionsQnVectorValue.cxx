@@ -0,0 +1,172 @@
+/**************************************************************************************************
+ *                                                                                                *
+ * Package:       FlowVectorCorrections                                                           *
+ * Authors:       Jaap Onderwaater, GSI, jacobus.onderwaater@cern.ch                              *
+ *                Ilya Selyuzhenkov, GSI, ilya.selyuzhenkov@gmail.com                             *
+ *                Víctor González, UCM, victor.gonzalez@cern.ch                                   *
+ *                Contributors are mentioned in the code where appropriate.                       *
+ * Development:   2012-2016                                                                       *
+ *                                                                                                *
+ * This file is part of FlowVectorCorrections, a software package that corrects Q-vector          *
+ * measurements for effects of nonuniform detector acceptance. The corrections in this package    *
+ * are based on publication:                                                                      *
+ *                                                                                                *
+ *  [1] "Effects of non-uniform acceptance in anisotropic flow measurements"                      *
+ *  Ilya Selyuzhenkov and Sergei Voloshin                                                         *
+ *  Phys. Rev. C 77, 034904 (2008)                                                                *
+ *                                                                                                *
+ * The procedure proposed in [1] is extended with the following steps:                            *
+ * (*) alignment correction between subevents                                                     *
+ * (*) possibility to extract the twist and rescaling corrections                                 *
+ *      for the case of three detector subevents                                                  *
+ *      (currently limited to the case of two “hit-only” and one “tracking” detectors)            *
+ * (*) (optional) channel equalization                                                            *
+ * (*) flow vector width equalization                                                             *
+ *                                                                                                *
+ * FlowVectorCorrections is distributed under the terms of the GNU General Public License (GPL)   *
+ * (https://en.wikipedia.org/wiki/GNU_General_Public_License)                                     *
+ * either version 3 of the License, or (at your option) any later version.                        *
+ *                                                                                                *
+ **************************************************************************************************/
+
+/// \file QnCorrectionsQnVectorValue.cxx
+/// \brief Implementation of the plain values of a Q vector while building it
+
+#include <string.h>
+
+#include "QnCorrectionsQnVectorValue.h"
+
+/// Takes the harmonic structure of a Q vector
+///
+/// The active harmonics of the passed Q vector are assigned, in
+/// ascending order, to the slots and the values are reset.
+/// \param Qn the Q vector whose structure is taken
+void QnCorrectionsQnVectorValue::SetStructure(const QnCorrectionsQnVector &Qn) {
+  fHighestHarmonic = Qn.fHighestHarmonic;
+  fHarmonicMask = Qn.fHarmonicMask;
+  fHarmonicMultiplier = Qn.fHarmonicMultiplier;
+  fNoOfHarmonics = 0;
+  for (Int_t h = 1; h < fHighestHarmonic + 1; h++) {
+    if ((fHarmonicMask & QnCorrectionsQnVector::harmonicNumberMask[h]) == QnCorrectionsQnVector::harmonicNumberMask[h]) {
+      fHarmonic[fNoOfHarmonics] = h;
+      fNoOfHarmonics++;
+    }
+  }
+  Reset();
+}
+
+/// Resets the values without touching the structure
+///
+/// Only the slots of the active harmonics are handled.
+void QnCorrectionsQnVectorValue::Reset() {
+  memset(fQnX, 0, fNoOfHarmonics*sizeof(Float_t));
+  memset(fQnY, 0, fNoOfHarmonics*sizeof(Float_t));
+  fGoodQuality = kFALSE;
+  fN = 0;
+  fSumW = 0.0;
+}
+
+/// Adds a batch of contributions
+///
+/// Only the first harmonic is evaluated for each contribution, the
+/// higher ones are obtained by the angle addition recurrence as in
+/// QnCorrectionsQnVectorBuild::Add and the sums are only kept for the
+/// slots of the active harmonics.
+/// A check for weight significant value is made. Not passing it ignores the contribution.
+/// \param phi array with the azimuthal angle of the contributions
+/// \param weight array with the weight of the contributions
+/// \param n the number of contributions
+void QnCorrectionsQnVectorValue::Add(const Float_t *phi, const Float_t *weight, Int_t n) {
+  Double_t cosPhi[QNVECTORBUILDBATCHSIZE];
+  Double_t sinPhi[QNVECTORBUILDBATCHSIZE];
+  Double_t cosHPhi[QNVECTORBUILDBATCHSIZE];
+  Double_t sinHPhi[QNVECTORBUILDBATCHSIZE];
+  Double_t w[QNVECTORBUILDBATCHSIZE];
+
+  for (Int_t ixFirst = 0; ixFirst < n; ixFirst += QNVECTORBUILDBATCHSIZE) {
+    Int_t ixLast = TMath::Min(n, ixFirst + QNVECTORBUILDBATCHSIZE);
+
+    /* first the significant contributions with their first harmonic */
+    Int_t nAccepted = 0;
+    Double_t sumW = 0.0;
+    for (Int_t ixData = ixFirst; ixData < ixLast; ixData++) {
+      if (weight[ixData] < QnCorrectionsQnVector::fMinimumSignificantValue) continue;
+      Double_t angle = fHarmonicMultiplier * phi[ixData];
+      w[nAccepted] = weight[ixData];
+      cosPhi[nAccepted] = TMath::Cos(angle);
+      sinPhi[nAccepted] = TMath::Sin(angle);
+      cosHPhi[nAccepted] = cosPhi[nAccepted];
+      sinHPhi[nAccepted] = sinPhi[nAccepted];
+      sumW += weight[ixData];
+      nAccepted++;
+    }
+
+    /* now sweep the harmonics up to the highest active one */
+    Int_t slot = 0;
+    for (Int_t h = 1; slot < fNoOfHarmonics; h++) {
+      if (1 < h) {
+        for (Int_t i = 0; i < nAccepted; i++) {
+          Double_t c = cosHPhi[i] * cosPhi[i] - sinHPhi[i] * sinPhi[i];
+          Double_t s = sinHPhi[i] * cosPhi[i] + cosHPhi[i] * sinPhi[i];
+          cosHPhi[i] = c;
+          sinHPhi[i] = s;
+        }
+      }
+      if (h == fHarmonic[slot]) {
+        Double_t qx = 0.0;
+        Double_t qy = 0.0;
+        for (Int_t i = 0; i < nAccepted; i++) {
+          qx += w[i] * cosHPhi[i];
+          qy += w[i] * sinHPhi[i];
+        }
+        fQnX[slot] += qx;
+        fQnY[slot] += qy;
+        slot++;
+      }
+    }
+    fSumW += sumW;
+    fN += nAccepted;
+  }
+}
+
+/// Normalizes the values according to the method passed
+///
+/// The same normalizations than QnCorrectionsQnVectorBuild::Normalize.
+/// For the methods involving M a check for significant value is made.
+/// Not passing it does set the quality as bad.
+/// \param method the method of normalization
+void QnCorrectionsQnVectorValue::Normalize(QnCorrectionsQnVector::QnVectorNormalizationMethod method) {
+  Float_t norm;
+
+  switch (method) {
+  case QnCorrectionsQnVector::QVNORM_noCalibration:
+    break;
+  case QnCorrectionsQnVector::QVNORM_QoverSqrtM:
+  case QnCorrectionsQnVector::QVNORM_QoverM:
+    if (fSumW < QnCorrectionsQnVector::fMinimumSignificantValue) {
+      fGoodQuality = kFALSE;
+    }
+    else {
+      norm = (method == QnCorrectionsQnVector::QVNORM_QoverM) ? fSumW : TMath::Sqrt(fSumW);
+      for (Int_t slot = 0; slot < fNoOfHarmonics; slot++) {
+        fQnX[slot] = fQnX[slot] / norm;
+        fQnY[slot] = fQnY[slot] / norm;
+      }
+    }
+    break;
+  case QnCorrectionsQnVector::QVNORM_QoverQlength:
+    for (Int_t slot = 0; slot < fNoOfHarmonics; slot++) {
+      norm = TMath::Sqrt(fQnX[slot]*fQnX[slot] + fQnY[slot]*fQnY[slot]);
+      if (norm < QnCorrectionsQnVector::fMinimumSignificantValue) {
+        fQnX[slot] = 0.0;
+        fQnY[slot] = 0.0;
+      }
+      else {
+        fQnX[slot] = fQnX[slot] / norm;
+        fQnY[slot] = fQnY[slot] / norm;
+      }
+    }
+    break;
+  }
+}
+
@@ -0,0 +1,60 @@
+#ifndef QNCORRECTIONS_QNVECTORVALUE_H
+#define QNCORRECTIONS_QNVECTORVALUE_H
+
+/***************************************************************************
+ * Package:       FlowVectorCorrections                                    *
+ * Authors:       Jaap Onderwaater, GSI, jacobus.onderwaater@cern.ch       *
+ *                Ilya Selyuzhenkov, GSI, ilya.selyuzhenkov@gmail.com      *
+ *                Víctor González, UCM, victor.gonzalez@cern.ch            *
+ *                Contributors are mentioned in the code where appropriate.*
+ * Development:   2012-2016                                                *
+ * See cxx source for GPL licence et. al.                                  *
+ ***************************************************************************/
+
+/// \file QnCorrectionsQnVectorValue.h
+/// \brief Plain values of a Q vector while building it within the Q vector correction framework
+
+#include "QnCorrectionsQnVector.h"
+
+/// \struct QnCorrectionsQnVectorValue
+/// \brief Plain values of a Q vector while building it
+///
+/// Not an object but a plain structure: no virtual table, no name
+/// and no persistence, so it can be reset, filled and normalized each
+/// event at the cost of its active harmonics only. The components are
+/// stored compactly, one slot per active harmonic in ascending harmonic
+/// order, and they are published into Q vectors with
+/// QnCorrectionsQnVector::Set.
+///
+/// The harmonic structure is taken from a Q vector with SetStructure
+/// and it has to be taken again each time the structure of that
+/// Q vector changes.
+///
+/// \author Jaap Onderwaater <jacobus.onderwaater@cern.ch>, GSI
+/// \author Ilya Selyuzhenkov <ilya.selyuzhenkov@gmail.com>, GSI
+/// \author Víctor González <victor.gonzalez@cern.ch>, UCM
+/// \date Oct 16, 2026
+struct QnCorrectionsQnVectorValue {
+
+  void SetStructure(const QnCorrectionsQnVector &Qn);
+  void Reset();
+  void Add(const Float_t *phi, const Float_t *weight, Int_t n);
+  /// Check the quality of the constructed Qn vector
+  /// Current criteria is number of contributors should be at least one.
+  /// If so happen, sets the good quality flag.
+  void CheckQuality() { fGoodQuality = ((0 < fN) ? kTRUE : kFALSE); }
+  void Normalize(QnCorrectionsQnVector::QnVectorNormalizationMethod method);
+
+  Int_t   fNoOfHarmonics;                           ///< the number of active harmonics
+  Int_t   fHarmonic[MAXHARMONICNUMBERSUPPORTED];    ///< the harmonic number of each slot
+  Float_t fQnX[MAXHARMONICNUMBERSUPPORTED];         ///< the Q vector X component for each slot
+  Float_t fQnY[MAXHARMONICNUMBERSUPPORTED];         ///< the Q vector Y component for each slot
+  Int_t   fHighestHarmonic;                         ///< the highest harmonic number handled
+  UInt_t  fHarmonicMask;                            ///< the mask for the supported harmonics
+  Int_t   fHarmonicMultiplier;                      ///< the multiplier of the different harmonics
+  Bool_t  fGoodQuality;                             ///< Qn vector good quality flag
+  Int_t   fN;                                       ///< number of elements used for Qn vector building
+  Float_t fSumW;                                    ///< the sum of weights
+};
+
+#endif /* QNCORRECTIONS_QNVECTORVALUE_H */
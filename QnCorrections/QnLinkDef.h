@@ -13,6 +13,7 @@
 #pragma link off all classes;
 #pragma link off all functions;
 
+#pragma link C++ class QnCorrectionsCalibrationList+;
 #pragma link C++ class QnCorrectionsCorrectionOnInputData+;
 #pragma link C++ class QnCorrectionsCorrectionOnQvector+;
 #pragma link C++ class QnCorrectionsCorrectionsSetOnInputData+;
@@ -33,6 +34,7 @@
 #pragma link C++ class QnCorrectionsDetectorConfigurationChannels+;
 #pragma link C++ class QnCorrectionsDetectorConfigurationsSet+;
 #pragma link C++ class QnCorrectionsDetectorConfigurationTracks+;
+#pragma link C++ class QnCorrectionsEventBuffer+;
 #pragma link C++ class QnCorrectionsEventClassVariable+;
 #pragma link C++ class QnCorrectionsEventClassVariablesSet+;
 #pragma link C++ class QnCorrectionsHistogram+;
@@ -42,6 +44,7 @@
 #pragma link C++ class QnCorrectionsHistogramSparse+;
 #pragma link C++ class QnCorrectionsInputGainEqualization+;
 #pragma link C++ class QnCorrectionsManager+;
+#pragma link C++ class QnCorrectionsOutputMerger+;
 #pragma link C++ class QnCorrectionsProfile+;
 #pragma link C++ class QnCorrectionsProfile3DCorrelations+;
 #pragma link C++ class QnCorrectionsProfileChannelized+;
@@ -53,6 +56,7 @@
 #pragma link C++ class QnCorrectionsQnVectorAlignment+;
 #pragma link C++ class QnCorrectionsQnVectorBuild+;
 #pragma link C++ class QnCorrectionsQnVectorRecentering+;
+#pragma link C++ class QnCorrectionsQnVectorRecord+;
 #pragma link C++ class QnCorrectionsQnVectorTwistAndRescale+;
 
 #endif
@@ -0,0 +1,400 @@
+/**************************************************************************************************
+ *                                                                                                *
+ * Package:       FlowVectorCorrections                                                           *
+ * Authors:       Jaap Onderwaater, GSI, jacobus.onderwaater@cern.ch                              *
+ *                Ilya Selyuzhenkov, GSI, ilya.selyuzhenkov@gmail.com                             *
+ *                Víctor González, UCM, victor.gonzalez@cern.ch                                   *
+ *                Contributors are mentioned in the code where appropriate.                       *
+ * Development:   2012-2016                                                                       *
+ *                                                                                                *
+ * This file is part of FlowVectorCorrections, a software package that corrects Q-vector          *
+ * measurements for effects of nonuniform detector acceptance. The corrections in this package    *
+ * are based on publication:                                                                      *
+ *                                                                                                *
+ *  [1] "Effects of non-uniform acceptance in anisotropic flow measurements"                      *
+ *  Ilya Selyuzhenkov and Sergei Voloshin                                                         *
+ *  Phys. Rev. C 77, 034904 (2008)                                                                *
+ *                                                                                                *
+ * The procedure proposed in [1] is extended with the following steps:                            *
+ * (*) alignment correction between subevents                                                     *
+ * (*) possibility to extract the twist and rescaling corrections                                 *
+ *      for the case of three detector subevents                                                  *
+ *      (currently limited to the case of two “hit-only” and one “tracking” detectors)            *
+ * (*) (optional) channel equalization                                                            *
+ * (*) flow vector width equalization                                                             *
+ *                                                                                                *
+ * FlowVectorCorrections is distributed under the terms of the GNU General Public License (GPL)   *
+ * (https://en.wikipedia.org/wiki/GNU_General_Public_License)                                     *
+ * either version 3 of the License, or (at your option) any later version.                        *
+ *                                                                                                *
+ **************************************************************************************************/
+
+/// \file QnCorrectionsBenchmark.cxx
+/// \brief End to end throughput benchmark for the Q vector correction framework
+///
+/// Builds the framework configuration of Example.C, one tracking detector
+/// with positive and negative tracks configurations and one channelized
+/// detector with two sub-detector configurations, the whole set of
+/// correction steps included, and processes events produced by a fast
+/// deterministic generator.
+///
+/// The events are processed in consecutive passes. The first pass runs
+/// in calibration mode. Each further pass takes the output of the
+/// previous one as calibration input so that the correction steps go
+/// progressively to the apply and collect mode. The last pass uses the
+/// final calibration input and only applies the corrections.
+///
+/// For each pass the throughput and the time per event split into data
+/// ingestion, corrections processing, data collection processing and
+/// event clearing are reported.
+///
+/// Usage: QnCorrectionsBenchmark [nEvents] [nPasses]
+///
+/// \author Jaap Onderwaater <jacobus.onderwaater@cern.ch>, GSI
+/// \author Ilya Selyuzhenkov <ilya.selyuzhenkov@gmail.com>, GSI
+/// \author Víctor González <victor.gonzalez@cern.ch>, UCM
+/// \date Oct 16, 2026
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#include <TMath.h>
+#include <TFile.h>
+#include <TList.h>
+#include <TString.h>
+
+#include "QnCorrectionsLog.h"
+#include "QnCorrectionsEventClassVariablesSet.h"
+#include "QnCorrectionsCutAbove.h"
+#include "QnCorrectionsCutBelow.h"
+#include "QnCorrectionsCutsSet.h"
+#include "QnCorrectionsProfileCorrelationComponents.h"
+#include "QnCorrectionsProfile3DCorrelations.h"
+#include "QnCorrectionsDetector.h"
+#include "QnCorrectionsDetectorConfigurationChannels.h"
+#include "QnCorrectionsDetectorConfigurationTracks.h"
+#include "QnCorrectionsManager.h"
+#include "QnCorrectionsCalibrationList.h"
+#include "QnCorrectionsInputGainEqualization.h"
+#include "QnCorrectionsQnVectorRecentering.h"
+#include "QnCorrectionsQnVectorAlignment.h"
+#include "QnCorrectionsQnVectorTwistAndRescale.h"
+
+/// the detectors used by the benchmark
+enum Detectors {
+  kDetector1 = 0,
+  kDetector2,
+  kNDetectors
+};
+
+/// the variables used by the benchmark
+enum Variables {
+  kCentrality = 0,
+  kVertexZ,
+  kCharge,
+  kNVars
+};
+
+/// the variable names
+const char *szVarNames[kNVars] = {"Centrality", "VertexZ", "Charge"};
+/// the detector names
+const char *szDetectorNames[kNDetectors] = {"Detector one", "Detector two"};
+/// the process list name
+const char *szProcessName = "Benchmark";
+/// the file used to transfer the calibration information between passes
+const char *szCalibrationFileName = "QnCorrectionsBenchmarkCalibration.root";
+
+/// Channelized detector number of channels
+const Int_t nDetectorTwoNoOfChannels = 64;
+/// Channelized detector number of sectors
+const Int_t nDetectorTwoNoOfSectors = 8;
+/// Channelized detector lowest channel within the second sub-detector
+const Int_t nDetectorTwoLowestDetectorTwoCChannel = 32;
+/// Highest number of tracks per event
+const Int_t nMaxNoOfTracks = 10000;
+
+/// \class QnCorrectionsBenchmarkGenerator
+/// \brief Fast deterministic event generator
+///
+/// Produces events with the features of the Example.C ones: random
+/// centrality and vertex position, elliptic flow with respect to a
+/// random reaction plane, a non uniform acceptance hole for tracks
+/// and non uniform gains for channels. A xorshift generator with a
+/// fixed seed is used so that every run produces the same events.
+class QnCorrectionsBenchmarkGenerator {
+public:
+  QnCorrectionsBenchmarkGenerator() : fState(88172645463325252ULL) {}
+
+  /// Gets a uniform random number
+  /// \return the random number within [0,1)
+  Double_t Rndm() {
+    fState ^= fState << 13;
+    fState ^= fState >> 7;
+    fState ^= fState << 17;
+    return (fState >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  void GenerateEvent();
+
+  Float_t fCentrality;                               ///< the event centrality
+  Float_t fVertexZ;                                  ///< the event vertex z position
+  Float_t fChannelPhi[nDetectorTwoNoOfChannels];     ///< the channels azimuthal angle
+  Float_t fChannelWeight[nDetectorTwoNoOfChannels];  ///< the channels signal
+  Int_t fChannelId[nDetectorTwoNoOfChannels];        ///< the channels id
+  Int_t fNoOfPositiveTracks;                         ///< the number of positive tracks
+  Int_t fNoOfNegativeTracks;                         ///< the number of negative tracks
+  Float_t fPositiveTrackPhi[nMaxNoOfTracks];         ///< the positive tracks azimuthal angle
+  Float_t fNegativeTrackPhi[nMaxNoOfTracks];         ///< the negative tracks azimuthal angle
+
+private:
+  ULong64_t fState;                                  ///< the generator state
+};
+
+/// Generates a new event
+void QnCorrectionsBenchmarkGenerator::GenerateEvent() {
+  const Double_t flowV2 = 0.5;
+  const Double_t rotation = -0.3;
+  const Double_t dphi = 2 * TMath::Pi() / nDetectorTwoNoOfSectors;
+
+  fCentrality = Rndm() * 100;
+  fVertexZ = (Rndm() - 0.5) * 20;
+  Double_t PsiRP = Rndm() * 2 * TMath::Pi();
+
+  for (Int_t ixChannel = 0; ixChannel < nDetectorTwoNoOfChannels; ixChannel++) {
+    Double_t phiSector = (ixChannel % nDetectorTwoNoOfSectors) * dphi;
+    fChannelPhi[ixChannel] = phiSector + rotation;
+    fChannelWeight[ixChannel] = Rndm()
+        * ((200. + ixChannel) / 200.)
+        * (100 - fCentrality)
+        * (1 + flowV2 * TMath::Cos(2 * (phiSector - PsiRP)));
+    fChannelId[ixChannel] = ixChannel;
+  }
+
+  Double_t multiplicity = 2 + Rndm() * (100 - fCentrality) * 100;
+  if (nMaxNoOfTracks < multiplicity) multiplicity = nMaxNoOfTracks;
+  fNoOfPositiveTracks = 0;
+  fNoOfNegativeTracks = 0;
+  while ((fNoOfPositiveTracks + fNoOfNegativeTracks) < multiplicity) {
+    Double_t trackPhi = Rndm() * 2 * TMath::Pi();
+
+    if (Rndm() > (1 - flowV2 + flowV2 * TMath::Cos(2 * (trackPhi - PsiRP)))) continue;
+
+    if ((trackPhi > 0) && (trackPhi < 0.5))
+      if (Rndm() < 0.5) continue;
+
+    if (Rndm() < 0.4)
+      fPositiveTrackPhi[fNoOfPositiveTracks++] = trackPhi;
+    else
+      fNegativeTrackPhi[fNoOfNegativeTracks++] = trackPhi;
+  }
+}
+
+/// Builds and initializes the framework with the Example.C configuration
+/// \param calibrationFile the file with the calibration information. NULL if none
+/// \param fillQA kTRUE if the QA histograms should be filled
+/// \return the initialized framework manager
+QnCorrectionsManager *BuildFramework(TFile *calibrationFile, Bool_t fillQA) {
+  QnCorrectionsManager *QnMan = new QnCorrectionsManager();
+
+  QnMan->SetCalibrationHistogramsList(calibrationFile);
+
+  /* our event classes variables: vertexZ and centrality */
+  QnCorrectionsEventClassVariablesSet *CorrEventClasses = new QnCorrectionsEventClassVariablesSet(2);
+  Double_t VtxZaxes[][2] = { { -10.0, 4} , {-7.0, 1}, {7.0, 8}, {10.0, 1}};
+  CorrEventClasses->Add(new QnCorrectionsEventClassVariable(kVertexZ, szVarNames[kVertexZ], VtxZaxes));
+  CorrEventClasses->Add(new QnCorrectionsEventClassVariable(kCentrality, szVarNames[kCentrality], 10, 0.0, 100.0));
+
+  /* the harmonics the analysis will run on */
+  Int_t nNoOfHarmonics = 1;
+  Int_t harmonicsMap[] = {2};
+
+  /* the cuts to differentiate positive from negative tracks */
+  QnCorrectionsCutsSet *myPositiveCuts = new QnCorrectionsCutsSet();
+  myPositiveCuts->Add(new QnCorrectionsCutAbove(kCharge, 0.0));
+  myPositiveCuts->SetOwner(kTRUE);
+  QnCorrectionsCutsSet *myNegativeCuts = new QnCorrectionsCutsSet();
+  myNegativeCuts->Add(new QnCorrectionsCutBelow(kCharge, 0.0));
+  myNegativeCuts->SetOwner(kTRUE);
+
+  /* the track detector */
+  QnCorrectionsDetector *myDetectorOne = new QnCorrectionsDetector(szDetectorNames[kDetector1], kDetector1);
+  const char *szTrackConfigurations[] = {"Det1pos", "Det1neg"};
+  QnCorrectionsCutsSet *trackCuts[] = {myPositiveCuts, myNegativeCuts};
+  for (Int_t ixConf = 0; ixConf < 2; ixConf++) {
+    QnCorrectionsDetectorConfigurationTracks *configuration =
+        new QnCorrectionsDetectorConfigurationTracks(szTrackConfigurations[ixConf], CorrEventClasses, nNoOfHarmonics, harmonicsMap);
+    configuration->SetCuts(trackCuts[ixConf]);
+    configuration->SetQVectorNormalizationMethod(QnCorrectionsQnVector::QVNORM_QoverM);
+    configuration->AddCorrectionOnQnVector(new QnCorrectionsQnVectorRecentering());
+    QnCorrectionsQnVectorTwistAndRescale *twScale = new QnCorrectionsQnVectorTwistAndRescale();
+    twScale->SetApplyTwist(kTRUE);
+    twScale->SetApplyRescale(kFALSE);
+    twScale->SetTwistAndRescaleMethod(QnCorrectionsQnVectorTwistAndRescale::TWRESCALE_doubleHarmonic);
+    configuration->AddCorrectionOnQnVector(twScale);
+    myDetectorOne->AddDetectorConfiguration(configuration);
+  }
+  QnMan->AddDetector(myDetectorOne);
+
+  /* the channelized detector */
+  QnCorrectionsDetector *myDetectorTwo = new QnCorrectionsDetector(szDetectorNames[kDetector2], kDetector2);
+  const char *szChannelConfigurations[] = {"Det2A", "Det2C"};
+  const char *szTwistReferences[] = {"Det2C", "Det2A"};
+  for (Int_t ixConf = 0; ixConf < 2; ixConf++) {
+    Bool_t *bUsedChannel = new Bool_t[nDetectorTwoNoOfChannels];
+    Int_t *nChannelGroup = new Int_t[nDetectorTwoNoOfChannels];
+    for (Int_t ixChannel = 0; ixChannel < nDetectorTwoNoOfChannels; ixChannel++) {
+      /* sub-detector A for the first configuration, C for the second one */
+      bUsedChannel[ixChannel] = ((ixChannel < nDetectorTwoLowestDetectorTwoCChannel) == (ixConf == 0));
+      nChannelGroup[ixChannel] = Int_t(ixChannel / 8);
+    }
+
+    QnCorrectionsDetectorConfigurationChannels *configuration =
+        new QnCorrectionsDetectorConfigurationChannels(szChannelConfigurations[ixConf], CorrEventClasses,
+            nDetectorTwoNoOfChannels, nNoOfHarmonics, harmonicsMap);
+    configuration->SetChannelsScheme(bUsedChannel, nChannelGroup);
+    /* the configuration keeps its own copy of the channels scheme */
+    delete [] bUsedChannel;
+    delete [] nChannelGroup;
+    configuration->SetQVectorNormalizationMethod(QnCorrectionsQnVector::QVNORM_QoverM);
+    QnCorrectionsInputGainEqualization *eq = new QnCorrectionsInputGainEqualization();
+    eq->SetEqualizationMethod(QnCorrectionsInputGainEqualization::GEQUAL_averageEqualization);
+    eq->SetShift(1.0);
+    eq->SetScale(0.1);
+    eq->SetUseChannelGroupsWeights(kTRUE);
+    configuration->AddCorrectionOnInputData(eq);
+    configuration->AddCorrectionOnQnVector(new QnCorrectionsQnVectorRecentering());
+    QnCorrectionsQnVectorAlignment *align = new QnCorrectionsQnVectorAlignment();
+    align->SetReferenceConfigurationForAlignment("Det1pos");
+    align->SetHarmonicNumberForAlignment(2);
+    configuration->AddCorrectionOnQnVector(align);
+    QnCorrectionsQnVectorTwistAndRescale *twScale = new QnCorrectionsQnVectorTwistAndRescale();
+    twScale->SetApplyTwist(kTRUE);
+    twScale->SetApplyRescale(kTRUE);
+    twScale->SetTwistAndRescaleMethod(QnCorrectionsQnVectorTwistAndRescale::TWRESCALE_correlations);
+    twScale->SetReferenceConfigurationsForTwistAndRescale("Det1pos", szTwistReferences[ixConf]);
+    configuration->AddCorrectionOnQnVector(twScale);
+    myDetectorTwo->AddDetectorConfiguration(configuration);
+  }
+  QnMan->AddDetector(myDetectorTwo);
+
+  QnMan->SetShouldFillQAHistograms(fillQA);
+  QnMan->SetShouldFillNveQAHistograms(fillQA);
+
+  QnMan->InitializeQnCorrectionsFramework();
+  QnMan->SetCurrentProcessListName(szProcessName);
+
+  return QnMan;
+}
+
+/// Runs a benchmark pass
+///
+/// \param mode the name of the pass mode for the report
+/// \param calibrationFileName the name of the file with the calibration information. NULL if none
+/// \param outputFileName the name of the file to store the pass output. NULL if none
+/// \param nEvents the number of events to process
+/// \param collect kTRUE if the correction steps data should be collected
+void RunPass(const char *mode, const char *calibrationFileName, const char *outputFileName, Int_t nEvents, Bool_t collect) {
+  TFile *calibrationFile = NULL;
+  if (calibrationFileName != NULL) {
+    calibrationFile = TFile::Open(calibrationFileName, "READ");
+  }
+
+  QnCorrectionsManager *QnMan = BuildFramework(calibrationFile, collect);
+  QnCorrectionsBenchmarkGenerator generator;
+  Float_t *dataContainer = QnMan->GetDataContainer();
+
+  /* the phases are timed with the steady clock, its readings are cheap compared with a phase */
+  typedef std::chrono::steady_clock clock;
+  clock::duration ingestion = clock::duration::zero();
+  clock::duration corrections = clock::duration::zero();
+  clock::duration collection = clock::duration::zero();
+  clock::duration clear = clock::duration::zero();
+
+  for (Int_t ixEvent = 0; ixEvent < nEvents; ixEvent++) {
+    /* the event generation is not accounted */
+    generator.GenerateEvent();
+
+    clock::time_point start = clock::now();
+    dataContainer[kCentrality] = generator.fCentrality;
+    dataContainer[kVertexZ] = generator.fVertexZ;
+    QnMan->AddDataVectors(kDetector2, generator.fChannelPhi, generator.fChannelWeight, generator.fChannelId, nDetectorTwoNoOfChannels);
+    dataContainer[kCharge] = 1;
+    QnMan->AddDataVectors(kDetector1, generator.fPositiveTrackPhi, NULL, NULL, generator.fNoOfPositiveTracks);
+    dataContainer[kCharge] = -1;
+    QnMan->AddDataVectors(kDetector1, generator.fNegativeTrackPhi, NULL, NULL, generator.fNoOfNegativeTracks);
+    clock::time_point stop = clock::now();
+    ingestion += stop - start;
+
+    start = stop;
+    QnMan->ProcessCorrections();
+    stop = clock::now();
+    corrections += stop - start;
+
+    if (collect) {
+      start = stop;
+      QnMan->ProcessDataCollection();
+      stop = clock::now();
+      collection += stop - start;
+    }
+
+    start = stop;
+    QnMan->ClearEvent();
+    clear += clock::now() - start;
+  }
+
+  Double_t tIngestion = std::chrono::duration<Double_t>(ingestion).count();
+  Double_t tCorrections = std::chrono::duration<Double_t>(corrections).count();
+  Double_t tCollection = std::chrono::duration<Double_t>(collection).count();
+  Double_t tClear = std::chrono::duration<Double_t>(clear).count();
+  Double_t tTotal = tIngestion + tCorrections + tCollection + tClear;
+  Double_t nsPerEvent = 1.0e9 / nEvents;
+
+  printf("%-14s events: %8d  events/s: %10.1f  ns/event: %10.0f  ingestion: %10.0f  corrections: %10.0f  collection: %10.0f  clear: %10.0f\n",
+      mode, nEvents, (0.0 < tTotal) ? nEvents / tTotal : 0.0,
+      tTotal * nsPerEvent, tIngestion * nsPerEvent, tCorrections * nsPerEvent, tCollection * nsPerEvent, tClear * nsPerEvent);
+
+  QnMan->FinalizeQnCorrectionsFramework();
+
+  if (outputFileName != NULL) {
+    TFile *outputFile = TFile::Open(outputFileName, "RECREATE");
+    /* the indexed layout allows the next pass to only read the histograms it needs */
+    QnCorrectionsCalibrationList::WriteIndexed(QnMan->GetOutputHistogramsList(), outputFile);
+    outputFile->Close();
+    delete outputFile;
+  }
+  /* the calibration histograms list could still read from the calibration file */
+  delete QnMan;
+  if (calibrationFile != NULL) {
+    calibrationFile->Close();
+    delete calibrationFile;
+  }
+}
+
+/// The benchmark entry point
+///
+/// \param argc the number of arguments
+/// \param argv the arguments: the number of events per pass and the number of calibration passes
+/// \return zero
+int main(int argc, char *argv[]) {
+  Int_t nEvents = (1 < argc) ? atoi(argv[1]) : 20000;
+  Int_t nPasses = (2 < argc) ? atoi(argv[2]) : 4;
+
+  /* only errors are reported */
+  QnCorrectionsSetTracingLevel(kError);
+
+  /* the calibration ladder: each pass takes the previous pass output as calibration input */
+  RunPass("calibration", NULL, szCalibrationFileName, nEvents, kTRUE);
+  for (Int_t ixPass = 1; ixPass < nPasses; ixPass++) {
+    /* the same file cannot be read and rewritten within the pass */
+    TString inputName = TString::Format("%s.pass%d", szCalibrationFileName, ixPass);
+    rename(szCalibrationFileName, inputName.Data());
+    RunPass(TString::Format("applyCollect%d", ixPass).Data(), inputName.Data(), szCalibrationFileName, nEvents, kTRUE);
+    remove(inputName.Data());
+  }
+  /* and the production mode: corrections only */
+  RunPass("apply", szCalibrationFileName, NULL, nEvents, kFALSE);
+  remove(szCalibrationFileName);
+
+  return 0;
+}
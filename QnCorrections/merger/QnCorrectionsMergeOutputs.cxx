@@ -0,0 +1,96 @@
+/**************************************************************************************************
+ *                                                                                                *
+ * Package:       FlowVectorCorrections                                                           *
+ * Authors:       Jaap Onderwaater, GSI, jacobus.onderwaater@cern.ch                              *
+ *                Ilya Selyuzhenkov, GSI, ilya.selyuzhenkov@gmail.com                             *
+ *                Víctor González, UCM, victor.gonzalez@cern.ch                                   *
+ *                Contributors are mentioned in the code where appropriate.                       *
+ * Development:   2012-2016                                                                       *
+ *                                                                                                *
+ * This file is part of FlowVectorCorrections, a software package that corrects Q-vector          *
+ * measurements for effects of nonuniform detector acceptance. The corrections in this package    *
+ * are based on publication:                                                                      *
+ *                                                                                                *
+ *  [1] "Effects of non-uniform acceptance in anisotropic flow measurements"                      *
+ *  Ilya Selyuzhenkov and Sergei Voloshin                                                         *
+ *  Phys. Rev. C 77, 034904 (2008)                                                                *
+ *                                                                                                *
+ * The procedure proposed in [1] is extended with the following steps:                            *
+ * (*) alignment correction between subevents                                                     *
+ * (*) possibility to extract the twist and rescaling corrections                                 *
+ *      for the case of three detector subevents                                                  *
+ *      (currently limited to the case of two “hit-only” and one “tracking” detectors)            *
+ * (*) (optional) channel equalization                                                            *
+ * (*) flow vector width equalization                                                             *
+ *                                                                                                *
+ * FlowVectorCorrections is distributed under the terms of the GNU General Public License (GPL)   *
+ * (https://en.wikipedia.org/wiki/GNU_General_Public_License)                                     *
+ * either version 3 of the License, or (at your option) any later version.                        *
+ *                                                                                                *
+ **************************************************************************************************/
+
+/// \file QnCorrectionsMergeOutputs.cxx
+/// \brief Merger of the framework output of several jobs
+///
+/// Merges the support and QA histograms output files of several jobs
+/// into a single file using QnCorrectionsOutputMerger. The input files
+/// can be passed on the command line or within a text file, one file
+/// name per line, passed prefixed with @.
+///
+/// Usage: QnCorrectionsMergeOutputs [-j nThreads] output.root input1.root [input2.root ...] [@inputs.txt]
+///
+/// \author Jaap Onderwaater <jacobus.onderwaater@cern.ch>, GSI
+/// \author Ilya Selyuzhenkov <ilya.selyuzhenkov@gmail.com>, GSI
+/// \author Víctor González <victor.gonzalez@cern.ch>, UCM
+/// \date Oct 16, 2026
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <TString.h>
+#include <TStopwatch.h>
+
+#include "QnCorrectionsLog.h"
+#include "QnCorrectionsOutputMerger.h"
+
+/// The merger entry point
+///
+/// \param argc the number of arguments
+/// \param argv the arguments: optionally the number of threads, the output file and the input files
+/// \return zero if the merging went right
+int main(int argc, char *argv[]) {
+  QnCorrectionsOutputMerger merger;
+  const char *outputFileName = NULL;
+
+  for (Int_t ixArg = 1; ixArg < argc; ixArg++) {
+    TString arg = argv[ixArg];
+    if (arg.EqualTo("-j") && (ixArg + 1 < argc)) {
+      merger.SetNoOfThreads(atoi(argv[++ixArg]));
+    }
+    else if (outputFileName == NULL) {
+      outputFileName = argv[ixArg];
+    }
+    else if (arg.BeginsWith("@")) {
+      merger.AddInputFilesFromList(arg.Data() + 1);
+    }
+    else {
+      merger.AddInputFile(arg.Data());
+    }
+  }
+
+  if ((outputFileName == NULL) || (merger.GetNoOfInputFiles() == 0)) {
+    printf("Usage: %s [-j nThreads] output.root input1.root [input2.root ...] [@inputs.txt]\n", argv[0]);
+    return 1;
+  }
+
+  /* only errors and warnings are reported */
+  QnCorrectionsSetTracingLevel(kWarning);
+
+  TStopwatch timer;
+  timer.Start();
+  Bool_t merged = merger.Merge(outputFileName);
+  timer.Stop();
+
+  printf("Merged %d files into %s in %.1f s\n", merger.GetNoOfInputFiles(), outputFileName, timer.RealTime());
+  return (merged ? 0 : 1);
+}
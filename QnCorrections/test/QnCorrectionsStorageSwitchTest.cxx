@@ -0,0 +1,183 @@
+/**************************************************************************************************
+ *                                                                                                *
+ * Package:       FlowVectorCorrections                                                           *
+ * Authors:       Jaap Onderwaater, GSI, jacobus.onderwaater@cern.ch                              *
+ *                Ilya Selyuzhenkov, GSI, ilya.selyuzhenkov@gmail.com                             *
+ *                Víctor González, UCM, victor.gonzalez@cern.ch                                   *
+ *                Contributors are mentioned in the code where appropriate.                       *
+ * Development:   2012-2016                                                                       *
+ *                                                                                                *
+ * This file is part of FlowVectorCorrections, a software package that corrects Q-vector          *
+ * measurements for effects of nonuniform detector acceptance. The corrections in this package    *
+ * are based on publication:                                                                      *
+ *                                                                                                *
+ *  [1] "Effects of non-uniform acceptance in anisotropic flow measurements"                      *
+ *  Ilya Selyuzhenkov and Sergei Voloshin                                                         *
+ *  Phys. Rev. C 77, 034904 (2008)                                                                *
+ *                                                                                                *
+ * The procedure proposed in [1] is extended with the following steps:                            *
+ * (*) alignment correction between subevents                                                     *
+ * (*) possibility to extract the twist and rescaling corrections                                 *
+ *      for the case of three detector subevents                                                  *
+ *      (currently limited to the case of two “hit-only” and one “tracking” detectors)            *
+ * (*) (optional) channel equalization                                                            *
+ * (*) flow vector width equalization                                                             *
+ *                                                                                                *
+ * FlowVectorCorrections is distributed under the terms of the GNU General Public License (GPL)   *
+ * (https://en.wikipedia.org/wiki/GNU_General_Public_License)                                     *
+ * either version 3 of the License, or (at your option) any later version.                        *
+ *                                                                                                *
+ **************************************************************************************************/
+
+/// \file QnCorrectionsStorageSwitchTest.cxx
+/// \brief Check of the workers output merging after a sparse to dense storage switch
+///
+/// Builds a framework with two workers and one tracking detector
+/// configuration holding two non validated entries QA histograms with
+/// sparse storage, the recentering one and the twist one. The
+/// recentering correction is applied online with a warm-up which is
+/// never reached so, each event fills its non validated entries QA
+/// histogram. With a storage selection which creates the histograms
+/// sparse, the first one switches to dense storage after a few event
+/// classes have been filled.
+///
+/// Only the first worker processes events so, its histograms list is
+/// the only one where the switch happens. The framework is then
+/// finalized and the workers output merged into the manager one. The
+/// check passes if the worker list keeps the manager list order and the
+/// merged histograms hold the entries of all the processed events.
+///
+/// Usage: QnCorrectionsStorageSwitchTest
+///
+/// \author Jaap Onderwaater <jacobus.onderwaater@cern.ch>, GSI
+/// \author Ilya Selyuzhenkov <ilya.selyuzhenkov@gmail.com>, GSI
+/// \author Víctor González <victor.gonzalez@cern.ch>, UCM
+/// \date Oct 16, 2026
+
+#include <stdio.h>
+
+#include <TList.h>
+#include <TString.h>
+#include <THn.h>
+
+#include "QnCorrectionsLog.h"
+#include "QnCorrectionsEventClassVariablesSet.h"
+#include "QnCorrectionsHistogramBase.h"
+#include "QnCorrectionsProfileCorrelationComponents.h"
+#include "QnCorrectionsProfile3DCorrelations.h"
+#include "QnCorrectionsDetector.h"
+#include "QnCorrectionsDetectorConfigurationTracks.h"
+#include "QnCorrectionsManager.h"
+#include "QnCorrectionsQnVectorRecentering.h"
+#include "QnCorrectionsQnVectorTwistAndRescale.h"
+
+/// the variables used by the check
+enum Variables {
+  kCentrality = 0,
+  kNVars
+};
+
+/// the detector Id
+const Int_t nDetectorId = 0;
+/// the detector configuration name
+const char *szConfigurationName = "Tracks";
+/// the number of events processed by the first worker
+const Int_t nNoOfEvents = 100;
+/// the number of tracks per event
+const Int_t nNoOfTracks = 8;
+
+/// Builds and initializes the framework with two workers
+/// \return the initialized framework manager
+QnCorrectionsManager *BuildFramework() {
+  QnCorrectionsManager *QnMan = new QnCorrectionsManager();
+
+  QnCorrectionsEventClassVariablesSet *CorrEventClasses = new QnCorrectionsEventClassVariablesSet(1);
+  CorrEventClasses->Add(new QnCorrectionsEventClassVariable(kCentrality, "Centrality", 10, 0.0, 100.0));
+
+  Int_t harmonicsMap[] = {2};
+  QnCorrectionsDetector *detector = new QnCorrectionsDetector("Detector", nDetectorId);
+  QnCorrectionsDetectorConfigurationTracks *configuration =
+      new QnCorrectionsDetectorConfigurationTracks(szConfigurationName, CorrEventClasses, 1, harmonicsMap);
+  QnCorrectionsQnVectorRecentering *recentering = new QnCorrectionsQnVectorRecentering();
+  /* the warm-up is never reached so, every event is a non validated entry */
+  recentering->SetApplyOnline(kTRUE, 10 * nNoOfEvents);
+  configuration->AddCorrectionOnQnVector(recentering);
+  QnCorrectionsQnVectorTwistAndRescale *twScale = new QnCorrectionsQnVectorTwistAndRescale();
+  twScale->SetTwistAndRescaleMethod(QnCorrectionsQnVectorTwistAndRescale::TWRESCALE_doubleHarmonic);
+  configuration->AddCorrectionOnQnVector(twScale);
+  detector->AddDetectorConfiguration(configuration);
+  QnMan->AddDetector(detector);
+
+  QnMan->SetShouldFillNveQAHistograms(kTRUE);
+  QnMan->SetNoOfWorkers(2);
+
+  QnMan->InitializeQnCorrectionsFramework();
+  QnMan->SetCurrentProcessListName("StorageSwitch");
+  return QnMan;
+}
+
+/// Checks that two histograms lists hold the same names in the same order
+/// \param expected the reference list
+/// \param list the list to check
+/// \return kTRUE if both lists match
+Bool_t SameOrder(const TList *expected, const TList *list) {
+  if (expected->GetEntries() != list->GetEntries()) return kFALSE;
+  for (Int_t ix = 0; ix < expected->GetEntries(); ix++) {
+    if (!TString(expected->At(ix)->GetName()).EqualTo(list->At(ix)->GetName())) return kFALSE;
+  }
+  return kTRUE;
+}
+
+/// Adds up the entries of the histograms of a list
+/// \param list the histograms list
+/// \return the sum of entries
+Double_t SumOfEntries(const TList *list) {
+  Double_t entries = 0.0;
+  for (Int_t ix = 0; ix < list->GetEntries(); ix++) {
+    if (list->At(ix)->InheritsFrom("THnBase")) entries += ((THnBase *) list->At(ix))->GetEntries();
+  }
+  return entries;
+}
+
+/// The check entry point
+///
+/// \return zero if the check passed, one otherwise
+int main() {
+  QnCorrectionsSetTracingLevel(kError);
+
+  /* created sparse, switched to dense once a quarter of the event classes are filled */
+  QnCorrectionsHistogramBase::SetStorageSelection(64 * 1024 * 1024, 0.0);
+  QnCorrectionsManager *QnMan = BuildFramework();
+
+  QnCorrectionsManager *worker = QnMan->GetWorker(0);
+  Float_t *dataContainer = worker->GetDataContainer();
+  for (Int_t ixEvent = 0; ixEvent < nNoOfEvents; ixEvent++) {
+    dataContainer[kCentrality] = (ixEvent % 10) * 10.0 + 5.0;
+    for (Int_t ixTrack = 0; ixTrack < nNoOfTracks; ixTrack++) {
+      worker->AddDataVector(nDetectorId, 0.7 * ixTrack + 0.1 * ixEvent);
+    }
+    worker->ProcessEvent();
+    worker->ClearEvent();
+  }
+
+  Bool_t passed = kTRUE;
+  TList *expected = (TList *) QnMan->GetNveQAHistogramsList()->FindObject(szConfigurationName);
+  TList *switched = (TList *) worker->GetNveQAHistogramsList()->FindObject(szConfigurationName);
+  if (!SameOrder(expected, switched)) {
+    printf("FAILED: the worker non validated entries QA histograms changed their order\n");
+    passed = kFALSE;
+  }
+
+  QnMan->FinalizeQnCorrectionsFramework();
+
+  TList *merged = (TList *) QnMan->GetNveQAHistogramsList()->FindObject(szConfigurationName);
+  if (SumOfEntries(merged) != nNoOfEvents) {
+    printf("FAILED: the merged non validated entries QA histograms hold %.0f entries, %d expected\n",
+        SumOfEntries(merged), nNoOfEvents);
+    passed = kFALSE;
+  }
+  delete QnMan;
+
+  if (passed) printf("PASSED\n");
+  return passed ? 0 : 1;
+}
@@ -35,7 +35,8 @@ fi
 
 rsync -av $inputfolder/ $outputfolder
 
-listclasses="CorrectionOnInputData
+listclasses="CalibrationList
+CorrectionOnInputData
 CorrectionOnQvector
 CorrectionsSetOnInputData
 CorrectionsSetOnQvector
@@ -50,14 +51,17 @@ CutValue
 CutWithin
 DataVector
 Detector
+EventBuffer
 EventClassVariable
 Histogram
 InputGainEqualization
 Manager
+OutputMerger
 Profile
 QnVector"
 
-listclassesfiles="CorrectionOnInputData
+listclassesfiles="CalibrationList
+CorrectionOnInputData
 CorrectionOnQvector
 CorrectionsSetOnInputData
 CorrectionsSetOnQvector
@@ -71,12 +75,14 @@ CutsSet
 CutValue
 CutWithin
 DataVector
+DataVectorBank
 DataVectorChannelized
 Detector
 DetectorConfigurationBase
 DetectorConfigurationChannels
 DetectorConfigurationsSet
 DetectorConfigurationTracks
+EventBuffer
 EventClassVariable
 EventClassVariablesSet
 Histogram
@@ -86,6 +92,7 @@ HistogramChannelizedSparse
 HistogramSparse
 InputGainEqualization
 Manager
+OutputMerger
 Profile
 Profile3DCorrelations
 ProfileChannelized
@@ -96,8 +103,10 @@ ProfileCorrelationComponentsHarmonics
 QnVector
 QnVectorBuild
 QnVectorRecentering
+QnVectorRecord
 QnVectorAlignment
-QnVectorTwistAndRescale"
+QnVectorTwistAndRescale
+QnVectorValue"
 
 for j in $listclassesfiles; do
   mv $outputfolder/QnCorrections${j}.cxx $outputfolder/AliQnCorrections${j}.cxx